@@ -25,84 +25,526 @@
 
 #include "game/renderer_3d.h" // for point debugging
 #include "egolib/Script/script.h"  // for waypoint list control
+#include "egolib/egoboo_setup.h"
 #include "game/mesh.h"
 
+constexpr size_t AStar::MAX_CACHED_PATHS;
+constexpr uint32_t AStar::CLUSTER_SIZE;
+constexpr uint32_t AStar::INVALID_TILE;
+
 AStar::AStar()
-    : node_list(), node_list_length(), final_node(nullptr), start_node(nullptr)
+    : _mesh(), _meshFXVersion(0), _tileCountX(0), _tileCountY(0), _clusterCountX(0), _clusterCountY(0),
+      _passabilityMaps(), _pathCache(), _pathCacheClock(0),
+      _visitStamp(), _parent(), _cost(), _searchStamp(0), _openList(),
+      _abstractNodes(), _sourceCosts(), _destinationCosts(),
+      _path()
 {}
 
-AStar::Node *AStar::get_next_node()
+/// Functor to determine the distance of point (sourceX, sourceY) to point (targetX, targetY).
+struct Distance {
+    float operator()(int sourceX, int sourceY, int targetX, int targetY) const {
+        int distanceX = targetX - sourceX,
+            distanceY = targetY - sourceY;
+        float distance = std::sqrt(distanceX * distanceX + distanceY * distanceY);
+        return distance;
+    }
+};
+
+void AStar::validate(const std::shared_ptr<const ego_mesh_t>& mesh)
 {
-    /// @author ZF
-    /// @details This function finds and returns the next cheapest open node
+    /// @details Bring everything derived from the tiles up to date if the mesh or the FX of its tiles changed
 
-    int i, best_node = -1;
+    if (_mesh.lock() == mesh && _meshFXVersion == mesh->_fxVersion) {
+        return;
+    }
 
-    for (i = 0; i < node_list_length; i++)
-    {
-        if (node_list[i].closed) continue;
-        if (best_node == -1 || node_list[i].weight < node_list[best_node].weight) best_node = i;
+    if (_mesh.lock() != mesh) {
+        _tileCountX = mesh->_info.getTileCountX();
+        _tileCountY = mesh->_info.getTileCountY();
+        _clusterCountX = (_tileCountX + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+        _clusterCountY = (_tileCountY + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+        const size_t tileCount = _tileCountX * _tileCountY;
+        _visitStamp.assign(tileCount, 0);
+        _parent.assign(tileCount, INVALID_TILE);
+        _cost.assign(tileCount, 0.0f);
+        _searchStamp = 0;
+        _passabilityMaps.clear();
+        _mesh = mesh;
     }
+    else {
+        // Only the clusters containing tiles whose passability changed have to be rebuilt.
+        std::vector<char> passable;
+        for (PassabilityMap& map : _passabilityMaps) {
+            computePassability(*mesh, map.stoppedBy, passable);
+            if (!map.clusters.empty()) {
+                for (uint32_t tile = 0; tile < passable.size(); ++tile) {
+                    if (passable[tile] != map.passable[tile]) {
+                        map.dirty[getCluster(tile)] = true;
+                    }
+                }
+            }
+            map.passable.swap(passable);
+        }
+    }
+    _meshFXVersion = mesh->_fxVersion;
 
-    //return the node if found, a null pointer otherwise
-    return (best_node != -1) ? &node_list[best_node] : nullptr;
+    _pathCache.clear();
+    _path.clear();
 }
 
-AStar::Node *AStar::add_node(const int x, const int y, AStar::Node *parent, float weight, bool closed)
+void AStar::computePassability(const ego_mesh_t& mesh, uint32_t stoppedBy, std::vector<char>& passable) const
 {
-    /// @author ZF
-    /// @details Adds one new node to the end of the node list
+    passable.resize(_tileCountX * _tileCountY);
+    for (uint32_t iy = 0; iy < _tileCountY; ++iy) {
+        for (uint32_t ix = 0; ix < _tileCountX; ++ix) {
+            const Index2D index2D(ix, iy);
+            const Index1D index1D = mesh.getTileIndex(index2D);
+
+            //Dont walk into pits
+            //@todo: might need to check tile Z level here instead
+            bool isPassable = Index1D::Invalid != index1D
+                           && !mesh.getTileInfo(index1D).isFanOff()
+                           && !mesh.tile_has_bits(index2D, stoppedBy);
+
+            ///
+            /// @todo  I need to check for collisions with static objects, like trees
+            passable[ix + iy * _tileCountX] = isPassable;
+        }
+    }
+}
 
-    if (node_list_length >= MAX_ASTAR_NODES) return nullptr;
+AStar::PassabilityMap& AStar::getPassability(const ego_mesh_t& mesh, uint32_t stoppedBy)
+{
+    /// @details Get the passability map for a combination of blocking FX, building it if necessary
 
-    //add the node
-    node_list[node_list_length].ix = x;
-    node_list[node_list_length].iy = y;
-    node_list[node_list_length].closed = closed;
-    node_list[node_list_length].weight = weight;
-    node_list[node_list_length].parent = parent;
-    node_list_length++;
+    auto it = std::find_if(_passabilityMaps.begin(), _passabilityMaps.end(),
+                           [stoppedBy](const PassabilityMap& map) { return map.stoppedBy == stoppedBy; });
+    if (it != _passabilityMaps.end()) {
+        return *it;
+    }
 
-    //return the new node
-    return &node_list[node_list_length - 1];
+    _passabilityMaps.push_back(PassabilityMap());
+    PassabilityMap& map = _passabilityMaps.back();
+    map.stoppedBy = stoppedBy;
+    computePassability(mesh, stoppedBy, map.passable);
+    return map;
 }
 
-void AStar::reset()
+AStar::TileRect AStar::getBounds() const
 {
-    /// @author ZF
-    /// @details Reset AStar memory. This doesn't actually clear anything to make it work as fast as possible
+    return TileRect{0, 0, _tileCountX - 1, _tileCountY - 1};
+}
 
-    node_list_length = 0;
-    final_node = nullptr;
-    start_node = nullptr;
+AStar::TileRect AStar::getClusterBounds(uint32_t cluster) const
+{
+    const uint32_t minX = (cluster % _clusterCountX) * CLUSTER_SIZE,
+                   minY = (cluster / _clusterCountX) * CLUSTER_SIZE;
+    return TileRect{minX, minY, std::min(minX + CLUSTER_SIZE, _tileCountX) - 1, std::min(minY + CLUSTER_SIZE, _tileCountY) - 1};
 }
 
-/// Functor to determine the distance of point (sourceX, sourceY) to point (targetX, targetY).
-struct Distance {
-    float operator()(int sourceX, int sourceY, int targetX, int targetY) const {
-        int distanceX = targetX - sourceX,
-            distanceY = targetY - sourceY;
-        float distance = std::sqrt(distanceX * distanceX + distanceY * distanceY);
-        return distance;
+uint32_t AStar::getCluster(uint32_t tile) const
+{
+    return (tile % _tileCountX) / CLUSTER_SIZE + ((tile / _tileCountX) / CLUSTER_SIZE) * _clusterCountX;
+}
+
+void AStar::beginSearch()
+{
+    // Start a new search, forgetting the search state of the last one.
+    _searchStamp++;
+    if (0 == _searchStamp) {
+        std::fill(_visitStamp.begin(), _visitStamp.end(), 0);
+        _searchStamp = 1;
     }
-};
+    _openList.clear();
+}
+
+bool AStar::search(const std::vector<char>& passable, uint32_t source, uint32_t destination, size_t nodeBudget, const TileRect& bounds, std::vector<uint32_t>& path)
+{
+    /// @details Search a path from the source tile to the destination tile inside the bounds, expanding at most nodeBudget tiles.
+    //              The destination tile itself is always accepted once it is reached.
+
+    beginSearch();
+
+    const int dst_ix = destination % _tileCountX,
+              dst_iy = destination / _tileCountX;
+
+    _visitStamp[source] = _searchStamp;
+    _parent[source] = INVALID_TILE;
+    _cost[source] = 0.0f;
+    _openList.push_back(OpenNode{Distance()(source % _tileCountX, source / _tileCountX, dst_ix, dst_iy), source});
+
+    size_t expanded = 0;
+    while (!_openList.empty()) {
+        // Get the cheapest open node
+        std::pop_heap(_openList.begin(), _openList.end());
+        const OpenNode node = _openList.back();
+        _openList.pop_back();
+
+        const int ix = node.tile % _tileCountX,
+                  iy = node.tile / _tileCountX;
+
+        if (node.tile == destination) {
+            path.clear();
+            for (uint32_t tile = destination; INVALID_TILE != tile; tile = _parent[tile]) {
+                path.push_back(tile);
+            }
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+
+        // Skip nodes which were reached by a cheaper path after they were opened.
+        if (node.estimate > _cost[node.tile] + Distance()(ix, iy, dst_ix, dst_iy)) {
+            continue;
+        }
+
+        if (++expanded > nodeBudget) {
+#ifdef DEBUG_ASTAR
+            printf("AStar failed because maximum number of nodes were explored (%" PRIuZ ")\n", nodeBudget);
+#endif
+            return false;
+        }
+
+        // do not check diagonals
+        static const int offsets[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+        for (const auto& offset : offsets) {
+            const int tmp_x = ix + offset[0],
+                      tmp_y = iy + offset[1];
+
+            // is the test node within the bounds?
+            if (tmp_x < int(bounds.minX) || tmp_y < int(bounds.minY) || tmp_x > int(bounds.maxX) || tmp_y > int(bounds.maxY)) {
+                continue;
+            }
+            const uint32_t tile = tmp_x + tmp_y * _tileCountX;
+
+            // is this a wall, a pit or impassable?
+            if (tile != destination && !passable[tile]) {
+                continue;
+            }
+
+            // is this already reached with less cost?
+            const float cost = _cost[node.tile] + 1.0f;
+            if (_visitStamp[tile] == _searchStamp && _cost[tile] <= cost) {
+                continue;
+            }
+
+            _visitStamp[tile] = _searchStamp;
+            _parent[tile] = node.tile;
+            _cost[tile] = cost;
+            _openList.push_back(OpenNode{cost + Distance()(tmp_x, tmp_y, dst_ix, dst_iy), tile});
+            std::push_heap(_openList.begin(), _openList.end());
+        }
+    }
+
+    return false;
+}
+
+void AStar::explore(const std::vector<char>& passable, uint32_t source, const TileRect& bounds)
+{
+    /// @details Find the cost of the shortest paths from the source tile to all tiles inside the bounds.
+    //              A tile was reached if its visit stamp is the search stamp afterwards.
+
+    beginSearch();
+
+    _visitStamp[source] = _searchStamp;
+    _cost[source] = 0.0f;
+    _openList.push_back(OpenNode{0.0f, source});
+
+    while (!_openList.empty()) {
+        std::pop_heap(_openList.begin(), _openList.end());
+        const OpenNode node = _openList.back();
+        _openList.pop_back();
+
+        if (node.estimate > _cost[node.tile]) {
+            continue;
+        }
+
+        const int ix = node.tile % _tileCountX,
+                  iy = node.tile / _tileCountX;
+
+        static const int offsets[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+        for (const auto& offset : offsets) {
+            const int tmp_x = ix + offset[0],
+                      tmp_y = iy + offset[1];
+            if (tmp_x < int(bounds.minX) || tmp_y < int(bounds.minY) || tmp_x > int(bounds.maxX) || tmp_y > int(bounds.maxY)) {
+                continue;
+            }
+            const uint32_t tile = tmp_x + tmp_y * _tileCountX;
+            if (!passable[tile]) {
+                continue;
+            }
+
+            const float cost = node.estimate + 1.0f;
+            if (_visitStamp[tile] == _searchStamp && _cost[tile] <= cost) {
+                continue;
+            }
+
+            _visitStamp[tile] = _searchStamp;
+            _cost[tile] = cost;
+            _openList.push_back(OpenNode{cost, tile});
+            std::push_heap(_openList.begin(), _openList.end());
+        }
+    }
+}
+
+void AStar::updateClusters(PassabilityMap& map)
+{
+    /// @details Rebuild all clusters which are dirty or next to a dirty cluster
+
+    const uint32_t clusterCount = _clusterCountX * _clusterCountY;
+    if (map.clusters.empty()) {
+        map.clusters.resize(clusterCount);
+        map.dirty.assign(clusterCount, true);
+    }
+
+    // Clusters share the entrances on their common border, so the neighbours of a dirty cluster are rebuilt as well.
+    std::vector<char> rebuild(clusterCount, false);
+    bool anyDirty = false;
+    for (uint32_t cluster = 0; cluster < clusterCount; ++cluster) {
+        if (!map.dirty[cluster]) continue;
+        anyDirty = true;
+
+        const uint32_t cx = cluster % _clusterCountX,
+                       cy = cluster / _clusterCountX;
+        rebuild[cluster] = true;
+        if (cx > 0) rebuild[cluster - 1] = true;
+        if (cx + 1 < _clusterCountX) rebuild[cluster + 1] = true;
+        if (cy > 0) rebuild[cluster - _clusterCountX] = true;
+        if (cy + 1 < _clusterCountY) rebuild[cluster + _clusterCountX] = true;
+    }
+    if (!anyDirty) {
+        return;
+    }
+
+    for (uint32_t cluster = 0; cluster < clusterCount; ++cluster) {
+        if (rebuild[cluster]) {
+            buildCluster(map, cluster);
+        }
+    }
+    map.dirty.assign(clusterCount, false);
+}
+
+void AStar::buildCluster(PassabilityMap& map, uint32_t clusterIndex)
+{
+    /// @details Find the entrances of a cluster and the costs of the paths between them
+
+    Cluster& cluster = map.clusters[clusterIndex];
+    const TileRect bounds = getClusterBounds(clusterIndex);
+    const uint32_t width = bounds.maxX - bounds.minX + 1,
+                   height = bounds.maxY - bounds.minY + 1;
+    const int row = _tileCountX;
+
+    cluster.entrances.clear();
+    if (bounds.minX > 0) {
+        addEntrances(map.passable, cluster, bounds.minX + bounds.minY * _tileCountX, height, row, -1);
+    }
+    if (bounds.maxX + 1 < _tileCountX) {
+        addEntrances(map.passable, cluster, bounds.maxX + bounds.minY * _tileCountX, height, row, +1);
+    }
+    if (bounds.minY > 0) {
+        addEntrances(map.passable, cluster, bounds.minX + bounds.minY * _tileCountX, width, 1, -row);
+    }
+    if (bounds.maxY + 1 < _tileCountY) {
+        addEntrances(map.passable, cluster, bounds.minX + bounds.maxY * _tileCountX, width, 1, +row);
+    }
+
+    const size_t count = cluster.entrances.size();
+    cluster.costs.assign(count * count, std::numeric_limits<float>::infinity());
+    for (size_t i = 0; i < count; ++i) {
+        explore(map.passable, cluster.entrances[i].tile, bounds);
+        for (size_t j = 0; j < count; ++j) {
+            const uint32_t tile = cluster.entrances[j].tile;
+            if (_visitStamp[tile] == _searchStamp) {
+                cluster.costs[i * count + j] = _cost[tile];
+            }
+        }
+    }
+}
+
+void AStar::addEntrances(const std::vector<char>& passable, Cluster& cluster, uint32_t start, uint32_t length, int step, int link)
+{
+    /// @details Add the entrances along one border of a cluster. Every run of tiles which are passable on both
+    //              sides of the border gets an entrance in its middle, wide runs get one at each end instead.
+    //              Both clusters at a border find the same runs, so their entrances match.
+
+    static const uint32_t MAX_NARROW_RUN = 5;
+
+    uint32_t runStart = 0;
+    bool inRun = false;
+    for (uint32_t i = 0; i <= length; ++i) {
+        const uint32_t tile = start + i * step;
+        const bool open = i < length && passable[tile] && passable[tile + link];
+        if (open && !inRun) {
+            runStart = i;
+            inRun = true;
+        }
+        else if (!open && inRun) {
+            inRun = false;
+            const uint32_t runLength = i - runStart;
+            if (runLength <= MAX_NARROW_RUN) {
+                const uint32_t middle = start + (runStart + runLength / 2) * step;
+                cluster.entrances.push_back(Entrance{middle, middle + link});
+            }
+            else {
+                const uint32_t first = start + runStart * step,
+                               last = start + (i - 1) * step;
+                cluster.entrances.push_back(Entrance{first, first + link});
+                cluster.entrances.push_back(Entrance{last, last + link});
+            }
+        }
+    }
+}
+
+bool AStar::searchHierarchical(PassabilityMap& map, uint32_t source, uint32_t destination)
+{
+    /// @details Find a path through the entrances of the clusters and refine it by searches inside the clusters
+
+    static const uint32_t SOURCE_NODE = INVALID_TILE - 1,
+                          DESTINATION_NODE = INVALID_TILE - 2;
+    static const float INFINITE_COST = std::numeric_limits<float>::infinity();
+
+    updateClusters(map);
+
+    const uint32_t sourceCluster = getCluster(source),
+                   destinationCluster = getCluster(destination);
+    const Cluster& sourceEntrances = map.clusters[sourceCluster];
+    const Cluster& destinationEntrances = map.clusters[destinationCluster];
+
+    // Connect the source and the destination to the entrances of their clusters.
+    explore(map.passable, source, getClusterBounds(sourceCluster));
+    _sourceCosts.assign(sourceEntrances.entrances.size(), INFINITE_COST);
+    for (size_t i = 0; i < sourceEntrances.entrances.size(); ++i) {
+        const uint32_t tile = sourceEntrances.entrances[i].tile;
+        if (_visitStamp[tile] == _searchStamp) _sourceCosts[i] = _cost[tile];
+    }
+    explore(map.passable, destination, getClusterBounds(destinationCluster));
+    _destinationCosts.assign(destinationEntrances.entrances.size(), INFINITE_COST);
+    for (size_t i = 0; i < destinationEntrances.entrances.size(); ++i) {
+        const uint32_t tile = destinationEntrances.entrances[i].tile;
+        if (_visitStamp[tile] == _searchStamp) _destinationCosts[i] = _cost[tile];
+    }
+
+    // An abstract node is an entrance, identified by its cluster and its index in the cluster.
+    auto getTile = [&](uint32_t node) -> uint32_t {
+        if (SOURCE_NODE == node) return source;
+        if (DESTINATION_NODE == node) return destination;
+        return map.clusters[node >> 8].entrances[node & 0xFF].tile;
+    };
+    const int dst_ix = destination % _tileCountX,
+              dst_iy = destination / _tileCountX;
+    auto getEstimate = [&](uint32_t node) -> float {
+        const uint32_t tile = getTile(node);
+        return Distance()(tile % _tileCountX, tile / _tileCountX, dst_ix, dst_iy);
+    };
+    auto relax = [&](uint32_t node, uint32_t parent, float cost) {
+        auto it = _abstractNodes.find(node);
+        if (it != _abstractNodes.end() && it->second.cost <= cost) return;
+        _abstractNodes[node] = AbstractNode{cost, parent};
+        _openList.push_back(OpenNode{cost + getEstimate(node), node});
+        std::push_heap(_openList.begin(), _openList.end());
+    };
+
+    // Search the abstract graph.
+    _abstractNodes.clear();
+    _openList.clear();
+    relax(SOURCE_NODE, INVALID_TILE, 0.0f);
+    bool found = false;
+    while (!_openList.empty()) {
+        std::pop_heap(_openList.begin(), _openList.end());
+        const OpenNode node = _openList.back();
+        _openList.pop_back();
+
+        if (DESTINATION_NODE == node.tile) {
+            found = true;
+            break;
+        }
+
+        const float cost = _abstractNodes[node.tile].cost;
+        if (node.estimate > cost + getEstimate(node.tile)) {
+            continue;
+        }
+
+        if (SOURCE_NODE == node.tile) {
+            for (size_t i = 0; i < _sourceCosts.size(); ++i) {
+                if (INFINITE_COST != _sourceCosts[i]) relax((sourceCluster << 8) | i, SOURCE_NODE, _sourceCosts[i]);
+            }
+            continue;
+        }
+
+        const uint32_t clusterIndex = node.tile >> 8,
+                       entranceIndex = node.tile & 0xFF;
+        const Cluster& cluster = map.clusters[clusterIndex];
+        const Entrance& entrance = cluster.entrances[entranceIndex];
+
+        // Cross the border to the matching entrance of the neighbouring cluster.
+        const uint32_t neighbourIndex = getCluster(entrance.link);
+        const Cluster& neighbour = map.clusters[neighbourIndex];
+        for (size_t i = 0; i < neighbour.entrances.size(); ++i) {
+            if (neighbour.entrances[i].tile == entrance.link && neighbour.entrances[i].link == entrance.tile) {
+                relax((neighbourIndex << 8) | i, node.tile, cost + 1.0f);
+                break;
+            }
+        }
+
+        // Move to the other entrances of this cluster.
+        const size_t count = cluster.entrances.size();
+        for (size_t i = 0; i < count; ++i) {
+            const float pathCost = cluster.costs[entranceIndex * count + i];
+            if (i != entranceIndex && INFINITE_COST != pathCost) relax((clusterIndex << 8) | i, node.tile, cost + pathCost);
+        }
+
+        // Move to the destination.
+        if (clusterIndex == destinationCluster && INFINITE_COST != _destinationCosts[entranceIndex]) {
+            relax(DESTINATION_NODE, node.tile, cost + _destinationCosts[entranceIndex]);
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    std::vector<uint32_t> waypoints;
+    for (uint32_t node = DESTINATION_NODE; INVALID_TILE != node; node = _abstractNodes[node].parent) {
+        waypoints.push_back(getTile(node));
+    }
+    std::reverse(waypoints.begin(), waypoints.end());
+
+    // Refine the path. Consecutive waypoints are either adjacent or in the same cluster.
+    std::vector<uint32_t> segment;
+    _path.clear();
+    _path.push_back(source);
+    for (size_t i = 1; i < waypoints.size(); ++i) {
+        const uint32_t from = waypoints[i - 1], to = waypoints[i];
+        if (from == to) continue;
+
+        const uint32_t distance = std::abs(int(from % _tileCountX) - int(to % _tileCountX))
+                                + std::abs(int(from / _tileCountX) - int(to / _tileCountX));
+        if (1 == distance) {
+            _path.push_back(to);
+            continue;
+        }
+        if (!search(map.passable, from, to, CLUSTER_SIZE * CLUSTER_SIZE, getClusterBounds(getCluster(from)), segment)) {
+            _path.clear();
+            return false;
+        }
+        _path.insert(_path.end(), segment.begin() + 1, segment.end());
+    }
+
+    return true;
+}
 
 bool AStar::find_path(std::shared_ptr<const ego_mesh_t> mesh, uint32_t stoppedby, const int src_ix, const int src_iy, int dst_ix, int dst_iy)
 {
     /// @author ZF
-    /// @details Explores up to MAX_ASTAR_NODES number of nodes to find a path between the source coordinates and destination coordinates.
+    /// @details Finds a path between the source coordinates and destination coordinates.
     //              The result is stored in a node list and can be accessed through AStar_get_path(). Returns false if no path was found.
 
-    int j, k, cnt;
-    bool done;
-    int deadend_count;
-    Node *popen;
-    float weight;
+    int j, k;
 
     // do not start if there is no mesh
     if (!mesh) {
         throw Id::RuntimeErrorException(__FILE__, __LINE__, "nullptr == mesh");
     }
+    _path.clear();
+
     // do not start if the initial point is off the mesh
     if (Index1D::Invalid == mesh->getTileIndex(Index2D(src_ix, src_iy)))
     {
@@ -137,232 +579,131 @@ bool AStar::find_path(std::shared_ptr<const ego_mesh_t> mesh, uint32_t stoppedby
     }
 flexible_destination:
 
-    // restart the algorithm
-    done = false;
-    reset();
-
-    // initialize the starting node
-    weight = Distance()(src_ix, src_iy, dst_ix, dst_iy);
-    start_node = add_node(src_ix, src_iy, nullptr, weight, false);
-
-    // do the algorithm
-    while (!done)
+    // the destination must be on the mesh
+    if (Index1D::Invalid == mesh->getTileIndex(Index2D(dst_ix, dst_iy)))
     {
-        int tmp_x, tmp_y;
-        bool stop;
-
-        // list is completely full... we failed
-        if (node_list_length == MAX_ASTAR_NODES) break;
-
-        //Get the cheapest open node
-        popen = get_next_node();
-        if (nullptr != popen)
-        {
-            // find some child nodes
-            deadend_count = 0;
-            for (j = -1; j <= 1; j++)
-            {
-                tmp_x = popen->ix + j;
-
-                for (k = -1; k <= 1; k++)
-                {
-                    // do not recompute the open node!
-                    if (j == 0 && k == 0) continue;
-
-                    // do not check diagonals
-                    if (j != 0 && k != 0) continue;
-
-                    tmp_y = popen->iy + k;
-
-                    // check for the simplest case, is this the destination node?
-                    if (tmp_x == dst_ix && tmp_y == dst_iy)
-                    {
-                        weight = Distance()(tmp_x, tmp_y, popen->ix, popen->iy);
-                        final_node = add_node(tmp_x, tmp_y, popen, weight, false);
-                        done = true;
-                        continue;
-                    }
-
-                    // is the test node on the mesh?
-                    Index1D itile = mesh->getTileIndex(Index2D(tmp_x, tmp_y));
-                    if (Index1D::Invalid == itile)
-                    {
-                        deadend_count++;
-                        continue;
-                    }
-
-                    // is this already in the list? (must be checked before wall or fanoff)
-                    stop = false;
-                    for (cnt = 0; cnt < node_list_length; cnt++)
-                    {
-                        if (node_list[cnt].ix == tmp_x && node_list[cnt].iy == tmp_y)
-                        {
-                            deadend_count++;
-                            stop = true;
-                            break;
-                        }
-                    }
-                    if (stop) continue;
-
-                    //Dont walk into pits
-                    //@todo: might need to check tile Z level here instead
-                    const ego_tile_info_t& ptile = mesh->getTileInfo(itile);
-
-                    if (ptile.isFanOff())
-                    {
-                        // add the invalid tile to the list as a closed tile
-                        add_node(tmp_x, tmp_y, popen, 0xFFFF, true);
-                        deadend_count++;
-                        continue;
-                    }
-
-                    // is this a wall or impassable?
-                    if (mesh->tile_has_bits(Index2D(tmp_x, tmp_y), stoppedby))
-                    {
-                        // add the invalid tile to the list as a closed tile
-                        add_node(tmp_x, tmp_y, popen, 0xFFFF, true);
-                        deadend_count++;
-                        continue;
-                    }
+        return false;
+    }
 
-                    ///
-                    /// @todo  I need to check for collisions with static objects, like trees
+    validate(mesh);
+    const uint32_t source = src_ix + src_iy * _tileCountX;
+    const uint32_t destination = dst_ix + dst_iy * _tileCountX;
 
-                    // OK. determine the weight (F + H)
-                    weight = Distance()(tmp_x, tmp_y, popen->ix, popen->iy)
-                           + Distance()(tmp_x, tmp_y, dst_ix, dst_iy);
-                    add_node(tmp_x, tmp_y, popen, weight, false);
-                }
-            }
-
-            if (deadend_count == 4)
-            {
-                // this node is no longer active.
-                // move it to the closed list so that we do not get any loops
-                popen->closed = true;
-            }
-        }
-
-        //Found no open nodes
-        else
+    // is the path in the cache?
+    _pathCacheClock++;
+    for (CachedPath& cachedPath : _pathCache)
+    {
+        if (cachedPath.source == source && cachedPath.destination == destination && cachedPath.stoppedBy == stoppedby)
         {
-            break;
+            cachedPath.lastUsed = _pathCacheClock;
+            _path = cachedPath.tiles;
+            return true;
         }
     }
 
-#ifdef DEBUG_ASTAR
-    if (!done && node_list_length == MAX_ASTAR_NODES) printf("AStar failed because maximum number of nodes were explored (%d)\n", MAX_ASTAR_NODES);
-#endif
+    // do the algorithm, searching hierarchically unless source and destination are in the same or neighbouring clusters
+    PassabilityMap& map = getPassability(*mesh, stoppedby);
+    const bool isFar = std::abs(src_ix / int(CLUSTER_SIZE) - dst_ix / int(CLUSTER_SIZE)) > 1
+                    || std::abs(src_iy / int(CLUSTER_SIZE) - dst_iy / int(CLUSTER_SIZE)) > 1;
+    bool found;
+    if (isFar)
+    {
+        found = searchHierarchical(map, source, destination);
+    }
+    else
+    {
+        const size_t nodeBudget = egoboo_config_t::get().game_pathfinding_nodeBudget.getValue();
+        found = search(map.passable, source, destination, nodeBudget, getBounds(), _path);
+    }
+    if (!found)
+    {
+        return false;
+    }
 
-    return done;
+    // remember the path, replacing the least recently used one if the cache is full
+    if (_pathCache.size() < MAX_CACHED_PATHS)
+    {
+        _pathCache.push_back(CachedPath());
+    }
+    CachedPath& cachedPath = *std::min_element(_pathCache.begin(), _pathCache.end(),
+                                               [](const CachedPath& x, const CachedPath& y) { return x.lastUsed < y.lastUsed; });
+    cachedPath.source = source;
+    cachedPath.destination = destination;
+    cachedPath.stoppedBy = stoppedby;
+    cachedPath.lastUsed = _pathCacheClock;
+    cachedPath.tiles = _path;
+
+    return true;
 }
 
-bool AStar::get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst)
+bool AStar::get_path(const int dst_x, const int dst_y, waypoint_list_t& wplst)
 {
     /// @author ZF
     /// @details Fills a waypoint list with sensible waypoints. It will return false if it failed to add at least one waypoint.
-    //              The function goes through all the AStar_nodes and finds out which one are critical. A critical node is one that
-    //              creates a corner. The function automatically prunes away all non-critical nodes. The final waypoint will always be
+    //              The function goes through all the path tiles and finds out which one are critical. A critical tile is one that
+    //              creates a corner. The function automatically prunes away all non-critical tiles. The final waypoint will always be
     //              the destination coordinates.
 
-    int i;
-    size_t path_length, waypoint_num;
-    //bool diagonal_movement = false;
-
-    Node *current_node, *last_waypoint, *safe_waypoint;
-    Node *node_path[MAX_ASTAR_PATH];
-
-    //Fill the waypoint list as much as we can, the final waypoint will always be the destination waypoint
-    waypoint_num = 0;
-    current_node = final_node;
-    last_waypoint = start_node;
+    size_t waypoint_num = 0;
 
-    //Build the local node path tree
-    path_length = 0;
-    while (path_length < MAX_ASTAR_PATH && current_node != start_node)
-    {
-        // add the node to the end of the path
-        node_path[path_length++] = current_node;
-
-        // get next node
-        current_node = current_node->parent;
-    }
+    if (_path.size() < 2) return false;
 
-    //Begin at the end of the list, which contains the starting node
-    safe_waypoint = nullptr;
-    for (i = path_length - 1; i >= 0 && waypoint_num < MAXWAY; i--)
+    //Begin at the tile after the starting tile
+    uint32_t last_waypoint = _path[0];
+    uint32_t safe_waypoint = INVALID_TILE;
+    for (size_t i = 1; i < _path.size() && waypoint_num < MAXWAY; i++)
     {
-        bool change_direction;
-
-        //get current node
-        current_node = node_path[i];
+        //get current tile
+        const uint32_t current_tile = _path[i];
+        const bool is_final = (i + 1 == _path.size());
 
-        //the first node should be safe
-        if (nullptr == safe_waypoint) safe_waypoint = current_node;
+        //the first tile should be safe
+        if (INVALID_TILE == safe_waypoint) safe_waypoint = current_tile;
 
         //is there a change in direction?
-        change_direction = (last_waypoint->ix != current_node->ix && last_waypoint->iy != current_node->iy);
-
-        //are we moving diagonally? if so, then don't fill the waypoint list with unessecary waypoints
-        /*if( i != 0 )
-        {
-            if( diagonal_movement ) diagonal_movement = (ABS(current_node->ix - safe_waypoint->ix) == 1)  && (ABS(current_node->iy - safe_waypoint->iy) == 1);
-            else                    diagonal_movement = (ABS(current_node->ix - last_waypoint->ix) == 1)  && (ABS(current_node->iy - last_waypoint->iy) == 1);
-
-            if( diagonal_movement )
-            {
-                safe_waypoint = current_node;
-                continue;
-            }
-        }*/
+        const bool change_direction = (last_waypoint % _tileCountX != current_tile % _tileCountX)
+                                   && (last_waypoint / _tileCountX != current_tile / _tileCountX);
 
         //If we have a change in direction, we need to add it as a waypoint, always add the last waypoint
-        if (i == 0 || change_direction)
+        if (is_final || change_direction)
         {
             int way_x;
             int way_y;
 
             //Special exception for final waypoint, use raw integer
-            if (i == 0)
+            if (is_final)
             {
-                way_x = pos_x;
+                way_x = dst_x;
                 way_y = dst_y;
             }
             else
             {
                 // translate to raw coordinates
-                way_x = safe_waypoint->ix * Info<int>::Grid::Size() + (Info<int>::Grid::Size() / 2);
-                way_y = safe_waypoint->iy * Info<int>::Grid::Size() + (Info<int>::Grid::Size() / 2);
+                way_x = (safe_waypoint % _tileCountX) * Info<int>::Grid::Size() + (Info<int>::Grid::Size() / 2);
+                way_y = (safe_waypoint / _tileCountX) * Info<int>::Grid::Size() + (Info<int>::Grid::Size() / 2);
             }
 
 #ifdef DEBUG_ASTAR
-            // using >> for division only works if you know for certainty that the value
-            // you are shifting is not intended to be neative
-            printf("Waypoint %d: X: %d, Y: %d \n", waypoint_num, static_cast<int>(way_x / GRID_ISIZE), static_cast<int>(way_y / GRID_ISIZE));
+            printf("Waypoint %" PRIuZ ": X: %d, Y: %d \n", waypoint_num, static_cast<int>(way_x / Info<int>::Grid::Size()), static_cast<int>(way_y / Info<int>::Grid::Size()));
             point_list_add(way_x, way_y, 200, 800);
-            line_list_add(last_waypoint->ix*GRID_FSIZE + (GRID_ISIZE / 2), last_waypoint->iy*GRID_FSIZE + (GRID_ISIZE / 2), 200, way_x, way_y, 200, 800);
 #endif
 
-            // add the node to the waypoint list
+            // add the tile to the waypoint list
             last_waypoint = safe_waypoint;
             waypoint_list_t::push(wplst, way_x, way_y);
             waypoint_num++;
 
             //This one is now safe
-            safe_waypoint = current_node;
+            safe_waypoint = current_tile;
         }
 
-        //keep track of the last safe node from our previous waypoint
+        //keep track of the last safe tile from our previous waypoint
         else
         {
-            safe_waypoint = current_node;
+            safe_waypoint = current_tile;
         }
     }
 
-#ifdef DEBUG_ASTAR
-    if (waypoint_num > 0) point_list_add(start_node->ix*GRID_FSIZE + (GRID_ISIZE / 2), start_node->iy*GRID_FSIZE + (GRID_ISIZE / 2), 200, 80);
-#endif
-
     return waypoint_num > 0;
 }
 
@@ -19,8 +19,11 @@
 
 /// @file egolib/AI/AStar.h
 /// @brief A* pathfinding.
-/// @details A very ugly implementation of the A* pathfinding agorithm.
-///          There is lots of room for improvement.
+/// @details A* search over the tiles of the mesh with a binary heap as open list,
+///          cached passability maps and a cache of recently found paths.
+///          Long paths are found by hierarchical pathfinding (HPA*): the tiles are grouped into
+///          clusters, a small search over the entrances between clusters finds the route and
+///          short searches inside the clusters refine it.
 
 #pragma once
 
@@ -32,30 +35,122 @@ struct waypoint_list_t;
 
 /// Implementation of A* pathfinding algorithm.
 struct AStar {
-public:
-    struct Node {
-        float weight;
-        bool closed;
-        int ix, iy;
-        Node *parent;
-    };
 public:
     AStar();
+    /**
+     * @brief
+     *  Find a path between two tiles.
+     * @param stoppedBy
+     *  the tile FX which block the path
+     * @return
+     *  @a true if a path was found, @a false otherwise. The path can be retrieved by get_path().
+     * @remark
+     *  If the destination tile is blocked, one of its neighbours is used instead.
+     *  Paths between tiles in clusters which are not neighbours are found by the hierarchical search.
+     *  A flat search gives up after expanding the number of tiles given by the configuration
+     *  variable @a game.pathfinding.nodeBudget.
+     */
     bool find_path(std::shared_ptr<const ego_mesh_t> mesh, uint32_t stoppedBy, const int src_ix, const int src_iy, int dst_ix, int dst_iy);
-    bool get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst);
+    /**
+     * @brief
+     *  Fill a waypoint list with the corners of the path found by the last successful call to find_path().
+     *  The final waypoint is the point (@a dst_x, @a dst_y).
+     */
+    bool get_path(const int dst_x, const int dst_y, waypoint_list_t& wplst);
 private:
-    static constexpr size_t MAX_ASTAR_NODES = 512;   ///< Maximum number of nodes to explore
-    static constexpr size_t MAX_ASTAR_PATH = 128;    ///< Maximum length of the final path (before pruning)
-private:
-    Node node_list[MAX_ASTAR_NODES];
-    int node_list_length;
-    Node *final_node;
-    Node *start_node;
+    static constexpr size_t MAX_CACHED_PATHS = 64;   ///< Maximum number of paths in the path cache
+    static constexpr uint32_t CLUSTER_SIZE = 16;     ///< Edge length of a cluster in tiles
+    static constexpr uint32_t INVALID_TILE = std::numeric_limits<uint32_t>::max();
+
+    /// A rectangle of tiles, inclusive.
+    struct TileRect {
+        uint32_t minX, minY, maxX, maxY;
+    };
+
+    /// A tile at the border of a cluster through which paths may enter or leave the cluster.
+    struct Entrance {
+        uint32_t tile;      ///< The tile in this cluster
+        uint32_t link;      ///< The adjacent tile in the neighbouring cluster
+    };
+
+    /// A cluster of CLUSTER_SIZE x CLUSTER_SIZE tiles and the shortest paths between its entrances.
+    struct Cluster {
+        std::vector<Entrance> entrances;
+        std::vector<float> costs;       ///< Cost between each pair of entrances inside the cluster, infinite if there is no path
+    };
+
+    /// The passability of all tiles for a combination of blocking tile FX and the clusters built from it.
+    struct PassabilityMap {
+        uint32_t stoppedBy;
+        std::vector<char> passable;     ///< Is a tile on the mesh, not a pit and not blocked?
+        std::vector<Cluster> clusters;  ///< Empty until the first hierarchical search
+        std::vector<char> dirty;        ///< Clusters with tiles whose passability changed
+    };
+
+    /// A path in the path cache.
+    struct CachedPath {
+        uint32_t source, destination, stoppedBy;    ///< The key
+        uint64_t lastUsed;                          ///< When the path was used last
+        std::vector<uint32_t> tiles;                ///< The tiles of the path from the source to the destination
+    };
+
+    /// An entry of the open list.
+    struct OpenNode {
+        float estimate;     ///< Cost so far plus estimated remaining cost
+        uint32_t tile;      ///< A tile, or an abstract node in the hierarchical search
+        bool operator<(const OpenNode& other) const {
+            // Reversed, so that the heap puts the cheapest node on top.
+            return estimate > other.estimate;
+        }
+    };
+
+    /// The search state of an abstract node in the hierarchical search.
+    struct AbstractNode {
+        float cost;
+        uint32_t parent;
+    };
+
+    // The mesh the caches were built for.
+    std::weak_ptr<const ego_mesh_t> _mesh;
+    uint32_t _meshFXVersion;
+    uint32_t _tileCountX, _tileCountY;
+    uint32_t _clusterCountX, _clusterCountY;
+
+    std::vector<PassabilityMap> _passabilityMaps;
+    std::vector<CachedPath> _pathCache;
+    uint64_t _pathCacheClock;
+
+    // The search state of all tiles. A tile was reached by the current search if its stamp is the search stamp.
+    std::vector<uint32_t> _visitStamp;
+    std::vector<uint32_t> _parent;
+    std::vector<float> _cost;
+    uint32_t _searchStamp;
+    std::vector<OpenNode> _openList;
+
+    // The search state of the hierarchical search.
+    std::unordered_map<uint32_t, AbstractNode> _abstractNodes;
+    std::vector<float> _sourceCosts, _destinationCosts;
+
+    /// The path found by the last successful search, from the source to the destination.
+    std::vector<uint32_t> _path;
 
 private:
-    Node *get_next_node();
-    Node *add_node(const int x, const int y, Node *parent, float weight, bool closed);
-    void reset();
+    void validate(const std::shared_ptr<const ego_mesh_t>& mesh);
+    void computePassability(const ego_mesh_t& mesh, uint32_t stoppedBy, std::vector<char>& passable) const;
+    PassabilityMap& getPassability(const ego_mesh_t& mesh, uint32_t stoppedBy);
+
+    TileRect getBounds() const;
+    TileRect getClusterBounds(uint32_t cluster) const;
+    uint32_t getCluster(uint32_t tile) const;
+
+    void beginSearch();
+    bool search(const std::vector<char>& passable, uint32_t source, uint32_t destination, size_t nodeBudget, const TileRect& bounds, std::vector<uint32_t>& path);
+    void explore(const std::vector<char>& passable, uint32_t source, const TileRect& bounds);
+
+    void updateClusters(PassabilityMap& map);
+    void buildCluster(PassabilityMap& map, uint32_t cluster);
+    void addEntrances(const std::vector<char>& passable, Cluster& cluster, uint32_t start, uint32_t length, int step, int link);
+    bool searchHierarchical(PassabilityMap& map, uint32_t source, uint32_t destination);
 };
 
 extern AStar g_astar;
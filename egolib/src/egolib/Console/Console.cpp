@@ -478,6 +478,9 @@ bool Console::draw()
 
 		height = pwin->h;
 
+		// draw all lines in one batch
+		this->pfont->_font->beginBatch();
+
 		char buffer[ConsoleSettings::InputSettings::Length];
 
 		// draw the current command line
@@ -527,6 +530,8 @@ bool Console::draw()
 				this->pfont->_font->drawText(buffer, pwin->x, height - textHeight, white);
 			}
 		}
+
+		this->pfont->_font->endBatch();
 	}
 	ATTRIB_POP(__FUNCTION__);
 
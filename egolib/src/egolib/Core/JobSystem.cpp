@@ -0,0 +1,135 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/JobSystem.cpp
+/// @brief  Deterministic data-parallel jobs for the game logic update.
+
+#include "egolib/Core/JobSystem.hpp"
+#include "egolib/egoboo_setup.h"
+#include "egolib/Log/_Include.hpp"
+
+namespace Ego
+{
+namespace Core
+{
+
+JobSystem::JobSystem() :
+    _threadPool(nullptr),
+    _workerCount(0),
+    _parallel(false)
+{
+    _workerCount = egoboo_config_t::get().game_parallelUpdate_workerCount.getValue();
+    if (0 == _workerCount)
+    {
+        // The calling thread works as well, leave it its own hardware thread.
+        size_t hardwareThreads = std::thread::hardware_concurrency();
+        _workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    if (_workerCount > 0)
+    {
+        _threadPool = std::unique_ptr<ThreadPool>(new ThreadPool(_workerCount));
+    }
+    setParallel(egoboo_config_t::get().game_parallelUpdate_enable.getValue());
+
+    Log::get().info("job system: %" PRIuZ " worker threads, parallel updates %s\n", _workerCount, _parallel ? "enabled" : "disabled");
+}
+
+JobSystem::~JobSystem()
+{
+    _threadPool.reset();
+}
+
+size_t JobSystem::getWorkerCount() const
+{
+    return _workerCount;
+}
+
+bool JobSystem::isParallel() const
+{
+    return _parallel;
+}
+
+void JobSystem::setParallel(bool parallel)
+{
+    _parallel = parallel && nullptr != _threadPool;
+}
+
+void JobSystem::parallelFor(size_t count, size_t grainSize, const Job& job)
+{
+    if (0 == count)
+    {
+        return;
+    }
+    grainSize = std::max<size_t>(1, grainSize);
+
+    // Partition the range into at most one partition per thread, but never smaller than the grain size.
+    size_t partitionCount = 1;
+    if (_parallel)
+    {
+        partitionCount = std::min(_workerCount + 1, (count + grainSize - 1) / grainSize);
+    }
+    if (partitionCount <= 1)
+    {
+        job(0, count);
+        return;
+    }
+
+    const size_t partitionSize = (count + partitionCount - 1) / partitionCount;
+
+    // Hand out all but the first partition to the workers ...
+    std::vector<std::future<void>> pending;
+    pending.reserve(partitionCount - 1);
+    for (size_t begin = partitionSize; begin < count; begin += partitionSize)
+    {
+        const size_t end = std::min(count, begin + partitionSize);
+        pending.push_back(_threadPool->submit([&job, begin, end]() { job(begin, end); }));
+    }
+
+    // ... and do the first partition on this thread.
+    std::exception_ptr error = nullptr;
+    try
+    {
+        job(0, std::min(count, partitionSize));
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    // Wait for all partitions, even if one of them failed, as they reference the job.
+    for (std::future<void>& future : pending)
+    {
+        try
+        {
+            future.get();
+        }
+        catch (...)
+        {
+            if (!error) error = std::current_exception();
+        }
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace Core
+} // namespace Ego
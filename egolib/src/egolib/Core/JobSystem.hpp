@@ -0,0 +1,108 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/JobSystem.hpp
+/// @brief  Deterministic data-parallel jobs for the game logic update.
+
+#pragma once
+
+#include "egolib/platform.h"
+#include "egolib/Core/ThreadPool.hpp"
+
+namespace Ego
+{
+namespace Core
+{
+
+/**
+ * @brief
+ *  Runs data-parallel jobs of the game logic update on a ThreadPool.
+ *
+ *  A job is a function applied to every index of a range. The range is split into
+ *  contiguous partitions which are processed by the worker threads and the calling
+ *  thread, and parallelFor() returns once all partitions are done. A job must only
+ *  write to the elements of its own index (or to per-index slots of a buffer), so
+ *  the result does not depend on the number of threads or the order of execution.
+ *  Anything else (spawning, sounds, random numbers, other entities) has to be
+ *  recorded by the job and applied on the calling thread afterwards.
+ *
+ *  If parallel updates are disabled in the configuration, all jobs run on the
+ *  calling thread.
+ */
+class JobSystem : public Singleton<JobSystem>
+{
+public:
+    /**
+     * @brief
+     *  A job applied to the index range <tt>[begin, end)</tt>.
+     */
+    using Job = std::function<void(size_t begin, size_t end)>;
+
+    /**
+     * @brief
+     *  Apply a job to the index range <tt>[0, count)</tt>.
+     * @param count
+     *  the number of elements
+     * @param grainSize
+     *  the minimum number of elements in a partition. Ranges smaller than this are
+     *  processed on the calling thread without involving the workers.
+     * @param job
+     *  the job
+     * @remark
+     *  Exceptions raised by the job are re-raised on the calling thread after all
+     *  partitions have finished.
+     */
+    void parallelFor(size_t count, size_t grainSize, const Job& job);
+
+    /**
+     * @return
+     *  the number of worker threads (excluding the calling thread)
+     */
+    size_t getWorkerCount() const;
+
+    /**
+     * @return
+     *  @a true if jobs are spread over worker threads, @a false if they run on the calling thread
+     */
+    bool isParallel() const;
+
+    /**
+     * @brief
+     *  Switch between running jobs on worker threads and running them on the calling thread.
+     * @remark
+     *  Must not be called from within a job.
+     */
+    void setParallel(bool parallel);
+
+protected:
+    // Befriend with singleton to grant access to JobSystem::JobSystem and JobSystem::~JobSystem.
+    using TheSingleton = Singleton<JobSystem>;
+    friend TheSingleton;
+
+    JobSystem();
+    virtual ~JobSystem();
+
+private:
+    std::unique_ptr<ThreadPool> _threadPool;
+    size_t _workerCount;
+    bool _parallel;
+};
+
+} // namespace Core
+} // namespace Ego
@@ -0,0 +1,230 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/SpatialHash.hpp
+/// @brief  Uniform grid for fast element lookup based on bounding boxes
+
+#pragma once
+
+#include "egolib/Math/Standard.hpp"
+
+namespace Ego
+{
+
+/**
+ * @brief
+ *  A uniform grid over a rectangular area which maps cells to the elements overlapping them.
+ *
+ *  All data is kept in flat arrays which keep their capacity when the grid is cleared,
+ *  so rebuilding the grid every frame does not allocate once it has warmed up.
+ *  Inserting an element is O(1) per covered cell, a query visits only the cells
+ *  overlapping the search area.
+ *
+ *  An element covering several cells is reported only once per query: it is reported
+ *  in the first cell shared by the element and the search area. This needs no per-query
+ *  state, so concurrent queries are safe as long as nobody inserts or clears.
+ * @remark
+ *  The element type must provide <tt>AABB2f getAABB2D() const</tt>. The cells of an element
+ *  are determined when it is inserted, but queries test the current bounds of the element.
+ */
+template<typename T>
+class SpatialHash
+{
+public:
+    /// The default edge length of a cell.
+    static constexpr float DEFAULT_CELL_SIZE = 256.0f;
+
+    /**
+    * @brief
+    *   Construct an empty grid.
+    * @param cellSize
+    *   the edge length of a cell. Should be about the size of the typical element.
+    **/
+    SpatialHash(const float cellSize = DEFAULT_CELL_SIZE) :
+        _invCellSize(1.0f / std::max(1.0f, cellSize)),
+        _bounds(),
+        _cellCountX(1),
+        _cellCountY(1),
+        _cellHeads(1, INVALID_INDEX),
+        _links(),
+        _elements(),
+        _cellRanges()
+    {
+        //ctor
+    }
+
+    /**
+    * @brief
+    *   Inserts an element into this grid
+    * @return
+    *   true if the element overlaps the bounds of this grid, false if it was not added
+    **/
+    bool insert(const std::shared_ptr<T> &element)
+    {
+        const AABB2f elementBounds = element->getAABB2D();
+
+        //Element does not belong in this grid
+        if(!_bounds.overlaps(elementBounds)) {
+            return false;
+        }
+
+        const uint32_t elementIndex = _elements.size();
+        const CellRange range = getCellRange(elementBounds);
+        _elements.push_back(element);
+        _cellRanges.push_back(range);
+
+        //Link the element into every cell it covers
+        for(uint32_t y = range.minY; y <= range.maxY; ++y) {
+            for(uint32_t x = range.minX; x <= range.maxX; ++x) {
+                uint32_t &head = _cellHeads[x + y * _cellCountX];
+                _links.push_back(Link{elementIndex, head});
+                head = _links.size() - 1;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+    * @brief
+    *   Find all elements that overlap a bounding box.
+    * @param searchArea
+    *   The bounding box which is used for finding elements
+    * @param result
+    *   Vector the elements that overlap the search area are appended to. Does not allocate
+    *   if the vector has enough capacity.
+    **/
+    void find(const AABB2f &searchArea, std::vector<std::shared_ptr<T>> &result) const
+    {
+        //Search area is not part of our bounds
+        if(_elements.empty() || !_bounds.overlaps(searchArea)) {
+            return;
+        }
+
+        const CellRange searchRange = getCellRange(searchArea);
+        for(uint32_t y = searchRange.minY; y <= searchRange.maxY; ++y) {
+            for(uint32_t x = searchRange.minX; x <= searchRange.maxX; ++x) {
+                for(uint32_t link = _cellHeads[x + y * _cellCountX]; link != INVALID_INDEX; link = _links[link].next) {
+                    const uint32_t elementIndex = _links[link].element;
+
+                    //Only report the element in the first cell it shares with the search area
+                    const CellRange &elementRange = _cellRanges[elementIndex];
+                    if(x != std::max(elementRange.minX, searchRange.minX) || y != std::max(elementRange.minY, searchRange.minY)) {
+                        continue;
+                    }
+
+                    //Check if element is within search area
+                    const std::shared_ptr<T> &element = _elements[elementIndex];
+                    if(element->getAABB2D().overlaps(searchArea)) {
+                        result.push_back(element);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+    * @brief
+    *   Removes all elements from this grid and sets new bounds for it. Memory is retained.
+    **/
+    void clear(const float minX, const float minY, const float maxX, const float maxY)
+    {
+        //Reset bounds
+        _bounds._min[kX] = minX;
+        _bounds._min[kY] = minY;
+        _bounds._max[kX] = std::max(minX, maxX);
+        _bounds._max[kY] = std::max(minY, maxY);
+
+        //Resize the grid to cover the bounds
+        _cellCountX = std::max<uint32_t>(1, std::ceil((_bounds._max[kX] - minX) * _invCellSize));
+        _cellCountY = std::max<uint32_t>(1, std::ceil((_bounds._max[kY] - minY) * _invCellSize));
+        _cellHeads.assign(_cellCountX * _cellCountY, INVALID_INDEX);
+
+        //Clear all elements
+        _links.clear();
+        _elements.clear();
+        _cellRanges.clear();
+    }
+
+    /**
+    * @return
+    *   the number of elements in this grid
+    **/
+    size_t size() const
+    {
+        return _elements.size();
+    }
+
+private:
+    /// Inclusive range of cells covered by a bounding box.
+    struct CellRange
+    {
+        uint32_t minX, minY, maxX, maxY;
+    };
+
+    /// An entry in the singly linked list of elements of a cell.
+    struct Link
+    {
+        uint32_t element;   ///< Index of the element
+        uint32_t next;      ///< Index of the next link of the cell or INVALID_INDEX
+    };
+
+    /**
+    * @brief
+    *   Get the range of cells overlapped by a bounding box, clamped to the grid.
+    **/
+    CellRange getCellRange(const AABB2f &bounds) const
+    {
+        CellRange range;
+        range.minX = toCell(bounds.getMin()[kX] - _bounds.getMin()[kX], _cellCountX);
+        range.minY = toCell(bounds.getMin()[kY] - _bounds.getMin()[kY], _cellCountY);
+        range.maxX = toCell(bounds.getMax()[kX] - _bounds.getMin()[kX], _cellCountX);
+        range.maxY = toCell(bounds.getMax()[kY] - _bounds.getMin()[kY], _cellCountY);
+        return range;
+    }
+
+    uint32_t toCell(const float offset, const uint32_t cellCount) const
+    {
+        const float cell = std::floor(offset * _invCellSize);
+        if(cell <= 0.0f) return 0;
+        if(cell >= cellCount - 1) return cellCount - 1;
+        return static_cast<uint32_t>(cell);
+    }
+
+private:
+    static const uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+    float _invCellSize;                                 //< Reciprocal of the edge length of a cell
+    AABB2f _bounds;                                     //< Area covered by the grid
+    uint32_t _cellCountX;                               //< Number of cells along the x-axis
+    uint32_t _cellCountY;                               //< Number of cells along the y-axis
+
+    std::vector<uint32_t> _cellHeads;                   //< Index of the first link of each cell or INVALID_INDEX
+    std::vector<Link> _links;                           //< Cell lists of all cells
+    std::vector<std::shared_ptr<T>> _elements;          //< All elements in insertion order
+    std::vector<CellRange> _cellRanges;                 //< Cells covered by each element
+};
+
+template<typename T>
+constexpr float SpatialHash<T>::DEFAULT_CELL_SIZE;
+
+template<typename T>
+const uint32_t SpatialHash<T>::INVALID_INDEX;
+
+} //namespace Ego
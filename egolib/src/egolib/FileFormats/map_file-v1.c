@@ -32,10 +32,12 @@ bool map_read_v1(vfs_FILE& file, map_t& map)
     auto& mem = map._mem;
 
     // Load tile data.
-    for (auto& tile : mem.tiles)
+    std::vector<Uint32> tile_data(mem.tiles.size(), 0);
+    vfs_read_Uint32_array(file, tile_data.data(), tile_data.size());
+    for (size_t i = 0; i < mem.tiles.size(); ++i)
     {
-        Uint32 ui32_tmp;
-        vfs_read_Uint32(file, &ui32_tmp);
+        auto& tile = mem.tiles[i];
+        Uint32 ui32_tmp = tile_data[i];
 
         tile.type = Ego::Math::clipBits<8>( ui32_tmp >> 24 );
         tile.fx   = Ego::Math::clipBits<8>( ui32_tmp >> 16 );
@@ -31,29 +31,29 @@ bool map_read_v3(vfs_FILE& file, map_t& map)
     // Alias.
     auto& mem = map._mem;
 
+    // The coordinates are stored component by component, read each component at once.
+    std::vector<float> ieee32_tmp(mem.vertices.size(), 0.0f);
+
     // Load the x-coordinate of each vertex.
-    for (auto& vertex : mem.vertices)
+    vfs_read_float_array(file, ieee32_tmp.data(), ieee32_tmp.size());
+    for (size_t i = 0; i < mem.vertices.size(); ++i)
     {
-        float ieee32_tmp;
-        vfs_read_float(file, &ieee32_tmp);
-        vertex.pos[kX] = ieee32_tmp;
+        mem.vertices[i].pos[kX] = ieee32_tmp[i];
     }
 
     // Load the y-coordinate of each vertex.
-    for (auto& vertex : mem.vertices)
+    vfs_read_float_array(file, ieee32_tmp.data(), ieee32_tmp.size());
+    for (size_t i = 0; i < mem.vertices.size(); ++i)
     {
-        float ieee32_tmp;
-        vfs_read_float(file, &ieee32_tmp);
-        vertex.pos[kY] = ieee32_tmp;
+        mem.vertices[i].pos[kY] = ieee32_tmp[i];
     }
 
     // Load the z-coordinate of each vertex.
-    for (auto& vertex : mem.vertices)
+    vfs_read_float_array(file, ieee32_tmp.data(), ieee32_tmp.size());
+    for (size_t i = 0; i < mem.vertices.size(); ++i)
     {
-        float ieee32_tmp;
-        vfs_read_float(file, &ieee32_tmp);
         // Cartman scales the z-axis based off of a 4 bit fixed precision number.
-        vertex.pos[kZ] = ieee32_tmp / 16.0f;
+        mem.vertices[i].pos[kZ] = ieee32_tmp[i] / 16.0f;
     }
 
     return true;
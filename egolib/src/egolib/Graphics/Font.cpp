@@ -24,9 +24,10 @@
 
 #include "egolib/Graphics/Font.hpp"
 
-#include "egolib/Time.hpp"
 #include "egolib/Core/StringUtilities.hpp"
 #include "egolib/Graphics/FontManager.hpp"
+#include "egolib/Graphics/VertexArena.hpp"
+#include "egolib/Image/ImageManager.hpp"
 #include "egolib/Renderer/Renderer.hpp"
 #include "egolib/Log/_Include.hpp"
 #include "egolib/vfs.h"
@@ -36,36 +37,78 @@
 
 namespace Ego
 {
-    struct Font::StringCacheData : Id::NonCopyable
+namespace
+{
+    /// Decode the next code point of an UTF-8 string. Malformed sequences decode to '?'.
+    uint32_t nextCodePoint(const std::string& text, size_t& i)
     {
-        Uint32 lastUseInTicks;
-        Ego::Texture *tex;
-        std::string text;
-        
-        StringCacheData() :
-            lastUseInTicks(0),
-            tex(new Ego::OpenGL::Texture())
+        const unsigned char c = static_cast<unsigned char>(text[i++]);
+        size_t length;
+        uint32_t codePoint;
+        if (c < 0x80)
         {
-            if (!tex)
-            {
-                throw std::runtime_error("unable to create texture");
-            }
+            return c;
         }
-        
-        ~StringCacheData()
+        else if ((c & 0xE0) == 0xC0)
+        {
+            length = 1; codePoint = c & 0x1F;
+        }
+        else if ((c & 0xF0) == 0xE0)
+        {
+            length = 2; codePoint = c & 0x0F;
+        }
+        else if ((c & 0xF8) == 0xF0)
+        {
+            length = 3; codePoint = c & 0x07;
+        }
+        else
         {
-            if (tex != nullptr)
+            return '?';
+        }
+        for (; length > 0; --length)
+        {
+            if (i >= text.size() || (static_cast<unsigned char>(text[i]) & 0xC0) != 0x80)
             {
-                delete tex;
-                tex = nullptr;
+                return '?';
             }
+            codePoint = (codePoint << 6) | (static_cast<unsigned char>(text[i++]) & 0x3F);
         }
-    };
-    
+        return codePoint;
+    }
+
+    /// Encode a code point of the basic multilingual plane as UTF-8.
+    std::string encodeCodePoint(uint32_t codePoint)
+    {
+        std::string text;
+        if (codePoint < 0x80)
+        {
+            text += static_cast<char>(codePoint);
+        }
+        else if (codePoint < 0x800)
+        {
+            text += static_cast<char>(0xC0 | (codePoint >> 6));
+            text += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else
+        {
+            text += static_cast<char>(0xE0 | (codePoint >> 12));
+            text += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            text += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        return text;
+    }
+}
+
     Font::Font(const std::string &fileName, int pointSize) :
     _ttfFont(nullptr),
-    _stringCache(),
-    _sortedCache()
+    _glyphs(),
+    _atlasImage(),
+    _atlasTexture(),
+    _atlasDirty(false),
+    _shelfX(0), _shelfY(0),
+    _shelfHeight(0),
+    _vertices(),
+    _batchDepth(0)
     {
         SDL_RWops *rwops = vfs_openRWopsRead(fileName.c_str());
         if (rwops == nullptr)
@@ -88,8 +131,23 @@ namespace Ego
     
     void Font::getTextSize(const std::string &text, int *width, int *height) const
     {
-        if (_ttfFont == nullptr) return;        
-        TTF_SizeUTF8(_ttfFont, text.c_str(), width, height);
+        if (_ttfFont == nullptr) return;
+
+        // Measure with the same advances drawText() moves the pen by.
+        if (width)
+        {
+            *width = 0;
+            for (size_t i = 0; i < text.size();)
+            {
+                const uint32_t codePoint = nextCodePoint(text, i);
+                if (codePoint < ' ') continue;
+                *width += getAdvance(codePoint);
+            }
+        }
+        if (height)
+        {
+            *height = TTF_FontHeight(_ttfFont);
+        }
     }
     
     void Font::getTextBoxSize(const std::string &text, int spacing, int *width, int *height) const
@@ -107,7 +165,7 @@ namespace Ego
             if (line == "\n") continue;
             int lineWidth = 0;
             int lineHeight = 0;
-            TTF_SizeUTF8(_ttfFont, line.c_str(), &lineWidth, &lineHeight);
+            getTextSize(line, &lineWidth, &lineHeight);
             *width = std::max(*width, lineWidth);
             *height += spacing;
         }
@@ -142,73 +200,212 @@ namespace Ego
         tex->setAddressModeT(Ego::TextureAddressMode::Clamp);
     }
     
+    int Font::getAdvance(uint32_t codePoint) const
+    {
+        int minX, maxX, minY, maxY, advance;
+        if (codePoint <= 0xFFFF && TTF_GlyphIsProvided(_ttfFont, static_cast<Uint16>(codePoint)) &&
+            0 == TTF_GlyphMetrics(_ttfFont, static_cast<Uint16>(codePoint), &minX, &maxX, &minY, &maxY, &advance))
+        {
+            return advance;
+        }
+        // Leave the space of a replacement character for a glyph the font does not have.
+        if (codePoint != '?' && 0 == TTF_GlyphMetrics(_ttfFont, '?', &minX, &maxX, &minY, &maxY, &advance))
+        {
+            return advance;
+        }
+        return 0;
+    }
+
+    const Font::Glyph *Font::getGlyph(uint32_t codePoint)
+    {
+        auto it = _glyphs.find(codePoint);
+        if (it != _glyphs.end())
+        {
+            return &(it->second);
+        }
+
+        // A glyph which can not be drawn is remembered without an image, so it is not tried again.
+        Glyph glyph;
+        glyph.x = glyph.y = 0;
+        glyph.width = glyph.height = 0;
+        glyph.advance = getAdvance(codePoint);
+        if (codePoint > 0xFFFF || !TTF_GlyphIsProvided(_ttfFont, static_cast<Uint16>(codePoint)))
+        {
+            return &(_glyphs[codePoint] = glyph);
+        }
+
+        // Render the glyph as a string of one character: Unlike a glyph rendered on its own,
+        // it is placed relative to the pen and the baseline like in any other string.
+        SDL_Color white;
+        white.r = white.g = white.b = white.a = 255;
+        SDL_Surface *glyphSurface = TTF_RenderUTF8_Blended(_ttfFont, encodeCodePoint(codePoint).c_str(), white);
+        if (!glyphSurface)
+        {
+            Log::get().warn("Got a null surface from SDL_TTF: %s", TTF_GetError());
+            return &(_glyphs[codePoint] = glyph);
+        }
+        std::shared_ptr<SDL_Surface> surface = std::shared_ptr<SDL_Surface>(glyphSurface, [ ](SDL_Surface *pSurface) { SDL_FreeSurface(pSurface); });
+        if (surface->w + GLYPH_PADDING > ATLAS_WIDTH)
+        {
+            return &(_glyphs[codePoint] = glyph);
+        }
+
+        // Find a place in the atlas, growing it or starting over if it is full.
+        if (_shelfX + surface->w + GLYPH_PADDING > ATLAS_WIDTH)
+        {
+            _shelfX = 0;
+            _shelfY += _shelfHeight;
+            _shelfHeight = 0;
+        }
+        const int height = _atlasImage ? _atlasImage->h : 0;
+        if (!_atlasImage || _shelfY + surface->h + GLYPH_PADDING > height)
+        {
+            int newHeight = std::max(height, 64);
+            while (newHeight < _shelfY + surface->h + GLYPH_PADDING && newHeight < ATLAS_MAX_HEIGHT)
+            {
+                newHeight *= 2;
+            }
+            std::shared_ptr<SDL_Surface> newImage;
+            if (_shelfY + surface->h + GLYPH_PADDING <= newHeight)
+            {
+                newImage = ImageManager::get().createImage(ATLAS_WIDTH, newHeight, PixelFormatDescriptor::get<PixelFormat::R8G8B8A8>());
+                if (!newImage)
+                {
+                    return nullptr;
+                }
+                if (_atlasImage)
+                {
+                    SDL_SetSurfaceBlendMode(_atlasImage.get(), SDL_BLENDMODE_NONE);
+                    SDL_BlitSurface(_atlasImage.get(), nullptr, newImage.get(), nullptr);
+                }
+            }
+            else
+            {
+                // The atlas is full. Draw what uses the old glyphs and start over.
+                flush();
+                _glyphs.clear();
+                _shelfX = _shelfY = _shelfHeight = 0;
+                newImage = ImageManager::get().createImage(ATLAS_WIDTH, 64, PixelFormatDescriptor::get<PixelFormat::R8G8B8A8>());
+                if (!newImage)
+                {
+                    return nullptr;
+                }
+            }
+            _atlasImage = newImage;
+        }
+
+        SDL_Rect target;
+        target.x = _shelfX; target.y = _shelfY;
+        target.w = surface->w; target.h = surface->h;
+        SDL_SetSurfaceBlendMode(surface.get(), SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(surface.get(), nullptr, _atlasImage.get(), &target);
+        _atlasDirty = true;
+
+        glyph.x = _shelfX; glyph.y = _shelfY;
+        glyph.width = surface->w; glyph.height = surface->h;
+        _shelfX += surface->w + GLYPH_PADDING;
+        _shelfHeight = std::max(_shelfHeight, surface->h + GLYPH_PADDING);
+
+        return &(_glyphs[codePoint] = glyph);
+    }
+
     void Font::drawText(const std::string &text, int x, int y, const Ego::Math::Colour4f &colour)
     {
         if (_ttfFont == nullptr || text.empty()) return;
-        StringCacheDataPtr cache;
-        bool updateTexture = true;
-        auto cacheIterator = _stringCache.find(text);
-        if (cacheIterator != _stringCache.end() && !cacheIterator->second.expired())
+
+        const float r = colour.getRed(), g = colour.getGreen(), b = colour.getBlue(), a = colour.getAlpha();
+        float penX = x;
+        for (size_t i = 0; i < text.size();)
+        {
+            const uint32_t codePoint = nextCodePoint(text, i);
+            if (codePoint < ' ') continue;
+            const Glyph *glyph = getGlyph(codePoint);
+            if (!glyph || 0 == glyph->width)
+            {
+                penX += glyph ? glyph->advance : getAdvance(codePoint);
+                continue;
+            }
+
+            const float x0 = penX, x1 = penX + glyph->width,
+                        y0 = y, y1 = y + glyph->height;
+            const float s0 = glyph->x, s1 = glyph->x + glyph->width,
+                        t0 = glyph->y, t1 = glyph->y + glyph->height;
+            _vertices.push_back({x0, y0, 0.0f, r, g, b, a, s0, t0});
+            _vertices.push_back({x1, y0, 0.0f, r, g, b, a, s1, t0});
+            _vertices.push_back({x1, y1, 0.0f, r, g, b, a, s1, t1});
+            _vertices.push_back({x0, y1, 0.0f, r, g, b, a, s0, t1});
+            penX += glyph->advance;
+        }
+
+        if (0 == _batchDepth)
         {
-            cache = cacheIterator->second.lock();
-            updateTexture = false;
+            flush();
         }
-        else if (_sortedCache.size() < 20)
+    }
+
+    void Font::beginBatch()
+    {
+        _batchDepth++;
+    }
+
+    void Font::endBatch()
+    {
+        if (_batchDepth > 0 && 0 == --_batchDepth)
         {
-            cache = std::make_shared<StringCacheData>();
-            _sortedCache.push_back(cache);
+            flush();
         }
-        else
+    }
+
+    void Font::flush()
+    {
+        if (_vertices.empty()) return;
+
+        if (!_atlasTexture)
         {
-            std::sort(_sortedCache.begin(), _sortedCache.end(), compareStringCacheData);
-            cache = _sortedCache.at(0);
-            _stringCache.erase(cache->text);
+            _atlasTexture = std::make_unique<Ego::OpenGL::Texture>();
         }
-        
-        if (updateTexture)
+        if (_atlasDirty)
         {
-            drawTextToTexture(cache->tex, text);
+            _atlasTexture->load("Font atlas", _atlasImage);
+            _atlasTexture->setAddressModeS(Ego::TextureAddressMode::Clamp);
+            _atlasTexture->setAddressModeT(Ego::TextureAddressMode::Clamp);
+            _atlasDirty = false;
+        }
+
+        auto vb = VertexArena::get().allocate(Ego::VertexFormatDescriptor::get<Ego::VertexFormat::P3FC4FT2F>(), _vertices.size());
+        {
+            // Convert the texture coordinates from pixels to the texture space.
+            const float sScale = 1.0f / _atlasTexture->getWidth(),
+                        tScale = 1.0f / _atlasTexture->getHeight();
+            Vertex *vertices = vb.get<Vertex>();
+            for (size_t i = 0; i < _vertices.size(); ++i)
+            {
+                vertices[i] = _vertices[i];
+                vertices[i].s *= sScale;
+                vertices[i].t *= tScale;
+            }
         }
 
-        float w = cache->tex->getSourceWidth();
-        float h = cache->tex->getSourceHeight();
-        float u = w / cache->tex->getWidth();
-        float v = h / cache->tex->getHeight();
-        
         auto& renderer = Renderer::get();
-        renderer.setColour(colour);
         renderer.setBlendingEnabled(true);
-		renderer.getTextureUnit().setActivated(cache->tex);
-		renderer.setBlendFunction(BlendFunction::SourceAlpha, BlendFunction::OneMinusSourceAlpha);
-		Ego::VertexBuffer vb(4, Ego::VertexFormatDescriptor::get<Ego::VertexFormat::P2FT2F>());
-		{
-			struct Vertex {
-				float x, y;
-				float s, t;
-			};
-			Ego::VertexBufferScopedLock vblck(vb);
-			Vertex *vertices = vblck.get<Vertex>();
-			vertices[0].x = x;     vertices[0].y = y;     vertices[0].s = 0.0f; vertices[0].t = 0.0f;
-			vertices[1].x = x + w; vertices[1].y = y;     vertices[1].s = u;    vertices[1].t = 0.0f;
-			vertices[2].x = x + w; vertices[2].y = y + h; vertices[2].s = u;    vertices[2].t = v;
-			vertices[3].x = x;     vertices[3].y = y + h; vertices[3].s = 0.0f; vertices[3].t = v;
-		}
-		renderer.render(vb, Ego::PrimitiveType::Quadriliterals, 0, 4);
-       
-        cache->lastUseInTicks = Time::now<Time::Unit::Ticks>();
-        cache->text = text;
-        _stringCache[text] = cache;
+        renderer.getTextureUnit().setActivated(_atlasTexture.get());
+        renderer.setBlendFunction(BlendFunction::SourceAlpha, BlendFunction::OneMinusSourceAlpha);
+        VertexArena::get().render(vb, Ego::PrimitiveType::Quadriliterals);
+
+        _vertices.clear();
     }
     
     void Font::drawTextBox(const std::string &text, int x, int y, int width, int height, int spacing, const Ego::Math::Colour4f &colour)
     {
         if (_ttfFont == nullptr) return;
+        beginBatch();
         for (const std::string &line : Ego::split(text, std::string("\n")))
         {
             if (line == "\n") continue;
             drawText(line, x, y, colour);
             y += spacing;
         }
+        endBatch();
     }
     
     int Font::getLineSpacing() const
@@ -217,13 +414,6 @@ namespace Ego
         return TTF_FontLineSkip(_ttfFont);
     }
     
-    bool Font::compareStringCacheData(const StringCacheDataPtr &a, const StringCacheDataPtr &b)
-    {
-        if (b == nullptr) return false;
-        if (a == nullptr) return true;
-        return a->lastUseInTicks < b->lastUseInTicks;
-    }
-
     int Font::getFontHeight() const
     {
         return TTF_FontHeight(_ttfFont);
@@ -104,6 +104,10 @@ namespace Ego
         /**
          * @brief
          *  Draw text that only has one line to the screen.
+         * @remark
+         *  The glyphs are taken from an atlas texture of this font, rendering a glyph only when it is
+         *  used the first time. Outside of a batch the text is drawn immediately, inside of a batch it
+         *  is drawn by endBatch().
          * @param text
          *  the text to draw
          * @param x
@@ -154,13 +158,61 @@ namespace Ego
         **/
         int getFontHeight() const;
 
+        /**
+         * @brief
+         *  Begin a batch. Text drawn with this font is collected until the matching endBatch() and is
+         *  then drawn with a single draw call. Batches may be nested.
+         * @remark
+         *  Anything drawn within the batch by other means ends up below the text of the batch.
+         */
+        void beginBatch();
+
+        /**
+         * @brief
+         *  End a batch. If this was the outermost batch, draw the text collected in it.
+         */
+        void endBatch();
+
     private:
-        struct StringCacheData;
-        typedef std::shared_ptr<StringCacheData> StringCacheDataPtr;
-        static bool compareStringCacheData(const StringCacheDataPtr &a, const StringCacheDataPtr &b);
-        
+        /// The width of the atlas texture, in pixels.
+        static const int ATLAS_WIDTH = 512;
+        /// The maximum height of the atlas texture, in pixels. If it is full, all glyphs are rendered again.
+        static const int ATLAS_MAX_HEIGHT = 2048;
+        /// The space between the glyphs in the atlas, in pixels.
+        static const int GLYPH_PADDING = 1;
+
+        /// A glyph in the atlas.
+        struct Glyph
+        {
+            int x, y;           ///< The position of the glyph in the atlas, in pixels
+            int width, height;  ///< The size of the glyph, in pixels
+            int advance;        ///< The horizontal distance to the next glyph, in pixels
+        };
+
+        /// A vertex of a batch. The texture coordinates are in pixels until the batch is drawn.
+        struct Vertex
+        {
+            float x, y, z;
+            float r, g, b, a;
+            float s, t;
+        };
+
+        /// Get the horizontal distance the pen moves by for a glyph, in pixels.
+        int getAdvance(uint32_t codePoint) const;
+        /// Get a glyph, adding it to the atlas if necessary. A glyph which can not be drawn has a width of 0.
+        /// Returns @a nullptr if the atlas could not be allocated.
+        const Glyph *getGlyph(uint32_t codePoint);
+        /// Draw the collected text.
+        void flush();
+
         TTF_Font *_ttfFont;
-        std::unordered_map<std::string, std::weak_ptr<StringCacheData>> _stringCache;
-        std::vector<StringCacheDataPtr> _sortedCache;
+        std::unordered_map<uint32_t, Glyph> _glyphs;
+        std::shared_ptr<SDL_Surface> _atlasImage;
+        std::unique_ptr<Ego::Texture> _atlasTexture;
+        bool _atlasDirty;               ///< Must the atlas image be uploaded to the atlas texture?
+        int _shelfX, _shelfY;           ///< Where the next glyph is placed in the atlas
+        int _shelfHeight;               ///< The height of the current row of glyphs in the atlas
+        std::vector<Vertex> _vertices;  ///< The vertices of the current batch
+        int _batchDepth;
     };
 }
@@ -33,6 +33,7 @@ static const float MD2_NORMALS[EGO_NORMAL_COUNT][3] =
 
 MD2Model::MD2Model() :
 	_vertices(0),
+	_equallyLit(false),
 	_skins(),
 	_texCoords(),
 	_triangles(),
@@ -47,33 +48,30 @@ float MD2Model::getMD2Normal(size_t normal, size_t index)
 	return MD2_NORMALS[normal][index];
 }
 
+const MD2_Normal *MD2Model::getMD2Normals()
+{
+	return MD2_NORMALS;
+}
+
 void MD2Model::scaleModel(const float scaleX, const float scaleY, const float scaleZ)
 {
     for(MD2_Frame &frame : _frames)
     {
-        bool boundingBoxFound = false;
-
-        for(MD2_Vertex& vertex : frame.vertexList)
+        // The coordinates stay as they are, scale their mapping to positions instead.
+        frame.scale[kX] *= scaleX;
+        frame.scale[kY] *= scaleY;
+        frame.scale[kZ] *= scaleZ;
+        frame.translate[kX] *= scaleX;
+        frame.translate[kY] *= scaleY;
+        frame.translate[kZ] *= scaleZ;
+
+        // Re-calculate the bounding box for this frame
+        for (size_t vertex = 0; vertex < frame.vertexX.size(); ++vertex)
         {
-            oct_vec_v2_t opos;
-
-            vertex.pos[kX] *= scaleX;
-            vertex.pos[kY] *= scaleY;
-            vertex.pos[kZ] *= scaleZ;
-
-            std::copysign(vertex.nrm[kX], scaleX);
-            std::copysign(vertex.nrm[kY], scaleY);
-            std::copysign(vertex.nrm[kZ], scaleZ);
-
-			vertex.nrm.normalize();
-
-            opos = oct_vec_v2_t(vertex.pos);
-
-            // Re-calculate the bounding box for this frame
-            if (!boundingBoxFound)
+            oct_vec_v2_t opos = oct_vec_v2_t(frame.getVertexPosition(vertex));
+            if (0 == vertex)
             {
 				frame.bb = oct_bb_t(opos);
-                boundingBoxFound = true;
             }
             else
             {
@@ -102,13 +100,7 @@ void MD2Model::scaleModel(const float scaleX, const float scaleY, const float sc
 
 void MD2Model::makeEquallyLit()
 {
-	for(MD2_Frame &frame : _frames)
-	{
-	    for(MD2_Vertex &vertex : frame.vertexList)
-	    {
-	        vertex.normal = EGO_NORMAL_COUNT-1;
-	    }
-	}
+	_equallyLit = true;
 }
 
 std::shared_ptr<MD2Model> MD2Model::loadFromFile(const std::string &fileName)
@@ -168,7 +160,10 @@ std::shared_ptr<MD2Model> MD2Model::loadFromFile(const std::string &fileName)
 
     for(MD2_Frame &frame : model->_frames)
     {
-    	frame.vertexList.resize(md2Header.num_vertices);
+    	frame.vertexX.resize(md2Header.num_vertices);
+    	frame.vertexY.resize(md2Header.num_vertices);
+    	frame.vertexZ.resize(md2Header.num_vertices);
+    	frame.vertexNormal.resize(md2Header.num_vertices);
     }
 
     // Load the texture coordinates from the file, normalizing them as we go
@@ -225,38 +220,30 @@ std::shared_ptr<MD2Model> MD2Model::loadFromFile(const std::string &fileName)
         frame_header.translate[2] = ENDIAN_TO_SYS_IEEE32( frame_header.translate[2] );
 #endif
 
+        frame.scale = Vector3f(frame_header.scale[0], frame_header.scale[1], frame_header.scale[2]);
+        frame.translate = Vector3f(frame_header.translate[0], frame_header.translate[1], frame_header.translate[2]);
+
         // unpack the md2 vertex_lst from this frame
-        bool boundingBoxFound = false;
-        for(MD2_Vertex &vertex : frame.vertexList)
+        for (size_t vertex = 0; vertex < frame.vertexX.size(); ++vertex)
         {
-            oct_vec_v2_t ovec;
             id_md2_vertex_t frame_vert;
 
             // read vertex_lst one-by-one. I hope this is not endian dependent, but I have no way to check it.
             vfs_read(&frame_vert, sizeof( id_md2_vertex_t ), 1, f);
 
-            // grab the vertex position
-            vertex.pos[kX] = frame_vert.v[0] * frame_header.scale[0] + frame_header.translate[0];
-            vertex.pos[kY] = frame_vert.v[1] * frame_header.scale[1] + frame_header.translate[1];
-            vertex.pos[kZ] = frame_vert.v[2] * frame_header.scale[2] + frame_header.translate[2];
+            // keep the packed vertex position
+            frame.vertexX[vertex] = frame_vert.v[0];
+            frame.vertexY[vertex] = frame_vert.v[1];
+            frame.vertexZ[vertex] = frame_vert.v[2];
 
             // grab the normal index
-            vertex.normal = frame_vert.normalIndex;
-            if (vertex.normal > MD2_MAX_NORMALS) {
-            	vertex.normal = MD2_MAX_NORMALS;
-            }
-
-            // expand the normal index into an actual normal
-            vertex.nrm[kX] = MD2_NORMALS[frame_vert.normalIndex][0];
-            vertex.nrm[kY] = MD2_NORMALS[frame_vert.normalIndex][1];
-            vertex.nrm[kZ] = MD2_NORMALS[frame_vert.normalIndex][2];
+            frame.vertexNormal[vertex] = std::min<uint8_t>(frame_vert.normalIndex, MD2_MAX_NORMALS);
 
             // Calculate the bounding box for this frame
-            ovec = oct_vec_v2_t(vertex.pos);
-            if (!boundingBoxFound)
+            oct_vec_v2_t ovec = oct_vec_v2_t(frame.getVertexPosition(vertex));
+            if (0 == vertex)
             {
                 frame.bb = oct_bb_t(ovec);
-                boundingBoxFound = true;
             }
             else
             {
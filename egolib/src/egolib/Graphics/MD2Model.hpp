@@ -29,21 +29,8 @@ static constexpr size_t EGO_NORMAL_COUNT = MD2_MAX_NORMALS + 1;
 typedef id_md2_skin_t MD2_SkinName;
 typedef id_md2_triangle_t MD2_Triangle;
 
-class MD2_Vertex
-{
-public:
-	MD2_Vertex() :
-		pos(0.0f, 0.0f, 0.0f),
-		nrm(0.0f, 0.0f, 0.0f),
-		normal(0)
-	{
-		//ctor
-	}
-
-	Vector3f pos;
-	Vector3f nrm;
-    size_t   normal;  ///< index to id-normal array
-};
+/// An id normal, see MD2Model::getMD2Normals().
+typedef float MD2_Normal[3];
 
 class MD2_TexCoord
 {
@@ -73,6 +60,14 @@ public:
     std::vector<id_glcmd_packed_t> 	data;
 };
 
+/**
+ * @brief
+ *  A frame of an MD2 model.
+ *
+ *  The vertices are kept as in the MD2 file: 8-bit coordinates, which are mapped to positions by the
+ *  scale and the translation of the frame, and an index into the id normals. They are stored as
+ *  separate arrays per component, so the vertices can be interpolated several at a time.
+ */
 class MD2_Frame
 {
 public:
@@ -80,7 +75,12 @@ public:
 #if 0
 		name(),
 #endif
-		vertexList(),
+		scale(1.0f, 1.0f, 1.0f),
+		translate(0.0f, 0.0f, 0.0f),
+		vertexX(),
+		vertexY(),
+		vertexZ(),
+		vertexNormal(),
 		bb(),
 		framelip(0),
 		framefx(EMPTY_BIT_FIELD)
@@ -90,11 +90,27 @@ public:
 
     char name[16];
 
-    std::vector<MD2_Vertex> vertexList;
+    Vector3f scale;                     ///< the scale of the vertex coordinates
+    Vector3f translate;                 ///< the translation of the vertex coordinates
+    std::vector<uint8_t> vertexX;       ///< the x-coordinate of each vertex
+    std::vector<uint8_t> vertexY;       ///< the y-coordinate of each vertex
+    std::vector<uint8_t> vertexZ;       ///< the z-coordinate of each vertex
+    std::vector<uint8_t> vertexNormal;  ///< the index to the id normals of each vertex
 
     oct_bb_t bb;        ///< axis-aligned octagonal bounding box limits
     int framelip;       ///< the position in the current animation
     BIT_FIELD framefx;  ///< the special effects associated with this frame
+
+    /**
+     * @brief
+     *  Get the position of a vertex.
+     */
+    Vector3f getVertexPosition(size_t vertex) const
+    {
+        return Vector3f(vertexX[vertex] * scale[kX] + translate[kX],
+                        vertexY[vertex] * scale[kY] + translate[kY],
+                        vertexZ[vertex] * scale[kZ] + translate[kZ]);
+    }
 };
 
 class MD2Model
@@ -107,6 +123,10 @@ public:
 	inline const std::vector<MD2_Triangle>&  	   getTriangles() const {return _triangles;}
 	inline const std::forward_list<MD2_GLCommand>& getGLCommands() const {return _commands;}
 	inline size_t 								   getVertexCount() const {return _vertices;}
+	/**
+	* @return @a true if the model ignores the normals for environment mapping, see makeEquallyLit()
+	**/
+	inline bool 								   isEquallyLit() const {return _equallyLit;}
 
 	/**
     * @author BB
@@ -115,7 +135,8 @@ public:
 	void scaleModel(const float scaleX, const float scaleY, const float scaleZ);
 
 	/**
-	*
+	* @brief
+	*   Use the "equal light" normal for the environment mapping of all vertices.
 	**/
 	void makeEquallyLit();
 
@@ -128,8 +149,14 @@ public:
 
 	static float getMD2Normal(size_t normal, size_t index);
 
+	/**
+	* @return the id normals, followed by the "equal light" normal
+	**/
+	static const MD2_Normal *getMD2Normals();
+
 private:
 	size_t 					   	     _vertices;
+	bool 							 _equallyLit;
     std::vector<MD2_SkinName>  	     _skins;
     std::vector<MD2_TexCoord>  	     _texCoords;
     std::vector<MD2_Triangle>  	     _triangles;
@@ -22,29 +22,44 @@
 
 #include "egolib/_math.h"
 #include "egolib/fileutil.h"
+#include "egolib/egoboo_setup.h"
 #include "egolib/Graphics/TextureManager.hpp"
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
 TextureManager::TextureManager() :
+    _unload(),
+    _textureCache(),
+    _decodeThreads(nullptr),
     _deferredLoadingMutex(),
-    _requestedLoadDeferredTextures(),
-    _notifyDeferredLoadingComplete()
+    _requests()
 {
-    Ego::OpenGL::initializeErrorTextures();
+    if (Ego::RendererFactory::getBackend() == Ego::RendererFactory::Backend::OpenGL) {
+        Ego::OpenGL::initializeErrorTextures();
+    }
+
+    // Leave the OpenGL context thread its own hardware thread.
+    const size_t hardwareThreads = std::thread::hardware_concurrency();
+    _decodeThreads = std::unique_ptr<ThreadPool>(new ThreadPool(hardwareThreads > 1 ? hardwareThreads - 1 : 1));
 }
 
 TextureManager::~TextureManager()
 {
+    // Finish the images still being decoded before anything goes away.
+    _decodeThreads.reset();
+    _requests.clear();
     _textureCache.clear();
 	_unload.clear();
-    Ego::OpenGL::uninitializeErrorTextures();
+    if (Ego::RendererFactory::getBackend() == Ego::RendererFactory::Backend::OpenGL) {
+        Ego::OpenGL::uninitializeErrorTextures();
+    }
 }
 
 void TextureManager::release_all()
 {
-	if (SDL_GL_GetCurrentContext() != nullptr) {
+    std::lock_guard<std::mutex> lock(_deferredLoadingMutex);
+	if (canUpload()) {
 		// We are the main OpenGL context thread so we can destroy textures.
 		_textureCache.clear();
 		_unload.clear();
@@ -63,52 +78,129 @@ void TextureManager::reupload()
     // TODO
 }
 
-void TextureManager::updateDeferredLoading()
+void TextureManager::upload(TextureRequest& request)
 {
-    //If nothing to do, exit function immeadiately
-    if(_requestedLoadDeferredTextures.empty()) return;
+    const TextureRequest::Image image = request.image.get();
 
-    //Load each texture that is required by another thread
+    std::shared_ptr<Ego::Texture> loadTexture = Ego::Renderer::get().createTexture();
+    if (!image.surface || !loadTexture->load(image.fileName, image.surface, TRANSCOLOR)) {
+        // Let the synchronous loader try the other formats and report the failure.
+        ego_texture_load_vfs(loadTexture.get(), request.filePath.c_str(), TRANSCOLOR);
+    }
     {
         std::lock_guard<std::mutex> lock(_deferredLoadingMutex);
-        for(const std::string &filePath : _requestedLoadDeferredTextures) {
-            std::shared_ptr<Ego::Texture> loadTexture = std::make_shared<Ego::OpenGL::Texture>();
-            ego_texture_load_vfs(loadTexture.get(), filePath.c_str(), TRANSCOLOR);
-            _textureCache[filePath] = loadTexture;
-			Log::get().debug("Deferred texture load: %s\n", filePath.c_str());
-        }
-        _requestedLoadDeferredTextures.clear();
+        _textureCache[request.filePath] = loadTexture;
     }
+    request.promise.set_value(loadTexture);
+	Log::get().debug("Deferred texture load: %s\n", request.filePath.c_str());
+}
 
-    //Notify all waiting threads that loading is complete
-    _notifyDeferredLoadingComplete.notify_all();  
+bool TextureManager::canUpload()
+{
+    return SDL_GL_GetCurrentContext() != nullptr
+        || Ego::RendererFactory::getBackend() != Ego::RendererFactory::Backend::OpenGL;
 }
 
-const std::shared_ptr<Ego::Texture>& TextureManager::getTexture(const std::string &filePath)
+void TextureManager::updateDeferredLoading()
 {
-    //Not loaded yet?
+    const auto budget = std::chrono::milliseconds(egoboo_config_t::get().graphic_textureUpload_budget.getValue());
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    do {
+        //Take the first request whose image is decoded
+        std::shared_ptr<TextureRequest> request;
+        {
+            std::lock_guard<std::mutex> lock(_deferredLoadingMutex);
+            auto it = std::find_if(_requests.begin(), _requests.end(), [](const std::shared_ptr<TextureRequest>& x) {
+                return x->image.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            });
+            //If nothing to do, exit function immeadiately
+            if (it == _requests.end()) return;
+            request = *it;
+            _requests.erase(it);
+        }
+
+        upload(*request);
+    } while (std::chrono::high_resolution_clock::now() - start < budget);
+}
+
+std::shared_future<std::shared_ptr<Ego::Texture>> TextureManager::requestTexture(const std::string &filePath)
+{
+    std::lock_guard<std::mutex> lock(_deferredLoadingMutex);
+
+    //Already loaded?
     auto result = _textureCache.find(filePath);
-    if(result == _textureCache.end()) {
+    if (result != _textureCache.end()) {
+        std::promise<std::shared_ptr<Ego::Texture>> promise;
+        promise.set_value(result->second);
+        return promise.get_future().share();
+    }
 
-        if(SDL_GL_GetCurrentContext() != nullptr) {
-            //We are the main OpenGL context thread so we can load textures
-            std::shared_ptr<Ego::Texture> loadTexture = std::make_shared<Ego::OpenGL::Texture>();
-            ego_texture_load_vfs(loadTexture.get(), filePath.c_str(), TRANSCOLOR);
-            _textureCache[filePath] = loadTexture;
+    //Already requested?
+    for (const std::shared_ptr<TextureRequest>& request : _requests) {
+        if (request->filePath == filePath) {
+            return request->texture;
         }
-        else {
-            //We cannot load textures, wait blocking for main thread to load it for us
-            std::unique_lock<std::mutex> lock(_deferredLoadingMutex);
-            _requestedLoadDeferredTextures.push_front(filePath);
+    }
+
+    //Decode the image in the background
+    std::shared_ptr<TextureRequest> request = std::make_shared<TextureRequest>();
+    request->filePath = filePath;
+    request->texture = request->promise.get_future().share();
+    request->image = _decodeThreads->submit([filePath]() {
+        TextureRequest::Image image;
+        image.surface = ego_texture_decode_vfs(filePath, image.fileName);
+        return image;
+    });
+    _requests.push_back(request);
+    return request->texture;
+}
+
+const std::shared_ptr<Ego::Texture>& TextureManager::getTexture(const std::string &filePath)
+{
+    if (!canUpload()) {
+        //We cannot upload textures, wait for main thread to upload it for us
+        std::shared_future<std::shared_ptr<Ego::Texture>> texture = requestTexture(filePath);
+        if (texture.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
 			Log::get().debug("Wait for deferred texture: %s\n", filePath.c_str());
-            _notifyDeferredLoadingComplete.wait(lock, [this]{return _requestedLoadDeferredTextures.empty();});
+            texture.wait();
         }
-
+        std::lock_guard<std::mutex> lock(_deferredLoadingMutex);
         return _textureCache[filePath];
     }
 
-    //Get cached texture
+    //We are the main OpenGL context thread so we can load textures
+    std::shared_ptr<TextureRequest> request;
+    {
+        std::lock_guard<std::mutex> lock(_deferredLoadingMutex);
+
+        //Get cached texture
+        auto result = _textureCache.find(filePath);
+        if (result != _textureCache.end()) {
+            return result->second;
+        }
+
+        //Is it being decoded in the background?
+        auto it = std::find_if(_requests.begin(), _requests.end(), [&filePath](const std::shared_ptr<TextureRequest>& x) {
+            return x->filePath == filePath;
+        });
+        if (it != _requests.end()) {
+            request = *it;
+            _requests.erase(it);
+        }
+    }
+
+    if (request) {
+        //Do not wait for the next update, finish it now
+        upload(*request);
+    }
     else {
-        return (*result).second;
+        std::shared_ptr<Ego::Texture> loadTexture = Ego::Renderer::get().createTexture();
+        ego_texture_load_vfs(loadTexture.get(), filePath.c_str(), TRANSCOLOR);
+        std::lock_guard<std::mutex> lock(_deferredLoadingMutex);
+        _textureCache[filePath] = loadTexture;
     }
+
+    std::lock_guard<std::mutex> lock(_deferredLoadingMutex);
+    return _textureCache[filePath];
 }
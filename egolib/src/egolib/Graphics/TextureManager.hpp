@@ -24,6 +24,7 @@
 
 #include "egolib/typedef.h"
 #include "egolib/Renderer/Renderer.hpp"
+#include "egolib/Core/ThreadPool.hpp"
 
 //--------------------------------------------------------------------------------------------
 
@@ -69,7 +70,7 @@ public:
      * @brief
      *  Request a texture from the TextureHandler. If required, this function will load the texture
      *  first. This method is thread safe, if used by another thread that is not the OpenGL context
-     *  thread, then it will block until the OpenGL context thread can load the texture for us.
+     *  thread, then it will block until the OpenGL context thread has uploaded the texture for us.
      *  If the texture has already been loaded (even by other threads), that texture will be cached
      *  and this function will return it immediately.
      * @param filePath
@@ -80,13 +81,63 @@ public:
      */
     const std::shared_ptr<Ego::Texture>& getTexture(const std::string &filePath);
 
+    /**
+     * @brief
+     *  Request a texture without waiting for it. The image is decoded by a worker thread and
+     *  uploaded by the OpenGL context thread in updateDeferredLoading(). This method is thread safe.
+     * @param filePath
+     *  File path of the texture to load
+     * @return
+     *  A future which becomes ready once the texture is uploaded. Its texture could be the error
+     *  texture if the specified path cannot be found.
+     */
+    std::shared_future<std::shared_ptr<Ego::Texture>> requestTexture(const std::string &filePath);
+
+    /**
+     * @brief
+     *  Upload the textures which were decoded in the background, in the order they were requested.
+     *  Uploads at least one texture, then stops once the upload budget of the frame is spent.
+     * @remark
+     *  Must be called by the OpenGL context thread.
+     */
     void updateDeferredLoading();
 
+private:
+    /// A texture which is decoded in the background and waits for its upload.
+    struct TextureRequest
+    {
+        /// The image decoded by a worker thread.
+        struct Image
+        {
+            std::string fileName;                   ///< File name of the image including the extension
+            std::shared_ptr<SDL_Surface> surface;   ///< The image or @a nullptr if decoding failed
+        };
+
+        std::string filePath;
+        std::future<Image> image;
+        std::promise<std::shared_ptr<Ego::Texture>> promise;
+        std::shared_future<std::shared_ptr<Ego::Texture>> texture;
+    };
+
+    /**
+     * @brief
+     *  Wait for the image of a request, upload it and put the texture into the cache.
+     */
+    void upload(TextureRequest& request);
+
+    /**
+     * @brief
+     *  Get if the calling thread can create textures.
+     * @return
+     *  @a true if the calling thread is the OpenGL context thread or if the renderer needs no OpenGL context
+     */
+    static bool canUpload();
+
 private:
 	std::forward_list<std::shared_ptr<Ego::Texture>> _unload;
     std::unordered_map<std::string, std::shared_ptr<Ego::Texture>> _textureCache;
 
-    std::mutex _deferredLoadingMutex;
-    std::forward_list<std::string> _requestedLoadDeferredTextures;
-    std::condition_variable _notifyDeferredLoadingComplete;
+    std::unique_ptr<ThreadPool> _decodeThreads;      ///< Worker threads decoding the requested images
+    std::mutex _deferredLoadingMutex;                           ///< Guards the texture cache and the requests
+    std::list<std::shared_ptr<TextureRequest>> _requests;       ///< Requests waiting for their upload in order of request
 };
@@ -0,0 +1,115 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Graphics/VertexArena.cpp
+/// @brief  Frame-scoped allocation of transient vertices.
+
+#include "egolib/Graphics/VertexArena.hpp"
+#include "egolib/Renderer/Renderer.hpp"
+
+namespace Ego
+{
+
+VertexArena::VertexArena() :
+    _pools()
+{}
+
+VertexArena::~VertexArena()
+{
+    for (auto& entry : _pools)
+    {
+        clearBuffers(entry.second);
+    }
+}
+
+void VertexArena::addBuffer(Pool& pool, size_t capacity, const VertexFormatDescriptor& vertexFormatDescriptor)
+{
+    pool.buffers.push_back(std::make_unique<VertexBuffer>(capacity, vertexFormatDescriptor));
+    pool.vertices = static_cast<char *>(pool.buffers.back()->lock());
+    pool.used = 0;
+}
+
+void VertexArena::clearBuffers(Pool& pool)
+{
+    for (const auto& buffer : pool.buffers)
+    {
+        buffer->unlock();
+    }
+    pool.buffers.clear();
+    pool.vertices = nullptr;
+    pool.used = 0;
+}
+
+VertexArena::Allocation VertexArena::allocate(const VertexFormatDescriptor& vertexFormatDescriptor, size_t count)
+{
+    Pool& pool = _pools[vertexFormatDescriptor.getVertexFormat()];
+    if (pool.buffers.empty() || pool.used + count > pool.buffers.back()->getNumberOfVertices())
+    {
+        const size_t capacity = std::max(count, pool.buffers.empty() ? INITIAL_CAPACITY : 2 * pool.buffers.back()->getNumberOfVertices());
+        addBuffer(pool, capacity, vertexFormatDescriptor);
+    }
+    Allocation allocation;
+    allocation.buffer = pool.buffers.back().get();
+    allocation.index = pool.used;
+    allocation.count = count;
+    allocation.vertices = pool.vertices + pool.used * vertexFormatDescriptor.getVertexSize();
+    pool.used += count;
+    pool.total += count;
+    return allocation;
+}
+
+void VertexArena::render(const Allocation& allocation, PrimitiveType primitiveType)
+{
+    Renderer::get().render(*allocation.buffer, primitiveType, allocation.index, allocation.count);
+}
+
+void VertexArena::reset()
+{
+    for (auto& entry : _pools)
+    {
+        Pool& pool = entry.second;
+        if (pool.buffers.empty())
+        {
+            continue;
+        }
+        const size_t capacity = pool.buffers.back()->getNumberOfVertices();
+        size_t newCapacity = capacity;
+        if (pool.buffers.size() > 1)
+        {
+            // Replace the buffers of the last frame by one buffer holding all of their vertices.
+            newCapacity = std::min(pool.total, MAX_CAPACITY);
+        }
+        else if (pool.total < capacity / 4)
+        {
+            // Shrink a buffer which was mostly unused.
+            newCapacity = capacity / 2;
+        }
+        newCapacity = std::max(newCapacity, INITIAL_CAPACITY);
+        if (pool.buffers.size() > 1 || newCapacity != capacity)
+        {
+            const VertexFormatDescriptor vertexFormatDescriptor = pool.buffers.back()->getVertexFormatDescriptor();
+            clearBuffers(pool);
+            addBuffer(pool, newCapacity, vertexFormatDescriptor);
+        }
+        pool.used = 0;
+        pool.total = 0;
+    }
+}
+
+} // namespace Ego
@@ -0,0 +1,131 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Graphics/VertexArena.hpp
+/// @brief  Frame-scoped allocation of transient vertices.
+
+#pragma once
+
+#include "egolib/platform.h"
+#include "egolib/Graphics/VertexBuffer.hpp"
+#include "egolib/Renderer/PrimitiveType.hpp"
+
+namespace Ego
+{
+
+/**
+ * @brief
+ *  A linear allocator for vertices which are filled, drawn and forgotten within a frame.
+ *
+ *  Vertices of the same format are allocated one after another from a single vertex buffer
+ *  per format, and all allocations are released at once by reset() at the beginning of the
+ *  next frame. If a buffer runs full, another one is added for the rest of the frame; reset()
+ *  then replaces them by a single buffer large enough for the vertices of that frame (up to
+ *  MAX_CAPACITY vertices), so after a few frames no more memory is allocated at all. A buffer
+ *  which stays mostly unused is shrunk again.
+ *
+ *  The arena keeps its vertex buffers locked as long as it owns them.
+ */
+class VertexArena : public Core::Singleton<VertexArena>
+{
+public:
+    /**
+     * @brief
+     *  A range of vertices allocated from the arena.
+     * @remark
+     *  An allocation is valid until the next reset().
+     */
+    struct Allocation
+    {
+        VertexBuffer *buffer;   ///< The vertex buffer of the vertices
+        size_t index;           ///< The index of the first vertex in the vertex buffer
+        size_t count;           ///< The number of vertices
+        void *vertices;         ///< A pointer to the first vertex in the locked vertex buffer
+
+        /// @brief Get a pointer to the first vertex.
+        template <typename VertexType>
+        VertexType *get() const
+        {
+            return static_cast<VertexType *>(vertices);
+        }
+    };
+
+    /**
+     * @brief
+     *  Allocate vertices.
+     * @param vertexFormatDescriptor
+     *  the vertex format descriptor of the vertices
+     * @param count
+     *  the number of vertices
+     * @return
+     *  the allocation
+     */
+    Allocation allocate(const VertexFormatDescriptor& vertexFormatDescriptor, size_t count);
+
+    /**
+     * @brief
+     *  Render the vertices of an allocation.
+     * @param allocation
+     *  the allocation
+     * @param primitiveType
+     *  the primitive type
+     */
+    void render(const Allocation& allocation, PrimitiveType primitiveType);
+
+    /**
+     * @brief
+     *  Release all allocations.
+     * @remark
+     *  Call once per frame.
+     */
+    void reset();
+
+protected:
+    // Befriend with singleton to grant access to VertexArena::VertexArena and VertexArena::~VertexArena.
+    using TheSingleton = Core::Singleton<VertexArena>;
+    friend TheSingleton;
+
+    VertexArena();
+    virtual ~VertexArena();
+
+private:
+    /// The vertex buffers of a vertex format.
+    struct Pool
+    {
+        std::vector<std::unique_ptr<VertexBuffer>> buffers; ///< The buffers, allocations are taken from the last one
+        char *vertices;                                     ///< The vertices of the last buffer
+        size_t used;                                        ///< The number of vertices used in the last buffer
+        size_t total;                                       ///< The number of vertices allocated since the last reset()
+    };
+    std::map<VertexFormat, Pool> _pools;
+
+    /// Add a buffer of the specified capacity to a pool and lock it.
+    static void addBuffer(Pool& pool, size_t capacity, const VertexFormatDescriptor& vertexFormatDescriptor);
+
+    /// Unlock and remove all buffers of a pool.
+    static void clearBuffers(Pool& pool);
+
+    /// The initial number of vertices of a buffer.
+    static const size_t INITIAL_CAPACITY = 1024;
+
+    /// The maximum number of vertices of a buffer kept across frames.
+    static const size_t MAX_CAPACITY = 65536;
+};
+
+} // namespace Ego
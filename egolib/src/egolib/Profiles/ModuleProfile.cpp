@@ -31,6 +31,7 @@
 #include "egolib/vfs.h"
 #include "egolib/strutil.h"
 #include "egolib/fileutil.h"
+#include "egolib/Renderer/Renderer.hpp"
 #include "egolib/platform.h"
 
 const uint8_t ModuleProfile::RESPAWN_ANYTIME;
@@ -51,15 +52,14 @@ ModuleProfile::ModuleProfile() :
     _unlockQuestLevel(QUEST_NONE),
     _moduleType(FILTER_SIDE_QUEST),
     _beaten(false),
-    _icon(new Ego::OpenGL::Texture()),
+    _icon(Ego::Renderer::get().createTexture()),
     _vfsPath(_name),
     _folderName(_name)
 {}
 
 ModuleProfile::~ModuleProfile()
 {
-    delete _icon;
-    _icon = nullptr;
+    //dtor
 }
 
 bool ModuleProfile::isModuleUnlocked() const
@@ -204,7 +204,7 @@ std::shared_ptr<ModuleProfile> ModuleProfile::loadFromFile(const std::string &fo
 
     /// @note just because we can't load the title image DOES NOT mean that we ignore the module
     // load title image
-    ego_texture_load_vfs(result->_icon, (folderPath + "/gamedat/title").c_str());
+    ego_texture_load_vfs(result->_icon.get(), (folderPath + "/gamedat/title").c_str());
 
     /// @note This is kinda a cheat since we know that the virtual paths all begin with "mp_" at the moment.
     // If that changes, this line must be changed as well.
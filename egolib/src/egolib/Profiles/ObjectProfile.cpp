@@ -234,7 +234,19 @@ uint32_t ObjectProfile::getXPNeededForLevel(uint8_t level) const
     return _experienceForLevel[level];
 }
 
-void ObjectProfile::loadTextures(const std::string &folderPath)
+/// Is there an image of the specified name (without extension) in a list of file names?
+static bool hasImage(const std::unordered_set<std::string> &files, const std::string &name)
+{
+    for (const auto& loader : ImageManager::get())
+    {
+        if (files.count(name + loader.getExtension()) > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ObjectProfile::loadTextures(const std::string &folderPath, const std::unordered_set<std::string> &files)
 {
     //Clear texture references
     _texturesLoaded.clear();
@@ -244,17 +256,21 @@ void ObjectProfile::loadTextures(const std::string &folderPath)
     for (int cnt = 0; cnt < SKINS_PEROBJECT_MAX*2; cnt++)
     {
         // do the texture
-        const std::string skinPath = folderPath + "/tris" + std::to_string(cnt);
-        if(ego_texture_exists_vfs(skinPath))
+        const std::string skinName = "tris" + std::to_string(cnt);
+        if(hasImage(files, skinName))
         {
+            const std::string skinPath = folderPath + "/" + skinName;
             _texturesLoaded[cnt] = Ego::DeferredTexture(skinPath);
+
+            // start decoding the skin in the background, it is needed as soon as the object spawns
+            TextureManager::get().requestTexture(skinPath);
         }
 
         // do the icon
-        const std::string iconPath = folderPath + "/icon" + std::to_string(cnt);
-	    if(ego_texture_exists_vfs(iconPath))
+        const std::string iconName = "icon" + std::to_string(cnt);
+	    if(hasImage(files, iconName))
         {
-            _iconsLoaded[cnt] = Ego::DeferredTexture(iconPath);
+            _iconsLoaded[cnt] = Ego::DeferredTexture(folderPath + "/" + iconName);
         }
     }
 
@@ -972,6 +988,17 @@ bool ObjectProfile::hasIDSZ(IDSZ idsz) const
 }
 
 std::shared_ptr<ObjectProfile> ObjectProfile::loadFromFile(const std::string &folderPath, const PRO_REF slotNumber, const bool lightWeight)
+{
+    SharedProfiles shared;
+    std::shared_ptr<ObjectProfile> profile = readFromFile(folderPath, slotNumber, shared, lightWeight);
+    if (profile && !lightWeight)
+    {
+        profile->storeSharedProfiles(shared);
+    }
+    return profile;
+}
+
+std::shared_ptr<ObjectProfile> ObjectProfile::readFromFile(const std::string &folderPath, const PRO_REF slotNumber, SharedProfiles &shared, const bool lightWeight)
 {
     //Make sure slot number is valid
     if(slotNumber == INVALID_PRO_REF)
@@ -987,6 +1014,9 @@ std::shared_ptr<ObjectProfile> ObjectProfile::loadFromFile(const std::string &fo
     profile->_pathname = folderPath;
     profile->_slotNumber = slotNumber;
 
+    //List the folder once instead of probing for every optional file
+    const std::unordered_set<std::string> files = vfs_listDirectory(folderPath);
+
     //Don't load 3d model, enchant, messages, sounds or particle effects for lightweight profiles
     if(!lightWeight)
     {
@@ -999,47 +1029,55 @@ std::shared_ptr<ObjectProfile> ObjectProfile::loadFromFile(const std::string &fo
             return nullptr;
         }
 
-        // Load the enchantment for this profile (optional)
-        STRING newloadname;
-        make_newloadname( folderPath.c_str(), "/enchant.txt", newloadname );
-        profile->_ieve = EnchantProfileSystem.load_one( newloadname, static_cast<EVE_REF>(slotNumber) );
+        // Read the enchantment for this profile (optional)
+        if (files.count("enchant.txt") > 0)
+        {
+            STRING newloadname;
+            make_newloadname( folderPath.c_str(), "/enchant.txt", newloadname );
+            shared.enchant = EnchantProfileSystem.read_one( newloadname );
+        }
 
         // Load the messages for this profile, do this before loading the AI script
         // to ensure any dynamic loaded messages get loaded last (optional)
-        profile->loadAllMessages(folderPath + "/message.txt");
-
-        // Load the particles for this profile (optional)
-        for (LocalParticleProfileRef cnt(0); cnt.get() < 30; ++cnt) //TODO: find better way of listing files
+        if (files.count("message.txt") > 0)
         {
-            const std::string particleName = folderPath + "/part" + std::to_string(cnt.get()) + ".txt";
-            PIP_REF particleProfile = ParticleProfileSystem::get().load_one(particleName.c_str(), INVALID_PIP_REF);
+            profile->loadAllMessages(folderPath + "/message.txt");
+        }
 
-            // Make sure it's referenced properly
-            if(particleProfile != INVALID_PIP_REF) {
-                profile->_particleProfiles[cnt] = particleProfile; 
+        // Read the particles for this profile (optional)
+        for (LocalParticleProfileRef cnt(0); cnt.get() < 30; ++cnt)
+        {
+            const std::string particleName = "part" + std::to_string(cnt.get()) + ".txt";
+            if (files.count(particleName) > 0)
+            {
+                std::shared_ptr<pip_t> particleProfile = ParticleProfileSystem::read_one(folderPath + "/" + particleName);
+                if (particleProfile) {
+                    shared.particles.emplace_back(cnt, particleProfile);
+                }
             }
         }
 
-        // Load the waves for this iobj
-        for ( size_t cnt = 0; cnt < 30; cnt++ ) //TODO: make better search than just 30 (list files?)
+        // Find the waves for this iobj
+        for ( size_t cnt = 0; cnt < 30; cnt++ )
         {
-            const std::string soundName = folderPath + "/sound" + std::to_string(cnt);
-            SoundID soundID = AudioSystem::get().loadSound(soundName);
-
-            if(soundID != INVALID_SOUND_ID) {
-                profile->_soundMap[cnt] = soundID;
+            const std::string soundName = "sound" + std::to_string(cnt);
+            if (files.count(soundName + ".ogg") > 0 || files.count(soundName + ".wav") > 0)
+            {
+                shared.sounds.emplace_back(cnt, folderPath + "/" + soundName);
             }
         }
     }
 
     //Load profile graphics (optional)
-    profile->loadTextures(folderPath);
+    profile->loadTextures(folderPath, files);
 
     // Load the random naming table for this icap (optional)
-    profile->_randomName.loadFromFile(folderPath + "/naming.txt");
+    if (files.count("naming.txt") > 0)
+    {
+        profile->_randomName.loadFromFile(folderPath + "/naming.txt");
+    }
 
     // Finally load the character profile
-    // Do after loading particle and sound profiles
     try {
         if(!profile->loadDataFile(folderPath + "/data.txt")) {
 			Log::get().warn("Unable to load data.txt for profile: %s\n", folderPath.c_str());
@@ -1060,6 +1098,32 @@ std::shared_ptr<ObjectProfile> ObjectProfile::loadFromFile(const std::string &fo
     return profile;
 }
 
+void ObjectProfile::storeSharedProfiles(const SharedProfiles &shared)
+{
+    // Store the enchantment, this releases any enchantment in the slot if the profile has none
+    _ieve = EnchantProfileSystem.store_one( shared.enchant, static_cast<EVE_REF>(_slotNumber) );
+
+    // Store the particles in order, so they get the same references on every load
+    for (const auto& particle : shared.particles)
+    {
+        PIP_REF particleProfile = ParticleProfileSystem::get().store_one(particle.second, INVALID_PIP_REF);
+
+        // Make sure it's referenced properly
+        if(particleProfile != INVALID_PIP_REF) {
+            _particleProfiles[particle.first] = particleProfile;
+        }
+    }
+
+    // Load the waves
+    for (const auto& sound : shared.sounds)
+    {
+        SoundID soundID = AudioSystem::get().loadSound(sound.second);
+
+        if(soundID != INVALID_SOUND_ID) {
+            _soundMap[sound.first] = soundID;
+        }
+    }
+}
 
 bool ObjectProfile::isSlotValid(slot_t slot) const
 {
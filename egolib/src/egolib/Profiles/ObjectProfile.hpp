@@ -578,6 +578,28 @@ public:
     **/
     static std::shared_ptr<ObjectProfile> loadFromFile(const std::string &folderPath, const PRO_REF slotOverride, const bool lightWeight = false);
 
+    /**
+    * @brief The profiles an ObjectProfile adds to the particle and enchant profile systems and its sounds
+    **/
+    struct SharedProfiles
+    {
+        std::shared_ptr<eve_t> enchant;                                                     ///< the enchant or nullptr
+        std::vector<std::pair<LocalParticleProfileRef, std::shared_ptr<pip_t>>> particles;  ///< the particles by local reference
+        std::vector<std::pair<size_t, std::string>> sounds;                                 ///< the sound files (without extension) by index
+    };
+
+    /**
+    * @brief Like loadFromFile(), but the shared profiles are only read and not stored
+    * @remark Does not modify shared state, so it may be called from any thread. Call storeSharedProfiles() afterwards
+    *         unless the profile is a lightweight one.
+    **/
+    static std::shared_ptr<ObjectProfile> readFromFile(const std::string &folderPath, const PRO_REF slotOverride, SharedProfiles &shared, const bool lightWeight = false);
+
+    /**
+    * @brief Stores the shared profiles read by readFromFile() into the particle and enchant profile systems and loads the sounds
+    **/
+    void storeSharedProfiles(const SharedProfiles &shared);
+
     /**
     * @brief Writes the contents of this character instance to a profile data.txt file
     **/
@@ -601,8 +623,9 @@ private:
 
     /**
     * @brief load all tris*.bmp or tris*.png skin and icons
+    * @param files the names of the files in the folder
     **/
-    void loadTextures(const std::string &folderPath);
+    void loadTextures(const std::string &folderPath, const std::unordered_set<std::string> &files);
 
     /**
     * @brief Loads profile data from a datafile (data.txt)
@@ -26,6 +26,7 @@
 #include "egolib/Profiles/ProfileSystem.hpp"
 #include "egolib/Profiles/ObjectProfile.hpp"
 #include "egolib/Profiles/ModuleProfile.hpp"
+#include "egolib/Core/JobSystem.hpp"
 #include "game/GameStates/LoadPlayerElement.hpp"
 #include "game/Entities/_Include.hpp"
 #include "game/char.h"
@@ -216,6 +217,61 @@ PRO_REF ProfileSystem::loadOneProfile(const std::string &pathName, int slot_over
     return iobj;
 }
 
+void ProfileSystem::loadProfiles(const std::vector<std::string> &folderPaths)
+{
+    struct Result
+    {
+        PRO_REF slot;
+        std::shared_ptr<ObjectProfile> profile;
+        ObjectProfile::SharedProfiles shared;
+    };
+    std::vector<Result> results(folderPaths.size());
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // Read all profiles in parallel, without touching the loaded profiles or the profile systems.
+    Ego::Core::JobSystem::get().parallelFor(folderPaths.size(), 1, [this, &folderPaths, &results](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            int islot = getProfileSlotNumber(folderPaths[i]);
+            if (islot < 0 || islot >= INVALID_PRO_REF || isValidProfileID(static_cast<PRO_REF>(islot)))
+            {
+                continue;
+            }
+            results[i].slot = static_cast<PRO_REF>(islot);
+            results[i].profile = ObjectProfile::readFromFile(folderPaths[i], results[i].slot, results[i].shared);
+            if (!results[i].profile)
+            {
+                Log::get().warn("ProfileSystem::loadProfiles() - Failed to load (%s) into slot number %d\n", folderPaths[i].c_str(), islot);
+            }
+        }
+    });
+
+    const auto read = std::chrono::high_resolution_clock::now();
+
+    // Store them in order, so slots and particle profile references do not depend on the threads.
+    size_t loadedCount = 0;
+    for (Result& result : results)
+    {
+        // An earlier profile might have taken the slot.
+        if (!result.profile || isValidProfileID(result.slot))
+        {
+            continue;
+        }
+        result.profile->storeSharedProfiles(result.shared);
+        _profilesLoaded[result.slot] = result.profile;
+        loadedCount++;
+    }
+
+    const auto stored = std::chrono::high_resolution_clock::now();
+
+    Log::get().info("loaded %" PRIuZ " of %" PRIuZ " object profiles: reading %.1f ms, storing %.1f ms\n",
+                    loadedCount, folderPaths.size(),
+                    std::chrono::duration<double, std::milli>(read - start).count(),
+                    std::chrono::duration<double, std::milli>(stored - read).count());
+}
+
 const Ego::DeferredTexture& ProfileSystem::getSpellBookIcon(size_t index) const
 {
     return _profilesLoaded.find(SPELLBOOK)->second->getIcon(index);
@@ -96,6 +96,15 @@ public:
      */
     PRO_REF loadOneProfile(const std::string &folderPath, int slot_override = -1);
 
+    /**
+     * @brief
+     *  Load several objects into the slots given by their data files. The result is the same as
+     *  loading them one by one with loadOneProfile(), but the files are read in parallel.
+     * @param folderPaths
+     *  the folders of the objects. If several objects want the same slot, the first one gets it.
+     */
+    void loadProfiles(const std::vector<std::string> &folderPaths);
+
     /**
      * @brief Loads only the slot number from data.txt
      *        If slot_override is valid, then that is used indead
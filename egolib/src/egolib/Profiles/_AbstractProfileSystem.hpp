@@ -159,6 +159,27 @@ public:
     /// @brief Load an profile into the profile stack.
     /// @return a reference to the profile on sucess, INVALIDREF on failure
     REFTYPE load_one(const std::string& pathname, const REFTYPE _override)
+    {
+        return store_one(read_one(pathname), _override);
+    }
+
+    /// @brief Read a profile without storing it into the profile stack.
+    /// @return the profile on success, a null pointer on failure
+    /// @remark Does not touch the profile stack, so it may be called from any thread.
+    static std::shared_ptr<TYPE> read_one(const std::string& pathname)
+    {
+        //Allocate memory for new profile
+        std::shared_ptr<TYPE> profile = std::make_shared<TYPE>();
+
+        if (!READER::read(profile, pathname)) {
+            return nullptr;
+        }
+        return profile;
+    }
+
+    /// @brief Store a profile read by read_one() into the profile stack.
+    /// @return a reference to the profile on sucess, INVALIDREF on failure or if the profile is a null pointer
+    REFTYPE store_one(const std::shared_ptr<TYPE>& profile, const REFTYPE _override)
     {
         if(isLoaded(_override)) {
 			Log::get().warn("%s:%d:%s: loaded over existing profile\n", __FILE__, __LINE__, __FUNCTION__);
@@ -176,12 +197,11 @@ public:
             return INVALIDREF;
         }
 
-        //Allocate memory for new profile
-        std::shared_ptr<TYPE> profile = _map[ref] = std::make_shared<TYPE>();
-
-        if (!READER::read(profile, pathname)) {
+        if (!profile) {
+            _map[ref] = std::make_shared<TYPE>();
             return INVALIDREF;
         }
+        _map[ref] = profile;
         return ref;
     }
 
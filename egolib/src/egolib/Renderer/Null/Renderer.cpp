@@ -0,0 +1,103 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Renderer.cpp
+/// @brief  Implementation of a renderer which does not render anything.
+
+#include "egolib/Renderer/Null/Renderer.hpp"
+
+namespace Ego {
+namespace Null {
+
+Renderer::Renderer() :
+    _renderCount(0),
+    _vertexCount(0),
+    _textureCount(0)
+{}
+
+Renderer::~Renderer()
+{}
+
+size_t Renderer::getRenderCount() const {
+    return _renderCount;
+}
+
+size_t Renderer::getVertexCount() const {
+    return _vertexCount;
+}
+
+size_t Renderer::getTextureCount() const {
+    return _textureCount;
+}
+
+Ego::AccumulationBuffer& Renderer::getAccumulationBuffer() {
+    return _accumulationBuffer;
+}
+
+Ego::ColourBuffer& Renderer::getColourBuffer() {
+    return _colourBuffer;
+}
+
+Ego::DepthBuffer& Renderer::getDepthBuffer() {
+    return _depthBuffer;
+}
+
+Ego::TextureUnit& Renderer::getTextureUnit() {
+    return _textureUnit;
+}
+
+void Renderer::setAlphaFunction(CompareFunction function, float value) {
+    if (value < 0.0f || value > 1.0f) {
+        throw std::invalid_argument("reference alpha value out of bounds");
+    }
+}
+
+void Renderer::setScissorRectangle(float left, float bottom, float width, float height) {
+    if (width < 0) {
+        throw std::invalid_argument("width < 0");
+    }
+    if (height < 0) {
+        throw std::invalid_argument("height < 0");
+    }
+}
+
+void Renderer::setViewportRectangle(float left, float bottom, float width, float height) {
+    if (width < 0) {
+        throw std::invalid_argument("width < 0");
+    }
+    if (height < 0) {
+        throw std::invalid_argument("height < 0");
+    }
+}
+
+void Renderer::render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, size_t index, size_t length) {
+    if (index + length > vertexBuffer.getNumberOfVertices()) {
+        throw std::invalid_argument("out of bounds");
+    }
+    _renderCount++;
+    _vertexCount += length;
+}
+
+std::shared_ptr<Ego::Texture> Renderer::createTexture() {
+    _textureCount++;
+    return std::make_shared<Texture>();
+}
+
+} // namespace Null
+} // namespace Ego
@@ -0,0 +1,193 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Renderer.hpp
+/// @brief  Implementation of a renderer which does not render anything.
+
+#pragma once
+
+#include "egolib/Renderer/Renderer.hpp"
+#include "egolib/Renderer/Null/Texture.hpp"
+
+/**
+ * @brief
+ *  The Egoboo null back-end. It needs no window and no OpenGL context and is used for
+ *  running the simulation without presentation, e.g. for benchmarks. State changes are
+ *  ignored, render calls and created textures are only counted.
+ */
+namespace Ego {
+namespace Null {
+
+class AccumulationBuffer : public Ego::AccumulationBuffer
+{
+public:
+    /** @copydoc Ego::Buffer<Colour4f>::clear */
+    virtual void clear() override {}
+    /** @copydoc Ego::Buffer<Colour4f>::setClearValue */
+    virtual void setClearValue(const Colour4f& value) override {}
+};
+
+class ColourBuffer : public Ego::ColourBuffer
+{
+public:
+    /** @copydoc Ego::Buffer<Colour4f>::clear */
+    virtual void clear() override {}
+    /** @copydoc Ego::Buffer<Colour4f>::setClearValue */
+    virtual void setClearValue(const Colour4f& value) override {}
+};
+
+class DepthBuffer : public Ego::DepthBuffer
+{
+public:
+    /** @copydoc Ego::Buffer<float>::clear */
+    virtual void clear() override {}
+    /** @copydoc Ego::Buffer<float>::setClearValue */
+    virtual void setClearValue(const float& value) override {}
+};
+
+class TextureUnit : public Ego::TextureUnit
+{
+public:
+    /** @copydoc Ego::TextureUnit::setActivated */
+    virtual void setActivated(const Ego::Texture *texture) override {}
+};
+
+class Renderer : public Ego::Renderer
+{
+protected:
+    AccumulationBuffer _accumulationBuffer;
+    ColourBuffer _colourBuffer;
+    DepthBuffer _depthBuffer;
+    TextureUnit _textureUnit;
+
+    /// The number of render calls.
+    std::atomic<size_t> _renderCount;
+    /// The number of vertices passed to render calls.
+    std::atomic<size_t> _vertexCount;
+    /// The number of textures created.
+    std::atomic<size_t> _textureCount;
+
+public:
+    /**
+     * @brief
+     *  Construct this null renderer.
+     */
+    Renderer();
+    /**
+     * @brief
+     *  Destruct this null renderer.
+     */
+    virtual ~Renderer();
+
+public:
+    /**
+     * @return
+     *  the number of render calls so far
+     */
+    size_t getRenderCount() const;
+
+    /**
+     * @return
+     *  the number of vertices passed to render calls so far
+     */
+    size_t getVertexCount() const;
+
+    /**
+     * @return
+     *  the number of textures created so far
+     */
+    size_t getTextureCount() const;
+
+public:
+    /** @copydoc Ego::Renderer::getAccumulationBuffer() */
+    virtual Ego::AccumulationBuffer& getAccumulationBuffer() override;
+    /** @copydoc Ego::Renderer::getColourBuffer */
+    virtual Ego::ColourBuffer& getColourBuffer() override;
+    /** @copydoc Ego::Renderer::getDepthBuffer() */
+    virtual Ego::DepthBuffer& getDepthBuffer() override;
+    /** @copydoc Ego::Renderer::getTextureUnit() */
+    virtual Ego::TextureUnit& getTextureUnit() override;
+    /** @copydoc Ego::Renderer::setAlphaTestEnabled */
+    virtual void setAlphaTestEnabled(bool enabled) override {}
+    /** @copydoc Ego::Renderer::setAlphaFunction */
+    virtual void setAlphaFunction(CompareFunction function, float value) override;
+    /** @copydoc Ego::Renderer::setBlendingEnabled */
+    virtual void setBlendingEnabled(bool enabled) override {}
+    /** @copydoc Ego::Renderer::setSourceBlendFunction */
+    virtual void setBlendFunction(BlendFunction sourceColour, BlendFunction sourceAlpha,
+                                  BlendFunction destinationColour, BlendFunction destinationAlpha) override {}
+    /** @copydoc Ego::Renderer::setColour */
+    virtual void setColour(const Colour4f& colour) override {}
+    /** @copydoc Ego::Renderer::setCullingMode */
+    virtual void setCullingMode(CullingMode mode) override {}
+    /** @copydoc Ego::Renderer::setDepthFunction */
+    virtual void setDepthFunction(CompareFunction function) override {}
+    /** @copydoc Ego::Renderer::setDepthTestEnabled */
+    virtual void setDepthTestEnabled(bool enabled) override {}
+    /** @copydoc Ego::Renderer::setDepthWriteEnabled */
+    virtual void setDepthWriteEnabled(bool enabled) override {}
+    /** @copydoc Ego::Renderer::setScissorTestEnabled */
+    virtual void setScissorTestEnabled(bool enabled) override {}
+    /** @copydoc Ego::Renderer::setScissorRectangle */
+    virtual void setScissorRectangle(float left, float bottom, float width, float height) override;
+    /** @copydoc Ego::Renderer::setStencilMaskBack */
+    virtual void setStencilMaskBack(uint32_t mask) override {}
+    /** @copydoc Ego::Renderer::setStencilMaskFront */
+    virtual void setStencilMaskFront(uint32_t mask) override {}
+    /** @copydoc Ego::Renderer::setStencilTestEnabled */
+    virtual void setStencilTestEnabled(bool enabled) override {}
+    /** @copydoc Ego::Renderer::setViewportRectangle */
+    virtual void setViewportRectangle(float left, float bottom, float width, float height) override;
+    /** @copydoc Ego::Renderer::setWindingMode */
+    virtual void setWindingMode(WindingMode mode) override {}
+    /** @copydoc Ego::Renderer::loadMatrix */
+    virtual void loadMatrix(const Matrix4f4f& matrix) override {}
+    /** @copydoc Ego::Renderer::multMatrix */
+    virtual void multiplyMatrix(const Matrix4f4f& matrix) override {}
+    /** @copydoc Ego::Renderer::setPerspectiveCorrectionEnabled */
+    virtual void setPerspectiveCorrectionEnabled(bool enabled) override {}
+    /** @copydoc Ego::Renderer::setDitheringEnabled  */
+    virtual void setDitheringEnabled(bool enabled) override {}
+    /** @copydoc Ego::Renderer::setPointSmoothEnabled */
+    virtual void setPointSmoothEnabled(bool enabled) override {}
+    /** @copydoc Ego::Renderer::setLineSmoothEnabled */
+    virtual void setLineSmoothEnabled(bool enabled) override {}
+    /** @copydoc Ego::Renderer::setLineWidth */
+    virtual void setLineWidth(float width) override {}
+    /** @copydoc Ego::Renderer::setPointSize */
+    virtual void setPointSize(float size) override {}
+    /** @copydoc Ego::Renderer::setPolygonSmoothEnabled */
+    virtual void setPolygonSmoothEnabled(bool enabled) override {}
+    /** @copydoc Ego::Renderer::setMultisamplesEnabled */
+    virtual void setMultisamplesEnabled(bool enabled) override {}
+    /** @copydoc Ego::Renderer::setLightingEnabled */
+    virtual void setLightingEnabled(bool enabled) override {}
+    /** @copydoc Ego::Renderer::setRasterizationMode */
+    virtual void setRasterizationMode(RasterizationMode mode) override {}
+    /** @copydoc Ego::Renderer::setGouraudShadingEnabled */
+    virtual void setGouraudShadingEnabled(bool enabled) override {}
+    /** @copydoc Ego::Renderer::render */
+    virtual void render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, size_t index, size_t length) override;
+    /** @copydoc Ego::Renderer::createTexture */
+    virtual std::shared_ptr<Ego::Texture> createTexture() override;
+
+}; // class Renderer
+
+} // namespace Null
+} // namespace Ego
@@ -0,0 +1,91 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Texture.cpp
+/// @brief  Implementation of textures for the null renderer.
+
+#include "egolib/Renderer/Null/Texture.hpp"
+
+namespace Ego {
+namespace Null {
+
+static const std::string DEFAULT_NAME = "<default texture>";
+
+Texture::Texture() :
+    Ego::Texture(DEFAULT_NAME,
+                 TextureType::_2D, TextureAddressMode::Repeat, TextureAddressMode::Repeat,
+                 1, 1, 1, 1, nullptr,
+                 false),
+    _default(true)
+{}
+
+Texture::~Texture()
+{}
+
+bool Texture::load(const std::string& name, std::shared_ptr<SDL_Surface> source, uint32_t key) {
+    release();
+
+    // If no source is provided, keep this texture the default texture.
+    if (!source) {
+        return false;
+    }
+
+    // Record what the OpenGL texture would look like, without converting the pixels.
+    _type = ((1 == source->h) && (source->w > 1)) ? TextureType::_1D : TextureType::_2D;
+    _addressModeS = TextureAddressMode::Repeat;
+    _addressModeT = TextureAddressMode::Repeat;
+    _width = source->w;
+    _height = source->h;
+    _source = source;
+    _sourceWidth = source->w;
+    _sourceHeight = source->h;
+    _hasAlpha = (INVALID_KEY != key) || (nullptr != source->format && 0 != source->format->Amask);
+    _name = name;
+    _default = false;
+
+    return true;
+}
+
+bool Texture::load(std::shared_ptr<SDL_Surface> source, uint32_t key) {
+    std::ostringstream stream;
+    stream << "<source " << static_cast<void *>(source.get()) << ">";
+    return load(stream.str(), source, key);
+}
+
+void Texture::release() {
+    if (isDefault()) {
+        return;
+    }
+    _source = nullptr;
+    _type = TextureType::_2D;
+    _addressModeS = TextureAddressMode::Repeat;
+    _addressModeT = TextureAddressMode::Repeat;
+    _width = _height = 1;
+    _sourceWidth = _sourceHeight = 1;
+    _name = DEFAULT_NAME;
+    _hasAlpha = false;
+    _default = true;
+}
+
+bool Texture::isDefault() const {
+    return _default;
+}
+
+} // namespace Null
+} // namespace Ego
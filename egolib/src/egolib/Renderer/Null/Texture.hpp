@@ -0,0 +1,74 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Texture.hpp
+/// @brief  Implementation of textures for the null renderer.
+
+#pragma once
+
+#include "egolib/Renderer/Texture.hpp"
+
+namespace Ego {
+namespace Null {
+
+/**
+ * @brief
+ *  A texture of the null renderer.
+ *  Loading a surface records its dimensions but uploads nothing.
+ */
+class Texture : public Ego::Texture
+{
+public:
+    /**
+     * @brief
+     *  Construct this texture.
+     * @post
+     *  This texture is the default texture.
+     */
+    Texture();
+
+    /**
+     * @brief
+     *  Destruct this texture.
+     */
+    virtual ~Texture();
+
+public:
+    /** @override Ego::Texture::load(const std::string& name, std::shared_ptr<SDL_Surface>, uint32_t) */
+    bool load(const std::string& name, std::shared_ptr<SDL_Surface> surface, uint32_t key = INVALID_KEY) override;
+
+    /** @override Ego::Texture::load(std::shared_ptr<SDL_Surface>, uint32_t) */
+    bool load(std::shared_ptr<SDL_Surface> surface, uint32_t key = INVALID_KEY) override;
+
+    /** @override Ego::Texture::release */
+    void release() override;
+
+    /** @override Ego::Texture::isDefault */
+    bool isDefault() const override;
+
+private:
+    /**
+     * @brief
+     *  @a true if this texture is the default texture, @a false otherwise.
+     */
+    bool _default;
+};
+
+} // namespace Null
+} // namespace Ego
@@ -23,6 +23,7 @@
 
 #include "egolib/Renderer/Renderer.hpp"
 #include "egolib/Renderer/OpenGL/Renderer.hpp"
+#include "egolib/Renderer/Null/Renderer.hpp"
 
 namespace Ego
 {
@@ -51,9 +52,28 @@ TextureUnit::TextureUnit()
 TextureUnit::~TextureUnit()
 {}
 
+RendererFactory::Backend RendererFactory::_backend = RendererFactory::Backend::OpenGL;
+
+void RendererFactory::setBackend(Backend backend)
+{
+    _backend = backend;
+}
+
+RendererFactory::Backend RendererFactory::getBackend()
+{
+    return _backend;
+}
+
 Renderer *RendererFactory::operator()()
 {
-    return new OpenGL::Renderer();
+    switch (_backend)
+    {
+        case Backend::Null:
+            return new Null::Renderer();
+        case Backend::OpenGL:
+        default:
+            return new OpenGL::Renderer();
+    }
 }
 
 Renderer::Renderer()
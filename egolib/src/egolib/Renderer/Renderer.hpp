@@ -223,7 +223,37 @@ class Renderer;
 
 class RendererFactory {
 public:
+    /// The back-ends the factory can create renderers for.
+    enum class Backend {
+        /// The OpenGL renderer. Requires a window with an OpenGL context.
+        OpenGL,
+        /// A renderer which does not render anything. Requires neither a window nor an OpenGL context.
+        Null,
+    };
+
+    /**
+     * @brief
+     *  Set the back-end of renderers created by this factory.
+     * @param backend
+     *  the back-end
+     * @remark
+     *  Must be called before the renderer singleton is initialized.
+     *  The default back-end is Backend::OpenGL.
+     */
+    static void setBackend(Backend backend);
+
+    /**
+     * @brief
+     *  Get the back-end of renderers created by this factory.
+     * @return
+     *  the back-end
+     */
+    static Backend getBackend();
+
     Renderer *operator()();
+
+private:
+    static Backend _backend;
 };
 
 class Renderer : public Ego::Core::Singleton<Renderer, RendererFactory> {
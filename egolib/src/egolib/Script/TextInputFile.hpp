@@ -33,6 +33,7 @@ namespace Script
 /**
  * @brief
  *  A text input file supports reading single characters from a file.
+ *  The whole file is read into memory when it is opened and scanned from there.
  * @author
  *  Michael Heilmann
  */
@@ -44,9 +45,21 @@ private:
 
     /**
      * @brief
-     *  The backing VFS file.
+     *  The contents of the file or @a nullptr if the file could not be read.
      */
-    vfs_FILE *_file;
+    char *_data;
+
+    /**
+     * @brief
+     *  The length, in Bytes, of the contents of the file.
+     */
+    size_t _length;
+
+    /**
+     * @brief
+     *  The index of the next Byte to read.
+     */
+    size_t _position;
     
     typedef typename TextFile<_Traits>::Traits Traits;
 
@@ -71,10 +84,16 @@ public:
      */
     TextInputFile(const string& fileName) :
         TextFile<_Traits>(fileName, TextFile<_Traits>::Mode::Read),
-        _file(nullptr),
+        _data(nullptr),
+        _length(0),
+        _position(0),
         _current(Traits::startOfInput())
     {
-        _file = vfs_openRead(fileName);
+        if (!vfs_readEntireFile(fileName, &_data, &_length))
+        {
+            _data = nullptr;
+            _length = 0;
+        }
     }
 
     /**
@@ -83,10 +102,10 @@ public:
      */
     virtual ~TextInputFile()
     {
-        if (_file)
+        if (_data)
         {
-            vfs_close(_file);
-            _file = nullptr;
+            free(_data);
+            _data = nullptr;
         }
     }
 
@@ -98,7 +117,7 @@ public:
      */
     bool isOpen() const
     {
-        return nullptr != _file;
+        return nullptr != _data;
     }
 
     /**
@@ -117,36 +136,20 @@ public:
             // ... do nothing.
             return;
         }
-        // (2) If the backing VFS file is not opened ...
-        if (!_file)
+        // (2) If the file could not be read ...
+        if (!_data)
         {
             // ... raise an error.
             _current = Traits::error();
             return;
         }
         // (3) Otherwise: Read a single Byte.
-        uint8_t byte;
-        size_t size = vfs_read(&byte, 1, 1, _file);
-        if (1 != size)
+        if (_position == _length)
         {
-            if (vfs_error(_file))
-            {
-                _current = Traits::error();
-                return;
-            }
-            else if (vfs_eof(_file))
-            {
-                _current = Traits::endOfInput();
-                return;
-            }
-            else
-            {
-                ostringstream message;
-                message << __FILE__ << ":" << __LINE__ << ": "
-                        << "inconsistent state of file object  of file `" << this->getFileName() << "`";
-                throw runtime_error(message.str());
-            }
+            _current = Traits::endOfInput();
+            return;
         }
+        uint8_t byte = static_cast<uint8_t>(_data[_position++]);
         // (4) Verify that it is a Byte the represents the starting Byte of a UTF-8 character sequence of length 1.
         if (byte > 0x7F)
         {
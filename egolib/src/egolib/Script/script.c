@@ -40,6 +40,7 @@ namespace Script {
 
 #define Define(name) { name, &scr_##name },
 #define DefineAlias(alias, name) { alias, &scr_##name },
+#define Local(name) name,
 
 Runtime::Runtime() 
 	:
@@ -443,10 +444,101 @@ Runtime::Runtime()
 			Define(IfStealthed)
 			Define(SetTargetToDistantFriend)
 			Define(DisplayCharge)
+		},
+		_localFunctionValueCodes
+		{
+			Local(IfSpawned)
+			Local(IfTimeOut)
+			Local(IfAtWaypoint)
+			Local(IfAtLastWaypoint)
+			Local(IfAttacked)
+			Local(IfBumped)
+			Local(IfOrdered)
+			Local(IfCalledForHelp)
+			Local(IfKilled)
+			Local(IfTargetKilled)
+			Local(IfChanged)
+			Local(IfUsed)
+			Local(IfGrabbed)
+			Local(IfDropped)
+			Local(IfHealed)
+			Local(IfCleanedUp)
+			Local(IfBored)
+			Local(IfDazed)
+			Local(IfInWater)
+			Local(IfNotDropped)
+			Local(IfBlocked)
+			Local(IfThrown)
+			Local(IfNotPutAway)
+			Local(IfHitFromBehind)
+			Local(IfHitFromFront)
+			Local(IfHitFromLeft)
+			Local(IfHitFromRight)
+			Local(SetContent)
+			Local(GetContent)
+			Local(IfContentIs)
+			Local(SetState)
+			Local(GetState)
+			Local(IfStateIs)
+			Local(IfStateIsNot)
+			Local(IfStateIsOdd)
+			Local(IfStateIs0)
+			Local(IfStateIs1)
+			Local(IfStateIs2)
+			Local(IfStateIs3)
+			Local(IfStateIs4)
+			Local(IfStateIs5)
+			Local(IfStateIs6)
+			Local(IfStateIs7)
+			Local(IfStateIs8)
+			Local(IfStateIs9)
+			Local(IfStateIs10)
+			Local(IfStateIs11)
+			Local(IfStateIs12)
+			Local(IfStateIs13)
+			Local(IfStateIs14)
+			Local(IfStateIs15)
+			Local(SetTime)
+			Local(ClearWaypoints)
+			Local(AddWaypoint)
+			Local(Compass)
+			Local(TranslateOrder)
+			Local(GetAttackTurn)
+			Local(SetXY)
+			Local(GetXY)
+			Local(AddXY)
+			Local(IfXIsLessThanY)
+			Local(IfYIsLessThanX)
+			Local(IfXIsEqualToY)
+			Local(IfDistanceIsMoreThanTurn)
+			Local(SetTargetToSelf)
+			Local(SetTargetToOwner)
+			Local(SetTargetToWhoeverBumped)
+			Local(SetTargetToWhoeverCalledForHelp)
+			Local(SetOldTarget)
+			Local(IfTargetIsOldTarget)
+			Local(IfTargetIsSelf)
+			Local(IfTargetIsOwner)
+			Local(IfTargetIsAlive)
+			Local(IfTargetIsHurt)
+			Local(IfTargetIsOnOtherTeam)
+			Local(IfTargetIsOnHatedTeam)
+			Local(IfTargetIsDefending)
+			Local(IfTargetIsAttacking)
+			Local(IfTargetHoldingItemID)
+			Local(IfFacingTarget)
+			Local(IfUnarmed)
+			Local(IfHoldingMeleeWeapon)
+			Local(IfHoldingShield)
+			Local(IfHoldingItemID)
+			Local(Else)
+			Local(DoNothing)
+			Local(End)
 		}
 {
 }
 
+#undef Local
 #undef DefineAlias
 #undef Define
 
@@ -467,8 +559,8 @@ static std::shared_ptr<Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive>> g
 static int    _script_function_calls[Ego::ScriptFunctions::SCRIPT_FUNCTIONS_COUNT];
 static double _script_function_times[Ego::ScriptFunctions::SCRIPT_FUNCTIONS_COUNT];
 
-static PRO_REF script_error_model = INVALID_PRO_REF;
-static const char * script_error_classname = "UNKNOWN";
+static thread_local PRO_REF script_error_model = INVALID_PRO_REF;
+static thread_local const char * script_error_classname = "UNKNOWN";
 
 static bool _scripting_system_initialized = false;
 
@@ -506,6 +598,102 @@ void scripting_system_end()
     }
 }
 
+//--------------------------------------------------------------------------------------------
+static void scr_interpret_chr_script(script_state_t& my_state, ai_state_t& aiState, script_info_t& script) {
+	script.set_pos(0);
+	while (!aiState.terminate && script.get_pos() < script._instructions.getLength()) {
+		// This is used by the Else function
+		// it only keeps track of functions.
+		my_state.indent_last = my_state.indent;
+		my_state.indent = script._instructions[script.get_pos()].getDataBits();
+
+		// Was it a function.
+		if (script._instructions[script.get_pos()].isInv()) {
+			if (!script_state_t::run_function_call(my_state, aiState, script)) {
+				break;
+			}
+		}
+		else {
+			if (!script_state_t::run_operation(my_state, aiState, script)) {
+				break;
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------------
+/// Run a compiled script from the instruction at @a pc on.
+/// If @a localOnly is @a true, stop at the first instruction which is not local.
+/// Script functions are only timed when they are not run as part of the local run.
+/// Returns the instruction at which the script stopped.
+static uint32_t scr_run_compiled_chr_script(script_state_t& my_state, ai_state_t& aiState, script_info_t& script, uint32_t pc, bool localOnly) {
+	const CompiledScript& compiled = script._compiled;
+	const uint32_t count = compiled._instructions.size();
+	const bool profiling = egoboo_config_t::get().debug_scriptProfiling_enable.getValue();
+
+	while (!aiState.terminate && pc < count) {
+		const CompiledInstruction& instruction = compiled._instructions[pc];
+		if (localOnly && (profiling || !instruction._local)) {
+			break;
+		}
+
+		// This is used by the Else function
+		// it only keeps track of functions.
+		my_state.indent_last = my_state.indent;
+		my_state.indent = instruction._indent;
+
+		switch (instruction._kind) {
+			case CompiledInstruction::Kind::Invoke:
+			{
+				Uint8 returncode;
+				if (nullptr == instruction._function) {
+					returncode = script_state_t::run_unresolved_function(script, instruction._value);
+				} else if (profiling) {
+					{
+						Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(*g_scriptFunctionClock);
+						returncode = instruction._function(my_state, aiState);
+					}
+					_script_function_calls[instruction._value] += 1;
+					_script_function_times[instruction._value] += g_scriptFunctionClock->lst();
+				} else {
+					returncode = instruction._function(my_state, aiState);
+				}
+				pc = returncode ? instruction._next : instruction._jump;
+			}
+			break;
+
+			case CompiledInstruction::Kind::Assign:
+			{
+				my_state.operationsum = 0;
+				if (instruction._operandCount > 0 && _currentModule->getObjectHandler().exists(aiState.getSelf())) {
+					Object *pchr = _currentModule->getObjectHandler().get(aiState.getSelf());
+					Object *ptarget = _currentModule->getObjectHandler().exists(aiState.getTarget())
+						            ? _currentModule->getObjectHandler().get(aiState.getTarget()) : nullptr;
+					Object *powner = _currentModule->getObjectHandler().exists(aiState.owner)
+						           ? _currentModule->getObjectHandler().get(aiState.owner) : nullptr;
+
+					const CompiledOperand *operand = compiled._operands.data() + instruction._firstOperand;
+					for (uint32_t i = 0; i < instruction._operandCount; ++i, ++operand) {
+						int32_t value = operand->_value;
+						if (!operand->_constant) {
+							const char *varname = "";
+							value = script_state_t::get_variable(my_state, aiState, pchr, ptarget, powner, static_cast<Uint8>(operand->_value), varname);
+						}
+						script_state_t::apply_operator(my_state, operand->_operator, value);
+					}
+				}
+
+				// Save the results in the register that called the arithmetic
+				script_state_t::set_operand(my_state, static_cast<Uint8>(instruction._value));
+				pc = instruction._next;
+			}
+			break;
+		}
+	}
+
+	return pc;
+}
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 void scr_run_chr_script(Object *pchr) {
@@ -513,6 +701,26 @@ void scr_run_chr_script(Object *pchr) {
 	// Make sure that this module is initialized.
 	scripting_system_begin();
 
+	script_run_t run;
+	scr_run_chr_script_local(pchr, run);
+	scr_finish_chr_script(pchr, run);
+}
+
+//--------------------------------------------------------------------------------------------
+static void scr_set_error_context(Object *pchr) {
+	script_error_classname = "UNKNOWN";
+	script_error_model = pchr->getProfileID();
+	if (script_error_model < INVALID_PRO_REF)
+	{
+		script_error_classname = ProfileSystem::get().getProfile(script_error_model)->getClassName().c_str();
+	}
+}
+
+//--------------------------------------------------------------------------------------------
+void scr_run_chr_script_local(Object *pchr, script_run_t& run) {
+
+	run._pending = false;
+
 	// Do not run scripts of terminated entities.
 	if (pchr->isTerminated()) {
 		return;
@@ -540,12 +748,7 @@ void scr_run_chr_script(Object *pchr) {
 	aiState.setOldTarget(aiState.getTarget());
 
 	// Make life easier
-	script_error_classname = "UNKNOWN";
-	script_error_model = pchr->getProfileID();
-	if (script_error_model < INVALID_PRO_REF)
-	{
-		script_error_classname = ProfileSystem::get().getProfile(script_error_model)->getClassName().c_str();
-	}
+	scr_set_error_context(pchr);
 
 	if (debug_scripts && debug_script_file) {
 		vfs_FILE * scr_file = debug_script_file;
@@ -598,31 +801,49 @@ void scr_run_chr_script(Object *pchr) {
 	}
 
 	// Reset the script state.
-	script_state_t my_state;
+	run._state = script_state_t();
+	run._pending = true;
 
 	// Reset the ai.
 	aiState.terminate = false;
-	script.indent = 0;
 
 	// Run the AI Script.
-	script.set_pos(0);
-	while (!aiState.terminate && script.get_pos() < script._instructions.getLength()) {
-		// This is used by the Else function
-		// it only keeps track of functions.
-		script.indent_last = script.indent;
-		script.indent = script._instructions[script.get_pos()].getDataBits();
+	if (debug_scripts && debug_script_file) {
+		// The interpreter of the instruction list is slower, but it can trace what it does.
+		scr_interpret_chr_script(run._state, aiState, script);
+		run._position = script._compiled._instructions.size();
+	} else {
+		run._position = scr_run_compiled_chr_script(run._state, aiState, script, 0, true);
+	}
 
-		// Was it a function.
-		if (script._instructions[script.get_pos()].isInv()) {
-			if (!script_state_t::run_function_call(my_state, aiState, script)) {
-				break;
-			}
-		}
-		else {
-			if (!script_state_t::run_operation(my_state, aiState, script)) {
-				break;
-			}
-		}
+	// Alerts raised by other scripts from now on are left for the next run.
+	run._alerts.see(aiState.alert);
+}
+
+//--------------------------------------------------------------------------------------------
+void scr_finish_chr_script(Object *pchr, script_run_t& run) {
+
+	if (!run._pending) {
+		return;
+	}
+	run._pending = false;
+
+	// Do not finish scripts of entities terminated in the meantime.
+	if (pchr->isTerminated()) {
+		return;
+	}
+
+	ai_state_t& aiState = pchr->ai;
+	script_info_t& script = pchr->getProfile()->getAIScript();
+
+	Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(*aiState._clock);
+
+	const BIT_FIELD alertBefore = aiState.alert;
+
+	// Run the rest of the AI Script.
+	if (!aiState.terminate && run._position < script._compiled._instructions.size()) {
+		scr_set_error_context(pchr);
+		scr_run_compiled_chr_script(run._state, aiState, script, run._position, false);
 	}
 
 	// Set latches
@@ -655,9 +876,10 @@ void scr_run_chr_script(Object *pchr) {
 		}
 	}
 
-	// Clear alerts for next time around
-	RESET_BIT_FIELD(aiState.alert);
+	// Clear the alerts seen by this run for next time around
+	run._alerts.clear(aiState.alert, alertBefore);
 }
+
 void scr_run_chr_script( const ObjectRef character )
 {
     /// @author ZZ
@@ -724,7 +946,7 @@ bool script_state_t::run_operation( script_state_t& state, ai_state_t& aiState,
     if ( debug_scripts && debug_script_file )
     {
 
-        for ( i = 0; i < script.indent; i++ ) { vfs_printf( debug_script_file, "  " ); }
+        for ( i = 0; i < state.indent; i++ ) { vfs_printf( debug_script_file, "  " ); }
 
         for ( i = 0; i < MAX_OPCODE; i++ )
         {
@@ -786,7 +1008,7 @@ Uint8 script_state_t::run_function(script_state_t& self, ai_state_t& aiState, sc
     {
         Uint32 i;
 
-        for ( i = 0; i < script.indent; i++ ) { vfs_printf( debug_script_file,  "  " ); }
+        for ( i = 0; i < self.indent; i++ ) { vfs_printf( debug_script_file,  "  " ); }
 
         for ( i = 0; i < MAX_OPCODE; i++ )
         {
@@ -807,9 +1029,7 @@ Uint8 script_state_t::run_function(script_state_t& self, ai_state_t& aiState, sc
 			Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(*g_scriptFunctionClock);
 			auto result = Ego::Script::Runtime::get()._functionValueCodeToFunctionPointer.find(valuecode);
 			if (Ego::Script::Runtime::get()._functionValueCodeToFunctionPointer.cend() == result) {
-				Log::get().message("%s:%d:%s: script error - ai script \"%s\" - unhandled script function %d\n", \
-					               __FILE__, __LINE__, __FUNCTION__, script._name.c_str(), valuecode);
-				returncode = false;
+				returncode = script_state_t::run_unresolved_function(script, valuecode);
 			} else {
 				returncode = result->second(self, aiState);
 			}
@@ -822,6 +1042,29 @@ Uint8 script_state_t::run_function(script_state_t& self, ai_state_t& aiState, sc
     return returncode;
 }
 
+//--------------------------------------------------------------------------------------------
+Uint8 script_state_t::run_unresolved_function(script_info_t& script, Uint32 valuecode)
+{
+    /// @details This function handles a function call for which no function exists
+
+    if ( MAX_OPCODE == valuecode )
+    {
+		Log::get().message("%s:%d:%s: model == %d, class name == \"%s\" - Unknown opcode found!\n", \
+			               __FILE__, __LINE__, __FUNCTION__, REF_TO_INT(script_error_model), script_error_classname);
+        return false;
+    }
+
+    // Value codes beyond the script functions pass, as they always did
+    if ( valuecode > Ego::ScriptFunctions::SCRIPT_FUNCTIONS_COUNT )
+    {
+        return true;
+    }
+
+	Log::get().message("%s:%d:%s: script error - ai script \"%s\" - unhandled script function %d\n", \
+		               __FILE__, __LINE__, __FUNCTION__, script._name.c_str(), valuecode);
+    return false;
+}
+
 //--------------------------------------------------------------------------------------------
 void script_state_t::set_operand( script_state_t& state, Uint8 variable )
 {
@@ -899,576 +1142,601 @@ void script_state_t::run_operand( script_state_t& state, ai_state_t& aiState, sc
         // Get the variable opcode from a register
         variable = pscript->_instructions[pscript->get_pos()] & Instruction::VALUEBITS;
 
-        switch ( variable )
-        {
-            case VARTMPX:
-                varname = "TMPX";
-                iTmp = state.x;
-                break;
+        iTmp = script_state_t::get_variable(state, aiState, pchr, ptarget, powner, variable, varname);
+    }
 
-            case VARTMPY:
-                varname = "TMPY";
-                iTmp = state.y;
-                break;
+    // Now do the math
+    op = script_state_t::apply_operator(state, operation, iTmp);
 
-            case VARTMPDISTANCE:
-                varname = "TMPDISTANCE";
-                iTmp = state.distance;
-                break;
+    if ( debug_scripts && debug_script_file )
+    {
+        vfs_printf( debug_script_file, "%s %s(%d) ", op, varname, iTmp );
+    }
+}
 
-            case VARTMPTURN:
-                varname = "TMPTURN";
-                iTmp = state.turn;
-                break;
+//--------------------------------------------------------------------------------------------
+int32_t script_state_t::get_variable( script_state_t& state, ai_state_t& aiState, Object *pchr, Object *ptarget, Object *powner, Uint8 variable, const char *& varname )
+{
+    /// @details This function gets the value of a variable for the scripted arithmetic
 
-            case VARTMPARGUMENT:
-                varname = "TMPARGUMENT";
-                iTmp = state.argument;
-                break;
+    int32_t iTmp = 0;
 
-            case VARRAND:
-                varname = "RAND";
-                iTmp = Random::next(std::numeric_limits<uint16_t>::max());
-                break;
+    switch ( variable )
+    {
+        case VARTMPX:
+            varname = "TMPX";
+            iTmp = state.x;
+            break;
 
-            case VARSELFX:
-                varname = "SELFX";
-                iTmp = pchr->getPosX();
-                break;
+        case VARTMPY:
+            varname = "TMPY";
+            iTmp = state.y;
+            break;
 
-            case VARSELFY:
-                varname = "SELFY";
-                iTmp = pchr->getPosY();
-                break;
+        case VARTMPDISTANCE:
+            varname = "TMPDISTANCE";
+            iTmp = state.distance;
+            break;
 
-            case VARSELFTURN:
-                varname = "SELFTURN";
-                iTmp = pchr->ori.facing_z;
-                break;
+        case VARTMPTURN:
+            varname = "TMPTURN";
+            iTmp = state.turn;
+            break;
 
-            case VARSELFCOUNTER:
-                varname = "SELFCOUNTER";
-				iTmp = aiState.order_counter;
-                break;
+        case VARTMPARGUMENT:
+            varname = "TMPARGUMENT";
+            iTmp = state.argument;
+            break;
 
-            case VARSELFORDER:
-                varname = "SELFORDER";
-				iTmp = aiState.order_value;
-                break;
+        case VARRAND:
+            varname = "RAND";
+            iTmp = Random::next(std::numeric_limits<uint16_t>::max());
+            break;
 
-            case VARSELFMORALE:
-                varname = "SELFMORALE";
-                iTmp = _currentModule->getTeamList()[pchr->team_base].getMorale();
-                break;
+        case VARSELFX:
+            varname = "SELFX";
+            iTmp = pchr->getPosX();
+            break;
 
-            case VARSELFLIFE:
-                varname = "SELFLIFE";
-                iTmp = FLOAT_TO_FP8(pchr->getLife());
-                break;
+        case VARSELFY:
+            varname = "SELFY";
+            iTmp = pchr->getPosY();
+            break;
 
-            case VARTARGETX:
-                varname = "TARGETX";
-                iTmp = ( nullptr == ptarget ) ? 0 : ptarget->getPosX();
-                break;
+        case VARSELFTURN:
+            varname = "SELFTURN";
+            iTmp = pchr->ori.facing_z;
+            break;
 
-            case VARTARGETY:
-                varname = "TARGETY";
-                iTmp = ( nullptr == ptarget ) ? 0 : ptarget->getPosY();
-                break;
+        case VARSELFCOUNTER:
+            varname = "SELFCOUNTER";
+            iTmp = aiState.order_counter;
+            break;
 
-            case VARTARGETDISTANCE:
-                varname = "TARGETDISTANCE";
-                if ( nullptr == ptarget )
-                {
-                    iTmp = 0x7FFFFFFF;
-                }
-                else
-                {
-                    iTmp = std::abs(ptarget->getPosX() - pchr->getPosX())
-                         + std::abs(ptarget->getPosY() - pchr->getPosY());
-                }
-                break;
+        case VARSELFORDER:
+            varname = "SELFORDER";
+            iTmp = aiState.order_value;
+            break;
 
-            case VARTARGETTURN:
-                varname = "TARGETTURN";
-                iTmp = ( nullptr == ptarget ) ? 0 : ptarget->ori.facing_z;
-                break;
+        case VARSELFMORALE:
+            varname = "SELFMORALE";
+            iTmp = _currentModule->getTeamList()[pchr->team_base].getMorale();
+            break;
+
+        case VARSELFLIFE:
+            varname = "SELFLIFE";
+            iTmp = FLOAT_TO_FP8(pchr->getLife());
+            break;
+
+        case VARTARGETX:
+            varname = "TARGETX";
+            iTmp = ( nullptr == ptarget ) ? 0 : ptarget->getPosX();
+            break;
 
-            case VARLEADERX:
+        case VARTARGETY:
+            varname = "TARGETY";
+            iTmp = ( nullptr == ptarget ) ? 0 : ptarget->getPosY();
+            break;
+
+        case VARTARGETDISTANCE:
+            varname = "TARGETDISTANCE";
+            if ( nullptr == ptarget )
             {
-                varname = "LEADERX";
-                iTmp = pchr->getPosX();
-                std::shared_ptr<Object> leader = _currentModule->getTeamList()[pchr->team].getLeader();
-                if ( leader )
-                    iTmp = leader->getPosX();
-                break;
+                iTmp = 0x7FFFFFFF;
             }
-
-            case VARLEADERY:
+            else
             {
-                varname = "LEADERY";
-                iTmp = pchr->getPosY();
-                std::shared_ptr<Object> leader = _currentModule->getTeamList()[pchr->team].getLeader();
-                if ( leader )
-                    iTmp = leader->getPosY();
-
-                break; 
+                iTmp = std::abs(ptarget->getPosX() - pchr->getPosX())
+                     + std::abs(ptarget->getPosY() - pchr->getPosY());
             }
+            break;
 
-            case VARLEADERDISTANCE:
-                {
-                    varname = "LEADERDISTANCE";
-
-                    std::shared_ptr<Object> pleader = _currentModule->getTeamList()[pchr->team].getLeader();
-                    if ( !pleader )
-                    {
-                        iTmp = 0x7FFFFFFF;
-                    }
-                    else
-                    {
-                        iTmp = std::abs(pleader->getPosX() - pchr->getPosX())
-                             + std::abs(pleader->getPosY() - pchr->getPosY());
-                    }
-                }
-                break;
+        case VARTARGETTURN:
+            varname = "TARGETTURN";
+            iTmp = ( nullptr == ptarget ) ? 0 : ptarget->ori.facing_z;
+            break;
 
-            case VARLEADERTURN:
-                varname = "LEADERTURN";
-                iTmp = pchr->ori.facing_z;
-                if ( _currentModule->getTeamList()[pchr->team].getLeader() )
-                    iTmp = _currentModule->getTeamList()[pchr->team].getLeader()->ori.facing_z;
+        case VARLEADERX:
+        {
+            varname = "LEADERX";
+            iTmp = pchr->getPosX();
+            std::shared_ptr<Object> leader = _currentModule->getTeamList()[pchr->team].getLeader();
+            if ( leader )
+                iTmp = leader->getPosX();
+            break;
+        }
 
-                break;
+        case VARLEADERY:
+        {
+            varname = "LEADERY";
+            iTmp = pchr->getPosY();
+            std::shared_ptr<Object> leader = _currentModule->getTeamList()[pchr->team].getLeader();
+            if ( leader )
+                iTmp = leader->getPosY();
 
-            case VARGOTOX:
-                varname = "GOTOX";
+            break; 
+        }
 
-				ai_state_t::ensure_wp(aiState);
+        case VARLEADERDISTANCE:
+            {
+                varname = "LEADERDISTANCE";
 
-				if (!aiState.wp_valid)
+                std::shared_ptr<Object> pleader = _currentModule->getTeamList()[pchr->team].getLeader();
+                if ( !pleader )
                 {
-                    iTmp = pchr->getPosX();
+                    iTmp = 0x7FFFFFFF;
                 }
                 else
                 {
-					iTmp = aiState.wp[kX];
+                    iTmp = std::abs(pleader->getPosX() - pchr->getPosX())
+                         + std::abs(pleader->getPosY() - pchr->getPosY());
                 }
-                break;
+            }
+            break;
 
-            case VARGOTOY:
-                varname = "GOTOY";
+        case VARLEADERTURN:
+            varname = "LEADERTURN";
+            iTmp = pchr->ori.facing_z;
+            if ( _currentModule->getTeamList()[pchr->team].getLeader() )
+                iTmp = _currentModule->getTeamList()[pchr->team].getLeader()->ori.facing_z;
 
-				ai_state_t::ensure_wp(aiState);
+            break;
 
-				if (!aiState.wp_valid)
-                {
-                    iTmp = pchr->getPosY();
-                }
-                else
-                {
-					iTmp = aiState.wp[kY];
-                }
-                break;
+        case VARGOTOX:
+            varname = "GOTOX";
 
-            case VARGOTODISTANCE:
-                varname = "GOTODISTANCE";
+            ai_state_t::ensure_wp(aiState);
 
-				ai_state_t::ensure_wp(aiState);
+            if (!aiState.wp_valid)
+            {
+                iTmp = pchr->getPosX();
+            }
+            else
+            {
+                iTmp = aiState.wp[kX];
+            }
+            break;
 
-				if (!aiState.wp_valid)
-                {
-                    iTmp = 0x7FFFFFFF;
-                }
-                else
-                {
-					iTmp = std::abs(aiState.wp[kX] - pchr->getPosX())
-						 + std::abs(aiState.wp[kY] - pchr->getPosY());
-                }
-                break;
+        case VARGOTOY:
+            varname = "GOTOY";
 
-            case VARTARGETTURNTO:
-                varname = "TARGETTURNTO";
-                if ( NULL == ptarget )
-                {
-                    iTmp = 0;
-                }
-                else
-                {
-                    iTmp = vec_to_facing( ptarget->getPosX() - pchr->getPosX() , ptarget->getPosY() - pchr->getPosY() );
-                    iTmp = Ego::Math::clipBits<16>( iTmp );
-                }
-                break;
+            ai_state_t::ensure_wp(aiState);
 
-            case VARPASSAGE:
-                varname = "PASSAGE";
-				iTmp = aiState.passage;
-                break;
+            if (!aiState.wp_valid)
+            {
+                iTmp = pchr->getPosY();
+            }
+            else
+            {
+                iTmp = aiState.wp[kY];
+            }
+            break;
 
-            case VARWEIGHT:
-                varname = "WEIGHT";
-                iTmp = pchr->holdingweight;
-                break;
+        case VARGOTODISTANCE:
+            varname = "GOTODISTANCE";
 
-            case VARSELFALTITUDE:
-                varname = "SELFALTITUDE";
-                iTmp = pchr->getPosZ() - pchr->getObjectPhysics().getGroundElevation();
-                break;
+            ai_state_t::ensure_wp(aiState);
 
-            case VARSELFID:
-                varname = "SELFID";
-				iTmp = pchr->getProfile()->getIDSZ(IDSZ_TYPE);
-                break;
+            if (!aiState.wp_valid)
+            {
+                iTmp = 0x7FFFFFFF;
+            }
+            else
+            {
+                iTmp = std::abs(aiState.wp[kX] - pchr->getPosX())
+                     + std::abs(aiState.wp[kY] - pchr->getPosY());
+            }
+            break;
 
-            case VARSELFHATEID:
-                varname = "SELFHATEID";
-				iTmp = pchr->getProfile()->getIDSZ(IDSZ_HATE);
-                break;
+        case VARTARGETTURNTO:
+            varname = "TARGETTURNTO";
+            if ( NULL == ptarget )
+            {
+                iTmp = 0;
+            }
+            else
+            {
+                iTmp = vec_to_facing( ptarget->getPosX() - pchr->getPosX() , ptarget->getPosY() - pchr->getPosY() );
+                iTmp = Ego::Math::clipBits<16>( iTmp );
+            }
+            break;
 
-            case VARSELFMANA:
-                varname = "SELFMANA";
-                iTmp = FLOAT_TO_FP8(pchr->getMana());
-                if ( pchr->getAttribute(Ego::Attribute::CHANNEL_LIFE) )  iTmp += FLOAT_TO_FP8(pchr->getLife());
+        case VARPASSAGE:
+            varname = "PASSAGE";
+            iTmp = aiState.passage;
+            break;
 
-                break;
+        case VARWEIGHT:
+            varname = "WEIGHT";
+            iTmp = pchr->holdingweight;
+            break;
 
-            case VARTARGETSTR:
-                varname = "TARGETSTR";
-                iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::MIGHT));
-                break;
+        case VARSELFALTITUDE:
+            varname = "SELFALTITUDE";
+            iTmp = pchr->getPosZ() - pchr->getObjectPhysics().getGroundElevation();
+            break;
 
-            case VARTARGETINT:
-                varname = "TARGETINT";
-                iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::INTELLECT));
-                break;
+        case VARSELFID:
+            varname = "SELFID";
+            iTmp = pchr->getProfile()->getIDSZ(IDSZ_TYPE);
+            break;
 
-            case VARTARGETDEX:
-                varname = "TARGETDEX";
-                iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::AGILITY));
-                break;
+        case VARSELFHATEID:
+            varname = "SELFHATEID";
+            iTmp = pchr->getProfile()->getIDSZ(IDSZ_HATE);
+            break;
 
-            case VARTARGETLIFE:
-                varname = "TARGETLIFE";
-                iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getLife());
-                break;
+        case VARSELFMANA:
+            varname = "SELFMANA";
+            iTmp = FLOAT_TO_FP8(pchr->getMana());
+            if ( pchr->getAttribute(Ego::Attribute::CHANNEL_LIFE) )  iTmp += FLOAT_TO_FP8(pchr->getLife());
 
-            case VARTARGETMANA:
-                varname = "TARGETMANA";
-                if ( NULL == ptarget )
-                {
-                    iTmp = 0;
-                }
-                else
-                {
-                    iTmp = FLOAT_TO_FP8(ptarget->getMana());
-                    if ( ptarget->getAttribute(Ego::Attribute::CHANNEL_LIFE) ) iTmp += FLOAT_TO_FP8(ptarget->getLife());
-                }
+            break;
 
-                break;
+        case VARTARGETSTR:
+            varname = "TARGETSTR";
+            iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::MIGHT));
+            break;
 
-            case VARTARGETLEVEL:
-                varname = "TARGETLEVEL";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->experiencelevel;
-                break;
+        case VARTARGETINT:
+            varname = "TARGETINT";
+            iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::INTELLECT));
+            break;
 
-            case VARTARGETSPEEDX:
-                varname = "TARGETSPEEDX";
-                iTmp = ( NULL == ptarget ) ? 0 : std::abs(ptarget->vel[kX]);
-                break;
+        case VARTARGETDEX:
+            varname = "TARGETDEX";
+            iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::AGILITY));
+            break;
 
-            case VARTARGETSPEEDY:
-                varname = "TARGETSPEEDY";
-                iTmp = ( NULL == ptarget ) ? 0 : std::abs(ptarget->vel[kY]);
-                break;
+        case VARTARGETLIFE:
+            varname = "TARGETLIFE";
+            iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getLife());
+            break;
 
-            case VARTARGETSPEEDZ:
-                varname = "TARGETSPEEDZ";
-                iTmp = ( NULL == ptarget ) ? 0 : std::abs(ptarget->vel[kZ]);
-                break;
+        case VARTARGETMANA:
+            varname = "TARGETMANA";
+            if ( NULL == ptarget )
+            {
+                iTmp = 0;
+            }
+            else
+            {
+                iTmp = FLOAT_TO_FP8(ptarget->getMana());
+                if ( ptarget->getAttribute(Ego::Attribute::CHANNEL_LIFE) ) iTmp += FLOAT_TO_FP8(ptarget->getLife());
+            }
 
-            case VARSELFSPAWNX:
-                varname = "SELFSPAWNX";
-                iTmp = pchr->getSpawnPosition()[kX];
-                break;
+            break;
 
-            case VARSELFSPAWNY:
-                varname = "SELFSPAWNY";
-                iTmp = pchr->getSpawnPosition()[kY];
-                break;
+        case VARTARGETLEVEL:
+            varname = "TARGETLEVEL";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->experiencelevel;
+            break;
 
-            case VARSELFSTATE:
-                varname = "SELFSTATE";
-				iTmp = aiState.state;
-                break;
+        case VARTARGETSPEEDX:
+            varname = "TARGETSPEEDX";
+            iTmp = ( NULL == ptarget ) ? 0 : std::abs(ptarget->vel[kX]);
+            break;
 
-            case VARSELFCONTENT:
-                varname = "SELFCONTENT";
-				iTmp = aiState.content;
-                break;
+        case VARTARGETSPEEDY:
+            varname = "TARGETSPEEDY";
+            iTmp = ( NULL == ptarget ) ? 0 : std::abs(ptarget->vel[kY]);
+            break;
 
-            case VARSELFSTR:
-                varname = "SELFSTR";
-                iTmp = FLOAT_TO_FP8(pchr->getAttribute(Ego::Attribute::MIGHT));
-                break;
+        case VARTARGETSPEEDZ:
+            varname = "TARGETSPEEDZ";
+            iTmp = ( NULL == ptarget ) ? 0 : std::abs(ptarget->vel[kZ]);
+            break;
 
-            case VARSELFINT:
-                varname = "SELFINT";
-                iTmp = FLOAT_TO_FP8(pchr->getAttribute(Ego::Attribute::INTELLECT));
-                break;
+        case VARSELFSPAWNX:
+            varname = "SELFSPAWNX";
+            iTmp = pchr->getSpawnPosition()[kX];
+            break;
 
-            case VARSELFDEX:
-                varname = "SELFDEX";
-                iTmp = FLOAT_TO_FP8(pchr->getAttribute(Ego::Attribute::AGILITY));
-                break;
+        case VARSELFSPAWNY:
+            varname = "SELFSPAWNY";
+            iTmp = pchr->getSpawnPosition()[kY];
+            break;
 
-            case VARSELFMANAFLOW:
-                varname = "SELFMANAFLOW";
-                iTmp = FLOAT_TO_FP8(pchr->getAttribute(Ego::Attribute::SPELL_POWER));
-                break;
+        case VARSELFSTATE:
+            varname = "SELFSTATE";
+            iTmp = aiState.state;
+            break;
 
-            case VARTARGETMANAFLOW:
-                varname = "TARGETMANAFLOW";
-                iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::SPELL_POWER));
-                break;
+        case VARSELFCONTENT:
+            varname = "SELFCONTENT";
+            iTmp = aiState.content;
+            break;
 
-            case VARSELFATTACHED:
-                varname = "SELFATTACHED";
-				iTmp = number_of_attached_particles(aiState.getSelf());
-                break;
+        case VARSELFSTR:
+            varname = "SELFSTR";
+            iTmp = FLOAT_TO_FP8(pchr->getAttribute(Ego::Attribute::MIGHT));
+            break;
 
-            case VARSWINGTURN:
-                varname = "SWINGTURN";
-                {
-					auto camera = CameraSystem::get()->getCamera(aiState.getSelf());
-                    iTmp = nullptr != camera ? camera->getSwing() << 2 : 0;
-                }
-                break;
+        case VARSELFINT:
+            varname = "SELFINT";
+            iTmp = FLOAT_TO_FP8(pchr->getAttribute(Ego::Attribute::INTELLECT));
+            break;
 
-            case VARXYDISTANCE:
-                varname = "XYDISTANCE";
-                iTmp = std::sqrt( state.x * state.x + state.y * state.y );
-                break;
+        case VARSELFDEX:
+            varname = "SELFDEX";
+            iTmp = FLOAT_TO_FP8(pchr->getAttribute(Ego::Attribute::AGILITY));
+            break;
 
-            case VARSELFZ:
-                varname = "SELFZ";
-                iTmp = pchr->getPosZ();
-                break;
+        case VARSELFMANAFLOW:
+            varname = "SELFMANAFLOW";
+            iTmp = FLOAT_TO_FP8(pchr->getAttribute(Ego::Attribute::SPELL_POWER));
+            break;
 
-            case VARTARGETALTITUDE:
-                varname = "TARGETALTITUDE";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->getPosZ() - ptarget->getObjectPhysics().getGroundElevation();
-                break;
+        case VARTARGETMANAFLOW:
+            varname = "TARGETMANAFLOW";
+            iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::SPELL_POWER));
+            break;
 
-            case VARTARGETZ:
-                varname = "TARGETZ";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->getPosZ();
-                break;
+        case VARSELFATTACHED:
+            varname = "SELFATTACHED";
+            iTmp = number_of_attached_particles(aiState.getSelf());
+            break;
 
-            case VARSELFINDEX:
-                varname = "SELFINDEX";
-				iTmp = aiState.getSelf().get();
-                break;
+        case VARSWINGTURN:
+            varname = "SWINGTURN";
+            {
+                auto camera = CameraSystem::get()->getCamera(aiState.getSelf());
+                iTmp = nullptr != camera ? camera->getSwing() << 2 : 0;
+            }
+            break;
 
-            case VAROWNERX:
-                varname = "OWNERX";
-                iTmp = ( NULL == powner ) ? 0 : powner->getPosX();
-                break;
+        case VARXYDISTANCE:
+            varname = "XYDISTANCE";
+            iTmp = std::sqrt( state.x * state.x + state.y * state.y );
+            break;
 
-            case VAROWNERY:
-                varname = "OWNERY";
-                iTmp = ( NULL == powner ) ? 0 : powner->getPosY();
-                break;
+        case VARSELFZ:
+            varname = "SELFZ";
+            iTmp = pchr->getPosZ();
+            break;
 
-            case VAROWNERTURN:
-                varname = "OWNERTURN";
-                iTmp = ( NULL == powner ) ? 0 : powner->ori.facing_z;
-                break;
+        case VARTARGETALTITUDE:
+            varname = "TARGETALTITUDE";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->getPosZ() - ptarget->getObjectPhysics().getGroundElevation();
+            break;
 
-            case VAROWNERDISTANCE:
-                varname = "OWNERDISTANCE";
-                if ( NULL == powner )
-                {
-                    iTmp = 0x7FFFFFFF;
-                }
-                else
-                {
-                    iTmp = std::abs(powner->getPosX() - pchr->getPosX())
-                         + std::abs(powner->getPosY() - pchr->getPosY());
-                }
-                break;
+        case VARTARGETZ:
+            varname = "TARGETZ";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->getPosZ();
+            break;
 
-            case VAROWNERTURNTO:
-                varname = "OWNERTURNTO";
-                if ( NULL == powner )
-                {
-                    iTmp = 0;
-                }
-                else
-                {
-                    iTmp = vec_to_facing( powner->getPosX() - pchr->getPosX() , powner->getPosY() - pchr->getPosY() );
-                    iTmp = Ego::Math::clipBits<16>( iTmp );
-                }
-                break;
+        case VARSELFINDEX:
+            varname = "SELFINDEX";
+            iTmp = aiState.getSelf().get();
+            break;
+
+        case VAROWNERX:
+            varname = "OWNERX";
+            iTmp = ( NULL == powner ) ? 0 : powner->getPosX();
+            break;
+
+        case VAROWNERY:
+            varname = "OWNERY";
+            iTmp = ( NULL == powner ) ? 0 : powner->getPosY();
+            break;
 
-            case VARXYTURNTO:
-                varname = "XYTURNTO";
-                iTmp = vec_to_facing( state.x - pchr->getPosX() , state.y - pchr->getPosY() );
+        case VAROWNERTURN:
+            varname = "OWNERTURN";
+            iTmp = ( NULL == powner ) ? 0 : powner->ori.facing_z;
+            break;
+
+        case VAROWNERDISTANCE:
+            varname = "OWNERDISTANCE";
+            if ( NULL == powner )
+            {
+                iTmp = 0x7FFFFFFF;
+            }
+            else
+            {
+                iTmp = std::abs(powner->getPosX() - pchr->getPosX())
+                     + std::abs(powner->getPosY() - pchr->getPosY());
+            }
+            break;
+
+        case VAROWNERTURNTO:
+            varname = "OWNERTURNTO";
+            if ( NULL == powner )
+            {
+                iTmp = 0;
+            }
+            else
+            {
+                iTmp = vec_to_facing( powner->getPosX() - pchr->getPosX() , powner->getPosY() - pchr->getPosY() );
                 iTmp = Ego::Math::clipBits<16>( iTmp );
-                break;
+            }
+            break;
 
-            case VARSELFMONEY:
-                varname = "SELFMONEY";
-                iTmp = pchr->money;
-                break;
+        case VARXYTURNTO:
+            varname = "XYTURNTO";
+            iTmp = vec_to_facing( state.x - pchr->getPosX() , state.y - pchr->getPosY() );
+            iTmp = Ego::Math::clipBits<16>( iTmp );
+            break;
 
-            case VARSELFACCEL:
-                varname = "SELFACCEL";
-                iTmp = ( pchr->getAttribute(Ego::Attribute::ACCELERATION) * 100.0f );
-                break;
+        case VARSELFMONEY:
+            varname = "SELFMONEY";
+            iTmp = pchr->money;
+            break;
 
-            case VARTARGETEXP:
-                varname = "TARGETEXP";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->experience;
-                break;
+        case VARSELFACCEL:
+            varname = "SELFACCEL";
+            iTmp = ( pchr->getAttribute(Ego::Attribute::ACCELERATION) * 100.0f );
+            break;
 
-            case VARSELFAMMO:
-                varname = "SELFAMMO";
-                iTmp = pchr->ammo;
-                break;
+        case VARTARGETEXP:
+            varname = "TARGETEXP";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->experience;
+            break;
 
-            case VARTARGETAMMO:
-                varname = "TARGETAMMO";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->ammo;
-                break;
+        case VARSELFAMMO:
+            varname = "SELFAMMO";
+            iTmp = pchr->ammo;
+            break;
 
-            case VARTARGETMONEY:
-                varname = "TARGETMONEY";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->money;
-                break;
+        case VARTARGETAMMO:
+            varname = "TARGETAMMO";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->ammo;
+            break;
 
-            case VARTARGETTURNAWAY:
-                varname = "TARGETTURNAWAY";
-                if ( NULL == ptarget )
-                {
-                    iTmp = 0;
-                }
-                else
-                {
-                    iTmp = vec_to_facing( ptarget->getPosX() - pchr->getPosX() , ptarget->getPosY() - pchr->getPosY() );
-                    iTmp = Ego::Math::clipBits<16>( iTmp );
-                }
-                break;
+        case VARTARGETMONEY:
+            varname = "TARGETMONEY";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->money;
+            break;
 
-            case VARSELFLEVEL:
-                varname = "SELFLEVEL";
-                iTmp = pchr->experiencelevel;
-                break;
+        case VARTARGETTURNAWAY:
+            varname = "TARGETTURNAWAY";
+            if ( NULL == ptarget )
+            {
+                iTmp = 0;
+            }
+            else
+            {
+                iTmp = vec_to_facing( ptarget->getPosX() - pchr->getPosX() , ptarget->getPosY() - pchr->getPosY() );
+                iTmp = Ego::Math::clipBits<16>( iTmp );
+            }
+            break;
 
-            case VARTARGETRELOADTIME:
-                varname = "TARGETRELOADTIME";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->reload_timer;
-                break;
+        case VARSELFLEVEL:
+            varname = "SELFLEVEL";
+            iTmp = pchr->experiencelevel;
+            break;
 
-            case VARSPAWNDISTANCE:
-                varname = "SPAWNDISTANCE";
-                iTmp = std::abs( pchr->getSpawnPosition()[kX] - pchr->getPosX() )
-                     + std::abs( pchr->getSpawnPosition()[kY] - pchr->getPosY() );
-                break;
+        case VARTARGETRELOADTIME:
+            varname = "TARGETRELOADTIME";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->reload_timer;
+            break;
 
-            case VARTARGETMAXLIFE:
-                varname = "TARGETMAXLIFE";
-                iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::MAX_LIFE));
-                break;
+        case VARSPAWNDISTANCE:
+            varname = "SPAWNDISTANCE";
+            iTmp = std::abs( pchr->getSpawnPosition()[kX] - pchr->getPosX() )
+                 + std::abs( pchr->getSpawnPosition()[kY] - pchr->getPosY() );
+            break;
 
-            case VARTARGETTEAM:
-                varname = "TARGETTEAM";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->team;
-                //iTmp = REF_TO_INT( chr_get_iteam( pself->target ) );
-                break;
+        case VARTARGETMAXLIFE:
+            varname = "TARGETMAXLIFE";
+            iTmp = ( NULL == ptarget ) ? 0 : FLOAT_TO_FP8(ptarget->getAttribute(Ego::Attribute::MAX_LIFE));
+            break;
 
-            case VARTARGETARMOR:
-                varname = "TARGETARMOR";
-                iTmp = ( NULL == ptarget ) ? 0 : ptarget->skin;
-                break;
+        case VARTARGETTEAM:
+            varname = "TARGETTEAM";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->team;
+            //iTmp = REF_TO_INT( chr_get_iteam( pself->target ) );
+            break;
 
-            case VARDIFFICULTY:
-                varname = "DIFFICULTY";
-                iTmp = static_cast<uint32_t>(egoboo_config_t::get().game_difficulty.getValue());
-                break;
+        case VARTARGETARMOR:
+            varname = "TARGETARMOR";
+            iTmp = ( NULL == ptarget ) ? 0 : ptarget->skin;
+            break;
 
-            case VARTIMEHOURS:
-                varname = "TIMEHOURS";
-                iTmp = Ego::Time::LocalTime().getHours();
-                break;
+        case VARDIFFICULTY:
+            varname = "DIFFICULTY";
+            iTmp = static_cast<uint32_t>(egoboo_config_t::get().game_difficulty.getValue());
+            break;
 
-            case VARTIMEMINUTES:
-                varname = "TIMEMINUTES";
-                iTmp = Ego::Time::LocalTime().getMinutes();
-                break;
+        case VARTIMEHOURS:
+            varname = "TIMEHOURS";
+            iTmp = Ego::Time::LocalTime().getHours();
+            break;
 
-            case VARTIMESECONDS:
-                varname = "TIMESECONDS";
-                iTmp = Ego::Time::LocalTime().getSeconds();
-                break;
+        case VARTIMEMINUTES:
+            varname = "TIMEMINUTES";
+            iTmp = Ego::Time::LocalTime().getMinutes();
+            break;
 
-            case VARDATEMONTH:
-                varname = "DATEMONTH";
-                iTmp = Ego::Time::LocalTime().getMonth() + 1; /// @todo The addition of +1 should be removed and
-				                                              /// the whole Ego::Time::LocalTime class should be
-				                                              /// made available via EgoScript. However, EgoScript
-				                                              /// is not yet ready for that ... not yet.
-                break;
+        case VARTIMESECONDS:
+            varname = "TIMESECONDS";
+            iTmp = Ego::Time::LocalTime().getSeconds();
+            break;
 
-            case VARDATEDAY:
-                varname = "DATEDAY";
-                iTmp = Ego::Time::LocalTime().getDayOfMonth();
-                break;
+        case VARDATEMONTH:
+            varname = "DATEMONTH";
+            iTmp = Ego::Time::LocalTime().getMonth() + 1; /// @todo The addition of +1 should be removed and
+                                                          /// the whole Ego::Time::LocalTime class should be
+                                                          /// made available via EgoScript. However, EgoScript
+                                                          /// is not yet ready for that ... not yet.
+            break;
 
-            default:
-				Log::get().message("%s:%d:%s: script error - model == %d, class name == \"%s\" - Unknown variable found!\n", \
-					               __FILE__, __LINE__, __FUNCTION__, REF_TO_INT(script_error_model), script_error_classname);
-                break;
-        }
+        case VARDATEDAY:
+            varname = "DATEDAY";
+            iTmp = Ego::Time::LocalTime().getDayOfMonth();
+            break;
+
+        default:
+            Log::get().message("%s:%d:%s: script error - model == %d, class name == \"%s\" - Unknown variable found!\n", \
+                               __FILE__, __LINE__, __FUNCTION__, REF_TO_INT(script_error_model), script_error_classname);
+            break;
     }
 
-    // Now do the math
-    op = "UNKNOWN";
+    return iTmp;
+}
+
+//--------------------------------------------------------------------------------------------
+const char *script_state_t::apply_operator( script_state_t& self, Uint8 operation, int32_t value )
+{
+    /// @details This function applies an operator of the scripted arithmetic to the operation sum
+
+    const char *op = "UNKNOWN";
     switch ( operation )
     {
         case OPADD:
             op = "ADD";
-            state.operationsum += iTmp;
+            self.operationsum += value;
             break;
 
         case OPSUB:
             op = "SUB";
-            state.operationsum -= iTmp;
+            self.operationsum -= value;
             break;
 
         case OPAND:
             op = "AND";
-            state.operationsum &= iTmp;
+            self.operationsum &= value;
             break;
 
         case OPSHR:
             op = "SHR";
-            state.operationsum >>= iTmp;
+            self.operationsum >>= value;
             break;
 
         case OPSHL:
             op = "SHL";
-            state.operationsum <<= iTmp;
+            self.operationsum <<= value;
             break;
 
         case OPMUL:
             op = "MUL";
-            state.operationsum *= iTmp;
+            self.operationsum *= value;
             break;
 
         case OPDIV:
             op = "DIV";
-            if ( iTmp != 0 )
+            if ( value != 0 )
             {
-                state.operationsum = static_cast<float>(state.operationsum) / iTmp;
+                self.operationsum = static_cast<float>(self.operationsum) / value;
             }
             else
             {
@@ -1479,9 +1747,9 @@ void script_state_t::run_operand( script_state_t& state, ai_state_t& aiState, sc
 
         case OPMOD:
             op = "MOD";
-            if ( iTmp != 0 )
+            if ( value != 0 )
             {
-                state.operationsum %= iTmp;
+                self.operationsum %= value;
             }
             else
             {
@@ -1496,10 +1764,7 @@ void script_state_t::run_operand( script_state_t& state, ai_state_t& aiState, sc
             break;
     }
 
-    if ( debug_scripts && debug_script_file )
-    {
-        vfs_printf( debug_script_file, "%s %s(%d) ", op, varname, iTmp );
-    }
+    return op;
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1837,12 +2102,14 @@ void ai_state_t::spawn(ai_state_t& self, const ObjectRef index, const PRO_REF io
 //--------------------------------------------------------------------------------------------
 script_state_t::script_state_t()
 	: x(0), y(0), turn(0), distance(0),
-	  argument(0), operationsum(0)
+	  argument(0), operationsum(0),
+	  indent(0), indent_last(0)
 {
 }
 
 script_state_t::script_state_t(const script_state_t& other)
 	: x(other.x), y(other.y), turn(other.turn), distance(other.distance),
-	  argument(other.argument), operationsum(other.operationsum)
+	  argument(other.argument), operationsum(other.operationsum),
+	  indent(other.indent), indent_last(other.indent_last)
 {
 }
@@ -31,6 +31,8 @@
 //--------------------------------------------------------------------------------------------
 
 class Object;
+struct script_state_t;
+struct ai_state_t;
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
@@ -288,15 +290,80 @@ struct InstructionList
 	}
 };
 
+/**
+ * @brief
+ *	An operand of an assignment in a compiled script.
+ */
+struct CompiledOperand
+{
+	/// The operator applied to the operand (OPADD, OPSUB, ...).
+	uint8_t _operator;
+	/// @a true if the operand is a constant, @a false if it is a variable.
+	bool _constant;
+	/// The constant value or the variable (VARTMPX, VARRAND, ...).
+	int32_t _value;
+};
+
+/**
+ * @brief
+ *	An instruction of a compiled script.
+ *	Scripts are compiled once when they are loaded, so running them needs no decoding,
+ *	no function lookups and no jump resolution.
+ */
+struct CompiledInstruction
+{
+	enum class Kind : uint8_t
+	{
+		/// Call a script function, continue with the next instruction on success and jump on failure.
+		Invoke,
+		/// Evaluate a list of operands and assign the result to a variable.
+		Assign,
+	};
+
+	/// The kind of this instruction.
+	Kind _kind;
+	/// The indention level of this instruction.
+	uint8_t _indent;
+	/// Invoke: the value code of the function. Assign: the variable assigned to.
+	uint32_t _value;
+	/// Invoke: the function, @a nullptr if the value code has no function.
+	uint8_t (*_function)(script_state_t&, ai_state_t&);
+	/// @a true if the effects of this instruction are confined to the calling object.
+	/// Such instructions may be run for different objects concurrently.
+	bool _local;
+	/// The index of the next compiled instruction.
+	uint32_t _next;
+	/// Invoke: the index of the compiled instruction to jump to if the function fails.
+	uint32_t _jump;
+	/// Assign: the index of the first operand in the operand list.
+	uint32_t _firstOperand;
+	/// Assign: the number of operands.
+	uint32_t _operandCount;
+};
+
+/**
+ * @brief
+ *	A compiled script, see CompiledInstruction.
+ */
+struct CompiledScript
+{
+	std::vector<CompiledInstruction> _instructions;
+	std::vector<CompiledOperand> _operands;
+
+	void clear() {
+		_instructions.clear();
+		_operands.clear();
+	}
+};
+
 struct script_info_t
 {
 public:
     script_info_t() :
         _name(),
-        indent(0),
-        indent_last(0),
         _position(0),
-        _instructions()
+        _instructions(),
+        _compiled()
     {
         //ctor
     }
@@ -318,10 +385,6 @@ public:
 		return _name;
 	}
 
-    uint32_t        indent;
-    uint32_t        indent_last;
-
-
 	/**
 	 * @brief
 	 *	The instruction index.
@@ -334,6 +397,12 @@ public:
 	 */
 	InstructionList _instructions;
 
+	/**
+	 * @brief
+	 *	The compiled form of the instruction list, which is what is actually run.
+	 */
+	CompiledScript _compiled;
+
 	bool increment_pos();
 	size_t get_pos() const;
 	bool set_pos(size_t position);
@@ -419,6 +488,10 @@ struct script_state_t
     int argument;
     int operationsum;
 
+    // used by the Else function
+    uint32_t indent;
+    uint32_t indent_last;
+
 	// public
 	script_state_t();
 	script_state_t(const script_state_t& self);
@@ -426,6 +499,9 @@ struct script_state_t
 	static Uint8 run_function(script_state_t& self, ai_state_t& aiState, script_info_t& script);
 	static void set_operand(script_state_t& self, Uint8 variable);
 	static void run_operand(script_state_t& self, ai_state_t& aiState, script_info_t * pscript);
+	static int32_t get_variable(script_state_t& self, ai_state_t& aiState, Object *pchr, Object *ptarget, Object *powner, Uint8 variable, const char *& varname);
+	static const char *apply_operator(script_state_t& self, Uint8 operation, int32_t value);
+	static Uint8 run_unresolved_function(script_info_t& script, Uint32 valuecode);
 	static bool run_operation(script_state_t& self, ai_state_t& aiState, script_info_t& script);
 	static bool run_function_call(script_state_t& self, ai_state_t& aiState, script_info_t& script);
 };
@@ -434,9 +510,53 @@ struct script_state_t
 // FUNCTION PROTOTYPES
 //--------------------------------------------------------------------------------------------
 
+/// The alerts a script run has seen.
+/// @details Alerts raised on a character by other scripts after the local part of its run was done
+/// are not seen by that run, so they are kept for its next run.
+struct script_alerts_t
+{
+    /// The alerts of the character when the local part of the run was done.
+    BIT_FIELD _seen;
+
+    script_alerts_t() : _seen(EMPTY_BIT_FIELD) {}
+
+    /// Remember the alerts seen by the local part of the run.
+    void see(BIT_FIELD alert) { _seen = alert; }
+
+    /// Clear the alerts seen by the run and the alerts the rest of the run raised itself.
+    /// @param alert the alerts of the character
+    /// @param before the alerts of the character before the rest of the run
+    void clear(BIT_FIELD& alert, BIT_FIELD before) const { UNSET_BIT(alert, _seen | (alert & ~before)); }
+};
+
+/// A run of the script of a character which has been started but not finished.
+/// @details The think phase runs the local part of all scripts concurrently and then finishes
+/// the scripts one after another in object order.
+struct script_run_t
+{
+    /// The script state at the point where the run was stopped.
+    script_state_t _state;
+    /// The compiled instruction at which the run continues.
+    uint32_t _position;
+    /// @a true if the run was started and needs to be finished.
+    bool _pending;
+    /// The alerts seen by the run.
+    script_alerts_t _alerts;
+
+    script_run_t() : _state(), _position(0), _pending(false), _alerts() {}
+};
+
 void scr_run_chr_script(Object *pchr);
 void scr_run_chr_script(const ObjectRef character);
 
+/// Start running the script of a character and run it until the first instruction which has
+/// effects beyond the character itself. May be called for different characters concurrently.
+/// @remark The scripting system must have been started and script tracing must be disabled.
+void scr_run_chr_script_local(Object *pchr, script_run_t& run);
+/// Finish a script run started by scr_run_chr_script_local, set the latches of the character
+/// and clear the alerts seen by the run.
+void scr_finish_chr_script(Object *pchr, script_run_t& run);
+
 void issue_order( const ObjectRef character, Uint32 order );
 void issue_special_order( Uint32 order, IDSZ idsz );
 void set_alerts( const ObjectRef character );
@@ -489,6 +609,12 @@ public:
 	 *	A map from function value codes to function pointers.
 	 */
 	std::unordered_map<uint32_t, NativeInterface::Function *> _functionValueCodeToFunctionPointer;
+	/**
+	 * @brief
+	 *	The value codes of the functions which only read the world and modify nothing but the
+	 *	AI state of the calling object and the script state. All other functions may have any effect.
+	 */
+	std::unordered_set<uint32_t> _localFunctionValueCodes;
 };
 
 } // namespace Script
@@ -84,6 +84,7 @@ egoboo_config_t::egoboo_config_t() :
     graphic_simultaneousDynamicLights_max(32, "graphic.simultaneousDynamicLights.max", "inclusive upper bound of simultaneous dynamic lights"),
     graphic_framesPerSecond_max(30, "graphic.framesPerSecond.max", "inclusive upper bound of frames per second"),
     graphic_simultaneousParticles_max(768, "graphic.simultaneousParticles.max", "inclusive upper bound of simultaneous particles"),
+    graphic_textureUpload_budget(4, "graphic.textureUpload.budget", "milliseconds per frame spent uploading textures loaded in the background"),
     // Sound configuration section.
     sound_effects_enable(true, "sound.effects.enable", "enable/disable effects"),
     sound_effects_volume(90, "sound.effects.volume", "effects volume"),
@@ -108,6 +109,11 @@ egoboo_config_t::egoboo_config_t() :
         { "Normal", Ego::GameDifficulty::Normal },
         { "Hard", Ego::GameDifficulty::Hard },
     }),
+    game_parallelUpdate_enable(true, "game.parallelUpdate.enable", "enable/disable spreading game logic updates over multiple threads"),
+    game_parallelUpdate_workerCount(0, "game.parallelUpdate.workerCount", "number of worker threads used for game logic updates.\n"
+    "A value of 0 uses one worker thread less than the number of hardware threads"),
+    game_pathfinding_nodeBudget(4096, "game.pathfinding.nodeBudget", "maximum number of tiles a single path search may expand"),
+    game_activityScheduling_enable(true, "game.activityScheduling.enable", "enable/disable updating objects far away from any player at a reduced rate"),
     // Camera configuration section.
     camera_control(CameraTurnMode::Auto, "camera.control", "type of camera control",
     {
@@ -134,7 +140,8 @@ egoboo_config_t::egoboo_config_t() :
     debug_hideMouse(true,"debug.hideMouse","show/hide mouse"),
     debug_grabMouse(true,"debug.grabMouse","grab/don't grab mouse"),
     debug_developerMode_enable(false,"debug.developerMode.enable","enable/disable developer mode"),
-    debug_sdlImage_enable(true,"debug.SDL_Image.enable","enable/disable advanced SDL_image function")
+    debug_sdlImage_enable(true,"debug.SDL_Image.enable","enable/disable advanced SDL_image function"),
+    debug_scriptProfiling_enable(false,"debug.scriptProfiling.enable","enable/disable timing of AI scripts and script functions")
 {}
 
 egoboo_config_t::~egoboo_config_t()
@@ -169,6 +176,7 @@ egoboo_config_t& egoboo_config_t::operator=(const egoboo_config_t& other)
     graphic_simultaneousDynamicLights_max = other.graphic_simultaneousDynamicLights_max;
     graphic_framesPerSecond_max = other.graphic_framesPerSecond_max;
     graphic_simultaneousParticles_max = other.graphic_simultaneousParticles_max;
+    graphic_textureUpload_budget = other.graphic_textureUpload_budget;
 
     // Sound configuration section.
     sound_effects_enable = other.sound_effects_enable;
@@ -192,6 +200,10 @@ egoboo_config_t& egoboo_config_t::operator=(const egoboo_config_t& other)
 
     // Game configuration section.
     game_difficulty = other.game_difficulty;
+    game_parallelUpdate_enable = other.game_parallelUpdate_enable;
+    game_parallelUpdate_workerCount = other.game_parallelUpdate_workerCount;
+    game_pathfinding_nodeBudget = other.game_pathfinding_nodeBudget;
+    game_activityScheduling_enable = other.game_activityScheduling_enable;
     
     // HUD configuration section.
     hud_displayGameTime = other.hud_displayGameTime;
@@ -209,6 +221,7 @@ egoboo_config_t& egoboo_config_t::operator=(const egoboo_config_t& other)
     debug_grabMouse = other.debug_grabMouse;
     debug_developerMode_enable = other.debug_developerMode_enable;
     debug_sdlImage_enable = other.debug_sdlImage_enable;
+    debug_scriptProfiling_enable = other.debug_scriptProfiling_enable;
 
     return *this;
 }
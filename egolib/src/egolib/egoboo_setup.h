@@ -533,6 +533,7 @@ public:
             graphic_simultaneousDynamicLights_max,
             graphic_framesPerSecond_max,
             graphic_simultaneousParticles_max,
+            graphic_textureUpload_budget,
             //
             sound_effects_enable,
             sound_effects_volume,
@@ -549,6 +550,10 @@ public:
             network_playerName,
             //
             game_difficulty,
+            game_parallelUpdate_enable,
+            game_parallelUpdate_workerCount,
+            game_pathfinding_nodeBudget,
+            game_activityScheduling_enable,
             //
             camera_control,
             //
@@ -565,7 +570,8 @@ public:
             debug_hideMouse,
             debug_grabMouse,
             debug_developerMode_enable,
-            debug_sdlImage_enable
+            debug_sdlImage_enable,
+            debug_scriptProfiling_enable
             );
         for_each(variables, f);
     }
@@ -796,6 +802,15 @@ public:
      */
     StandardVariable<uint16_t> graphic_simultaneousParticles_max;
 
+    /**
+     * @brief
+     *  Time in milliseconds per frame spent on uploading textures which were decoded in the background.
+     *  At least one texture is uploaded per frame.
+     * @remark
+     *  Default value is @a 4.
+     */
+    StandardVariable<uint16_t> graphic_textureUpload_budget;
+
     // Sound configuration section.
 
     /**
@@ -936,6 +951,40 @@ public:
      */
     EnumVariable<Ego::GameDifficulty> game_difficulty;
 
+    /**
+     * @brief
+     *  Enable/disable spreading game logic updates over multiple threads.
+     *  If disabled, every update job runs on the main thread.
+     * @remark
+     *  Default value is @a true.
+     */
+    StandardVariable<bool> game_parallelUpdate_enable;
+
+    /**
+     * @brief
+     *  Number of worker threads used for game logic updates.
+     * @remark
+     *  Default value is @a 0 which selects one thread less than the number of hardware threads.
+     */
+    StandardVariable<uint16_t> game_parallelUpdate_workerCount;
+
+    /**
+     * @brief
+     *  Maximum number of tiles a single path search may expand.
+     *  Raise this for large modules if characters fail to find paths.
+     * @remark
+     *  Default value is @a 4096.
+     */
+    StandardVariable<uint32_t> game_pathfinding_nodeBudget;
+
+    /**
+     * @brief
+     *  Enable/disable running scripts and physics of objects far away from any player at a reduced rate.
+     * @remark
+     *  Default value is @a true.
+     */
+    StandardVariable<bool> game_activityScheduling_enable;
+
     // HUD configuration section.
 
     /**
@@ -1049,6 +1098,14 @@ public:
      */
     StandardVariable<bool> debug_sdlImage_enable;
 
+    /**
+     * @brief
+     *  Enable/disable timing of AI scripts and script functions.
+     * @remark
+     *  Default value is @a false.
+     */
+    StandardVariable<bool> debug_scriptProfiling_enable;
+
 public:
 
     /**
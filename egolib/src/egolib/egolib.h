@@ -87,6 +87,7 @@
 #include "egolib/Graphics/TextureManager.hpp"
 #include "egolib/Graphics/PixelFormat.hpp"
 #include "egolib/Graphics/VertexBuffer.hpp"
+#include "egolib/Graphics/VertexArena.hpp"
 #include "egolib/Graphics/ModelDescriptor.hpp"
 
 //--------------------------------------------------------------------------------------------
@@ -84,7 +84,7 @@
  * @ingroup
  *  compile-time
  */
-#define PARTICLES_MAX 2048
+#define PARTICLES_MAX 32768
 
 /**
  * @brief
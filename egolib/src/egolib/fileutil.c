@@ -1637,6 +1637,39 @@ bool ego_texture_exists_vfs(const std::string &filename)
     return false;
 }
 
+std::shared_ptr<SDL_Surface> ego_texture_decode_vfs(const std::string &filename, std::string &fullFilename)
+{
+    // Try all different formats.
+    for (const auto& loader : ImageManager::get())
+    {
+        // Build the full file name.
+        fullFilename = filename + loader.getExtension();
+        // Open the file.
+        vfs_FILE *file = vfs_openRead(fullFilename);
+        if (!file)
+        {
+            continue;
+        }
+        // Stream the surface.
+        std::shared_ptr<SDL_Surface> surface = nullptr;
+        try
+        {
+            surface = loader.load(file);
+        }
+        catch (...)
+        {
+            surface = nullptr;
+        }
+        vfs_close(file);
+        if (surface)
+        {
+            return surface;
+        }
+    }
+    fullFilename.clear();
+    return nullptr;
+}
+
 bool  ego_texture_load_vfs(Ego::Texture *texture, const char *filename, Uint32 key)
 {
     // Get rid of any old data.
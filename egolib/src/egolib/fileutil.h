@@ -472,6 +472,21 @@ bool copy_to_delimiter_vfs(vfs_FILE * fileread, vfs_FILE * filewrite, int delim,
  */
 bool ego_texture_load_vfs(Ego::Texture *texture, const char *filename, uint32_t key = INVALID_KEY);
 
+/**
+ * @brief
+ *  Decode an image without creating a texture from it.
+ * @param filename
+ *  the filename of the image <em>without</em> extension.
+ * @param [out] fullFilename
+ *  the filename of the decoded image <em>with</em> extension
+ * @return
+ *  the decoded image or @a nullptr if no combination of the filename and a supported
+ *  file extension could be decoded
+ * @remark
+ *  This function does not use the OpenGL context and may be called from any thread.
+ */
+std::shared_ptr<SDL_Surface> ego_texture_decode_vfs(const std::string &filename, std::string &fullFilename);
+
 bool ego_texture_exists_vfs(const std::string &filename);
 
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
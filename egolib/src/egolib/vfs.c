@@ -66,6 +66,9 @@ typedef char VFS_PATH[VFS_MAX_PATH];
 
 #define MAX_MOUNTINFO 128
 
+/// The size of the read-ahead buffer of a file opened for reading.
+#define VFS_READ_BUFFER_SIZE (16 * 1024)
+
 /// The following flags set in vfs_file::flags provide information about the state of a file.
 typedef enum vfs_file_flags
 {
@@ -299,6 +302,9 @@ vfs_FILE *vfs_openRead(const std::string& pathname)
         return nullptr;
     }
 
+    // Read ahead, so that reading single values or characters does not go to the archive or the disk every time.
+    PHYSFS_setBuffer(ftmp, VFS_READ_BUFFER_SIZE);
+
     vfs_file->flags = VFS_FILE_FLAG_READING;
     vfs_file->type = VFS_FILE_TYPE_PHYSFS;
     vfs_file->ptr.p = ftmp;
@@ -1397,6 +1403,42 @@ int vfs_read_float( vfs_FILE& file, float * val )
     return retval;
 }
 
+//--------------------------------------------------------------------------------------------
+size_t vfs_read_Uint32_array( vfs_FILE& file, Uint32 * values, size_t count )
+{
+    BAIL_IF_NOT_INIT();
+
+    size_t read_count = vfs_read( values, sizeof( Uint32 ), count, &file );
+
+    // a no-op on little-endian systems
+    for ( size_t cnt = 0; cnt < read_count; cnt++ )
+    {
+        values[cnt] = ENDIAN_TO_SYS_INT32( values[cnt] );
+    }
+
+    return read_count;
+}
+
+size_t vfs_read_float_array( vfs_FILE& file, float * values, size_t count )
+{
+    static_assert( sizeof( float ) == sizeof( Uint32 ), "float is not 32 bit wide" );
+
+    BAIL_IF_NOT_INIT();
+
+    size_t read_count = vfs_read( values, sizeof( float ), count, &file );
+
+    // a no-op on little-endian systems
+    for ( size_t cnt = 0; cnt < read_count; cnt++ )
+    {
+        Uint32 bits;
+        memcpy( &bits, values + cnt, sizeof( bits ) );
+        bits = ENDIAN_TO_SYS_INT32( bits );
+        memcpy( values + cnt, &bits, sizeof( bits ) );
+    }
+
+    return read_count;
+}
+
 //--------------------------------------------------------------------------------------------
 
 
@@ -1952,6 +1994,27 @@ char ** vfs_enumerateFiles( const char * dir_name )
     return PHYSFS_enumerateFiles( vfs_convert_fname( dir_name ) );
 }
 
+//--------------------------------------------------------------------------------------------
+std::unordered_set<std::string> vfs_listDirectory(const std::string& pathname)
+{
+    BAIL_IF_NOT_INIT();
+
+    std::unordered_set<std::string> names;
+    std::string temporary;
+    if (!validate(pathname, temporary)) {
+        return names;
+    }
+
+    char **list = PHYSFS_enumerateFiles(temporary.c_str());
+    if (nullptr != list) {
+        for (char **name = list; nullptr != *name; ++name) {
+            names.insert(*name);
+        }
+        PHYSFS_freeList(list);
+    }
+    return names;
+}
+
 //--------------------------------------------------------------------------------------------
 void    vfs_freeList( void * listVar )
 {
@@ -3051,7 +3114,8 @@ bool vfs_readEntireFile(const std::string& pathname, char **data, size_t *length
     else
     {
         size_t pos = 0;
-        char *buffer = (char *) malloc(fileLen);
+        // allocate at least one Byte, so that an empty file does not look like an allocation failure
+        char *buffer = (char *) malloc(std::max<long>(fileLen, 1));
         if (buffer == nullptr)
         {
             vfs_close(file);
@@ -239,6 +239,18 @@ int vfs_read_Sint64(vfs_FILE& file, Sint64 *val);
 int vfs_read_Uint64(vfs_FILE& file, Uint64 *val);
 int vfs_read_float(vfs_FILE& file, float *val);
 
+/**
+ * @brief
+ *  Read an array of little-endian values with a single read.
+ * @param values
+ *  a pointer to an array which can accomodate @a count values
+ * @return
+ *  the number of values read, less than @a count if the end of the file or an error was encountered
+ */
+size_t vfs_read_Uint32_array(vfs_FILE& file, Uint32 *values, size_t count);
+/** @copydoc vfs_read_Uint32_array */
+size_t vfs_read_float_array(vfs_FILE& file, float *values, size_t count);
+
 size_t vfs_write(const void *buffer, size_t size, size_t count, vfs_FILE *file);
 
 template <typename Type>
@@ -265,6 +277,15 @@ int vfs_write<float>(vfs_FILE& file, const float& val);
 
 /// the file searching routines
 char **vfs_enumerateFiles(const char *directory);
+/**
+ * @brief
+ *  Get the names of all files and directories in a directory.
+ * @return
+ *  the names, empty if the directory does not exist
+ * @remark
+ *  Unlike vfs_enumerateFiles, this function is thread-safe.
+ */
+std::unordered_set<std::string> vfs_listDirectory(const std::string& pathname);
 void vfs_freeList(void *listVar);
 
 const char *vfs_search_context_get_current(struct s_vfs_search_context *ctxt);
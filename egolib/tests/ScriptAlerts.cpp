@@ -0,0 +1,87 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Script/script.h"
+
+EgoTest_DeclareTestCase(ScriptAlerts)
+EgoTest_EndDeclaration()
+
+EgoTest_BeginTestCase(ScriptAlerts)
+
+EgoTest_Test(seenAlertsAreCleared)
+{
+    BIT_FIELD alert = ALERTIF_SPAWNED | ALERTIF_BUMPED;
+
+    // The local part of the run sees the alerts, the rest of the run raises none.
+    script_alerts_t alerts;
+    alerts.see(alert);
+    const BIT_FIELD before = alert;
+    alerts.clear(alert, before);
+
+    EgoTest_Assert(EMPTY_BIT_FIELD == alert);
+}
+
+EgoTest_Test(ownAlertsAreCleared)
+{
+    BIT_FIELD alert = EMPTY_BIT_FIELD;
+
+    script_alerts_t alerts;
+    alerts.see(alert);
+    const BIT_FIELD before = alert;
+
+    // The rest of the run orders its own team, which includes itself.
+    SET_BIT(alert, ALERTIF_ORDERED);
+    alerts.clear(alert, before);
+
+    EgoTest_Assert(EMPTY_BIT_FIELD == alert);
+}
+
+EgoTest_Test(alertsFromOtherScriptsInTheSameUpdateAreKept)
+{
+    // Both characters run the local part of their scripts first.
+    BIT_FIELD alertA = EMPTY_BIT_FIELD;
+    BIT_FIELD alertB = ALERTIF_BUMPED;
+    script_alerts_t alertsA, alertsB;
+    alertsA.see(alertA);
+    alertsB.see(alertB);
+
+    // The script of A is finished first: It orders B and damages B.
+    const BIT_FIELD beforeA = alertA;
+    SET_BIT(alertB, ALERTIF_ORDERED);
+    SET_BIT(alertB, ALERTIF_ATTACKED);
+    alertsA.clear(alertA, beforeA);
+
+    // The script of B is finished next. Its local part did not see the order and the attack.
+    const BIT_FIELD beforeB = alertB;
+    alertsB.clear(alertB, beforeB);
+
+    EgoTest_Assert(HAS_NO_BITS(alertB, ALERTIF_BUMPED));
+    EgoTest_Assert(HAS_SOME_BITS(alertB, ALERTIF_ORDERED));
+    EgoTest_Assert(HAS_SOME_BITS(alertB, ALERTIF_ATTACKED));
+
+    // The next run of B sees them and clears them.
+    alertsB.see(alertB);
+    const BIT_FIELD nextB = alertB;
+    alertsB.clear(alertB, nextB);
+    EgoTest_Assert(EMPTY_BIT_FIELD == alertB);
+}
+
+EgoTest_EndTestCase()
@@ -0,0 +1,142 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Core/SpatialHash.hpp"
+
+namespace {
+
+class SpatialHashElement
+{
+public:
+    SpatialHashElement(float x, float y, float size) : _bounds(Vector2f(x-size, y-size), Vector2f(x+size, y+size))
+    {
+        //ctor
+    }
+
+    AABB2f getAABB2D() const { return _bounds; }
+
+    void moveTo(float x, float y, float size)
+    {
+        _bounds = AABB2f(Vector2f(x-size, y-size), Vector2f(x+size, y+size));
+    }
+
+private:
+    AABB2f _bounds;
+};
+
+size_t count(const Ego::SpatialHash<SpatialHashElement>& grid, float x, float y, float distance)
+{
+    std::vector<std::shared_ptr<SpatialHashElement>> result;
+    grid.find(AABB2f(Vector2f(x-distance, y-distance), Vector2f(x+distance, y+distance)), result);
+    return result.size();
+}
+
+}
+
+EgoTest_DeclareTestCase(SpatialHash)
+EgoTest_EndDeclaration()
+
+EgoTest_BeginTestCase(SpatialHash)
+
+EgoTest_Test(find)
+{
+    Ego::SpatialHash<SpatialHashElement> grid(32.0f);
+    std::vector<std::shared_ptr<SpatialHashElement>> elements;
+
+    //Put a fat element in the middle of the grid, covering several cells
+    elements.push_back(std::make_shared<SpatialHashElement>(128, 128, 40));
+
+    //Put one element in each corner
+    elements.push_back(std::make_shared<SpatialHashElement>(0, 0, 5));
+    elements.push_back(std::make_shared<SpatialHashElement>(256, 0, 5));
+    elements.push_back(std::make_shared<SpatialHashElement>(0, 256, 5));
+    elements.push_back(std::make_shared<SpatialHashElement>(256, 256, 5));
+
+    grid.clear(0, 0, 256, 256);
+    for (const auto& element : elements) {
+        EgoTest_Assert(grid.insert(element));
+    }
+    EgoTest_Assert(grid.size() == elements.size());
+
+    //Searching outside the grid should produce no results
+    EgoTest_Assert(count(grid, -50, -50, 20) == 0);
+
+    //Searching around each corner should find one element
+    EgoTest_Assert(count(grid, 0, 0, 50) == 1);
+    EgoTest_Assert(count(grid, 256, 0, 50) == 1);
+    EgoTest_Assert(count(grid, 0, 256, 50) == 1);
+    EgoTest_Assert(count(grid, 256, 256, 50) == 1);
+
+    //Searching in the middle should find the fat element exactly once
+    EgoTest_Assert(count(grid, 128, 128, 50) == 1);
+
+    //Searching the whole grid should find all elements exactly once
+    EgoTest_Assert(count(grid, 128, 128, 128) == elements.size());
+}
+
+EgoTest_Test(rebuild)
+{
+    Ego::SpatialHash<SpatialHashElement> grid(32.0f);
+    std::vector<std::shared_ptr<SpatialHashElement>> elements;
+    for (size_t i = 0; i < 100; ++i) {
+        elements.push_back(std::make_shared<SpatialHashElement>(Random::next(10, 100), Random::next(10, 100), 10));
+    }
+
+    //Build the grid with all elements in the top left corner
+    grid.clear(0, 0, 256, 256);
+    for (const auto& element : elements) {
+        EgoTest_Assert(grid.insert(element));
+    }
+    std::vector<std::shared_ptr<SpatialHashElement>> result;
+    grid.find(AABB2f(Vector2f(0, 0), Vector2f(127, 127)), result);
+    EgoTest_Assert(result.size() == elements.size());
+
+    //Now move all elements into the bottom right corner and rebuild the grid
+    for (const auto& element : elements) {
+        element->moveTo(Random::next(150, 240), Random::next(150, 240), 10);
+    }
+    grid.clear(0, 0, 256, 256);
+    for (const auto& element : elements) {
+        EgoTest_Assert(grid.insert(element));
+    }
+    EgoTest_Assert(grid.size() == elements.size());
+
+    //All elements should be found in the bottom right now, each exactly once
+    result.clear();
+    grid.find(AABB2f(Vector2f(128, 128), Vector2f(256, 256)), result);
+    EgoTest_Assert(result.size() == elements.size());
+
+    //The old area in the top left must not keep any stale entries
+    result.clear();
+    grid.find(AABB2f(Vector2f(0, 0), Vector2f(127, 127)), result);
+    EgoTest_Assert(result.empty());
+
+    //If we look at the top half, we should find nothing
+    result.clear();
+    grid.find(AABB2f(Vector2f(0, 0), Vector2f(256, 127)), result);
+    EgoTest_Assert(result.empty());
+
+    //Elements outside of the grid are not added
+    EgoTest_Assert(!grid.insert(std::make_shared<SpatialHashElement>(-100, -100, 10)));
+    EgoTest_Assert(grid.size() == elements.size());
+}
+
+EgoTest_EndTestCase()
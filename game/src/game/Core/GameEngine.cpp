@@ -31,6 +31,9 @@
 #include "game/game.h"
 #include "game/Entities/_Include.hpp"
 #include "game/Physics/CollisionSystem.hpp"
+#include "egolib/Core/JobSystem.hpp"
+#include "egolib/Renderer/Null/Renderer.hpp"
+#include "game/graphic_billboard.h"
 
 //Global singelton
 std::unique_ptr<GameEngine> _gameEngine;
@@ -56,6 +59,8 @@ GameEngine::GameEngine() :
 	_currentGameState(nullptr),
     _clearGameStateStackRequested(false),
 	_config(),
+    _replayMode(ReplaySystem::Mode::Off),
+    _replayPathname(),
     _drawCursor(true),
     _screenshotReady(true),
     _screenshotRequested(false),
@@ -217,6 +222,9 @@ void GameEngine::updateOneFrame()
 
 void GameEngine::renderOneFrame()
 {
+    // release the transient vertices of the last frame
+    Ego::VertexArena::get().reset();
+
     // clear the screen
     gfx_request_clear_screen();
     gfx_do_clear_screen();
@@ -260,7 +268,10 @@ void GameEngine::renderPreloadText(const std::string &text)
     static std::string preloadText("");
 
     preloadText += text + "\n";
-    
+
+    // release the transient vertices of the last frame
+    Ego::VertexArena::get().reset();
+
     gfx_request_clear_screen();
     gfx_do_clear_screen();
 
@@ -358,9 +369,15 @@ bool GameEngine::initialize()
     Ego::Core::Singleton<ParticleProfileSystem>::initialize(); //explicit static member call to avoid ambigious call
     ProfileSystem::initialize();
 
+    // Initialize the job system for parallel game logic updates.
+    Ego::Core::JobSystem::initialize();
+
     // Initialize the collision system.
     Ego::Physics::CollisionSystem::initialize();
 
+    // Initialize the replay system.
+    initializeReplay();
+
     // Load all modules
     renderPreloadText("Loading modules...");
     ProfileSystem::get().loadModuleProfiles();
@@ -399,9 +416,15 @@ void GameEngine::uninitialize()
     // @todo This should be 'UIManager::uninitialize'.
     _uiManager.reset(nullptr);
 
+    // Uninitialize the replay system.
+    ReplaySystem::uninitialize();
+
     // Uninitialize the collision system.
     Ego::Physics::CollisionSystem::uninitialize();
 
+    // Uninitialize the job system.
+    Ego::Core::JobSystem::uninitialize();
+
     // Uninitialize the scripting system.
     scripting_system_end();
 
@@ -430,6 +453,131 @@ void GameEngine::uninitialize()
 	Log::get().message("Exiting Egoboo %s. See you next time\n", GAME_VERSION.c_str());
 }
 
+bool GameEngine::runHeadless(const std::string& moduleName, uint32_t updateCount)
+{
+    // Set up everything the game logic needs as initialize() does,
+    // but replace the window and OpenGL by the null renderer.
+    CameraSystem::getCameraOptions().turnMode = egoboo_config_t::get().camera_control.getValue();
+    gfx_config_t::download(gfx, egoboo_config_t::get());
+    oglx_texture_parameters_t::download(g_ogl_textureParameters, egoboo_config_t::get());
+
+    InputSystem::initialize();
+    ImageManager::initialize();
+
+    Ego::RendererFactory::setBackend(Ego::RendererFactory::Backend::Null);
+    Ego::Renderer::initialize();
+    TextureManager::initialize();
+    Ego::VertexArena::initialize();
+    dolist_mgr_t::initialize();
+    renderlist_mgr_t::initialize();
+    BillboardSystem::initialize();
+
+    // The cameras are set up for a screen of the configured size.
+    sdl_scr.x = egoboo_config_t::get().graphic_resolution_horizontal.getValue();
+    sdl_scr.y = egoboo_config_t::get().graphic_resolution_vertical.getValue();
+
+    AudioSystem::initialize();
+    ParticleHandler::initialize();
+    config_synch(&egoboo_config_t::get(), false, false);
+    init_random_treasure_tables_vfs("mp_data/randomtreasure.txt");
+    Ego::Perks::PerkHandler::initialize();
+    Ego::Core::Singleton<ParticleProfileSystem>::initialize(); //explicit static member call to avoid ambigious call
+    ProfileSystem::initialize();
+    Ego::Core::JobSystem::initialize();
+    Ego::Physics::CollisionSystem::initialize();
+    initializeReplay();
+    ProfileSystem::get().loadModuleProfiles();
+
+    std::shared_ptr<ModuleProfile> module = nullptr;
+    for (const std::shared_ptr<ModuleProfile>& candidate : ProfileSystem::get().getModuleProfiles())
+    {
+        if (candidate->getFolderName() == moduleName || candidate->getFolderName() == moduleName + ".mod")
+        {
+            module = candidate;
+            break;
+        }
+    }
+
+    bool result = false;
+    if (!module)
+    {
+        Log::get().error("headless: module `%s` not found\n", moduleName.c_str());
+    }
+    else
+    {
+        make_turntosin();
+        gfx_system_make_enviro();
+        if (!game_begin_module(module))
+        {
+            Log::get().error("headless: failed to load module `%s`\n", moduleName.c_str());
+        }
+        else
+        {
+            std::shared_ptr<CameraSystem> cameraSystem = CameraSystem::request(local_stats.player_count);
+
+            // Run the updates back to back.
+            _startupTimestamp = std::chrono::high_resolution_clock::now();
+            for (uint32_t i = 0; i < updateCount; ++i)
+            {
+                update_game();
+            }
+            const double seconds = getMicros() / 1000000.0;
+
+            Log::get().info("headless: %u updates of module `%s` in %.3f s (%.1f updates per second)\n",
+                            static_cast<unsigned int>(updateCount), moduleName.c_str(), seconds, seconds > 0.0 ? updateCount / seconds : 0.0);
+            Log::get().info("headless: %" PRIuZ " objects, %" PRIuZ " particles\n",
+                            _currentModule->getObjectHandler().getObjectCount(), ParticleHandler::get().getCount());
+            log_update_timings();
+
+            const auto& renderer = static_cast<const Ego::Null::Renderer&>(Ego::Renderer::get());
+            Log::get().info("headless: %" PRIuZ " render calls, %" PRIuZ " textures created\n",
+                            renderer.getRenderCount(), renderer.getTextureCount());
+
+            cameraSystem.reset();
+            game_quit_module();
+            result = true;
+        }
+    }
+
+    // Tear down in reverse order.
+    ReplaySystem::uninitialize();
+    Ego::Physics::CollisionSystem::uninitialize();
+    Ego::Core::JobSystem::uninitialize();
+    scripting_system_end();
+    ProfileSystem::uninitialize();
+    ParticleHandler::uninitialize();
+    AudioSystem::uninitialize();
+    BillboardSystem::uninitialize();
+    renderlist_mgr_t::uninitialize();
+    dolist_mgr_t::uninitialize();
+    Ego::VertexArena::uninitialize();
+    TextureManager::uninitialize();
+    Ego::Renderer::uninitialize();
+    ImageManager::uninitialize();
+    InputSystem::uninitialize();
+
+    return result;
+}
+
+void GameEngine::setReplay(ReplaySystem::Mode mode, const std::string& pathname)
+{
+    _replayMode = mode;
+    _replayPathname = pathname;
+}
+
+void GameEngine::initializeReplay()
+{
+    ReplaySystem::initialize();
+    if (ReplaySystem::Mode::Record == _replayMode)
+    {
+        ReplaySystem::get().startRecording(_replayPathname);
+    }
+    else if (ReplaySystem::Mode::Playback == _replayMode)
+    {
+        ReplaySystem::get().startPlayback(_replayPathname);
+    }
+}
+
 void GameEngine::setGameState(std::shared_ptr<GameState> gameState)
 {
     _clearGameStateStackRequested = true;
@@ -558,17 +706,66 @@ std::shared_ptr<PlayingState> GameEngine::getActivePlayingState() const
  *  the command-line arguments (a static constant array of @a argc pointers to static constant zero-terminated strings)
  * @return
  *  EXIT_SUCCESS upon regular termination, EXIT_FAILURE otherwise
+ * @remark
+ *  <tt>--headless &lt;module&gt; [&lt;updates&gt;]</tt> runs the game logic of a module without a window
+ *  for a number of updates (default 1000) and logs the timings, see GameEngine::runHeadless.
+ *  <tt>--record &lt;file&gt;</tt> and <tt>--playback &lt;file&gt;</tt> record the first module started
+ *  into a replay file or play it back, see ReplaySystem.
  */
 int SDL_main(int argc, char **argv)
 {
+    // Parse the command-line arguments.
+    bool headless = false;
+    std::string headlessModule;
+    uint32_t headlessUpdates = 1000;
+    ReplaySystem::Mode replayMode = ReplaySystem::Mode::Off;
+    std::string replayPathname;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (0 == strcmp(argv[i], "--headless") && i + 1 < argc)
+        {
+            headless = true;
+            headlessModule = argv[++i];
+            if (i + 1 < argc && isdigit(argv[i + 1][0]))
+            {
+                headlessUpdates = std::strtoul(argv[++i], nullptr, 10);
+            }
+        }
+        else if (0 == strcmp(argv[i], "--record") && i + 1 < argc)
+        {
+            replayMode = ReplaySystem::Mode::Record;
+            replayPathname = argv[++i];
+        }
+        else if (0 == strcmp(argv[i], "--playback") && i + 1 < argc)
+        {
+            replayMode = ReplaySystem::Mode::Playback;
+            replayPathname = argv[++i];
+        }
+    }
+    if (headless)
+    {
+        // SDL must not open a window or an audio device.
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+    }
+
+    bool success = true;
     try
     {
         Ego::Core::System::initialize(argv[0],nullptr);
         try
         {
             _gameEngine = std::unique_ptr<GameEngine>(new GameEngine());
+            _gameEngine->setReplay(replayMode, replayPathname);
 
-            _gameEngine->start();
+            if (headless)
+            {
+                success = _gameEngine->runHeadless(headlessModule, headlessUpdates);
+            }
+            else
+            {
+                _gameEngine->start();
+            }
         }
         catch (...)
         {
@@ -594,7 +791,7 @@ int SDL_main(int argc, char **argv)
         std::cerr << "unhandled exception" << std::endl;
         return EXIT_FAILURE;
     }
-    return EXIT_SUCCESS;
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
 uint32_t GameEngine::getCurrentUpdateFrame() const
@@ -21,6 +21,7 @@
 
 #include "egolib/platform.h"
 #include "egolib/egoboo_setup.h"
+#include "game/Core/ReplaySystem.hpp"
 
 //Forward declarations
 class GameState;
@@ -61,6 +62,32 @@ public:
     **/
     void start();
 
+    /**
+    * @brief
+    *	A blocking function that runs the game logic of a module for a fixed number of updates as
+    *	fast as possible and logs how long that took. No window is opened and nothing is rendered
+    *	(the null renderer is used), the user interface and fonts are not loaded. Can be used
+    *	instead of start() for benchmarking the game logic.
+    * @param moduleName
+    *	the folder name of the module, with or without the ".mod" extension
+    * @param updateCount
+    *	the number of updates to run
+    * @return
+    *	true if the module was loaded and updated, false otherwise
+    **/
+    bool runHeadless(const std::string& moduleName, uint32_t updateCount);
+
+    /**
+    * @brief
+    *	Record the first module started into a replay file or play a replay file back in it.
+    *	Must be called before start() or runHeadless().
+    * @param mode
+    *	ReplaySystem::Mode::Record or ReplaySystem::Mode::Playback
+    * @param pathname
+    *	the virtual pathname of the replay file
+    **/
+    void setReplay(ReplaySystem::Mode mode, const std::string& pathname);
+
     /**
     * @return
     *	true if the GameEngine is currently running and is not terminated
@@ -221,6 +248,12 @@ private:
     **/
     void renderPreloadText(const std::string &text);
 
+    /**
+    * @brief
+    *	Initializes the ReplaySystem and starts recording or playback as requested by setReplay().
+    **/
+    void initializeReplay();
+
 private:
     std::chrono::high_resolution_clock::time_point _startupTimestamp;
     bool _isInitialized;
@@ -233,6 +266,8 @@ private:
     bool _clearGameStateStackRequested;
 
     egoboo_config_t _config;
+    ReplaySystem::Mode _replayMode;     ///< Record or play back a replay in the first module?
+    std::string _replayPathname;        ///< Virtual pathname of the replay file
     bool _drawCursor;
     bool _screenshotReady;
     bool _screenshotRequested;
@@ -0,0 +1,337 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   game/Core/ReplaySystem.cpp
+/// @brief  Recording and playback of the random seed and the player latches of a module.
+
+#include "game/Core/ReplaySystem.hpp"
+#include "game/Entities/_Include.hpp"
+#include "game/player.h"
+#include "game/game.h" //for update_wld
+
+namespace
+{
+
+const Uint32 REPLAY_MAGIC = 0x50524745; // "EGRP"
+const Uint16 REPLAY_VERSION = 1;
+
+/// 64 bit FNV-1a hash
+class Hash
+{
+public:
+    Hash() : _value(14695981039346656037ULL) {}
+
+    template <typename T>
+    void add(const T& value)
+    {
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+        for (size_t i = 0; i < sizeof(T); ++i)
+        {
+            _value = (_value ^ bytes[i]) * 1099511628211ULL;
+        }
+    }
+
+    void add(const Vector3f& value)
+    {
+        add(value[kX]);
+        add(value[kY]);
+        add(value[kZ]);
+    }
+
+    uint64_t get() const { return _value; }
+
+private:
+    uint64_t _value;
+};
+
+}
+
+ReplaySystem::ReplaySystem() :
+    _mode(Mode::Off),
+    _active(false),
+    _pathname(),
+    _file(nullptr),
+    _moduleName(),
+    _seed(0),
+    _updates(),
+    _update(),
+    _updateCount(0),
+    _mismatchCount(0)
+{
+    //ctor
+}
+
+ReplaySystem::~ReplaySystem()
+{
+    endModule();
+}
+
+ReplaySystem::Mode ReplaySystem::getMode() const
+{
+    return _mode;
+}
+
+void ReplaySystem::startRecording(const std::string& pathname)
+{
+    endModule();
+    _mode = Mode::Record;
+    _pathname = pathname;
+}
+
+bool ReplaySystem::startPlayback(const std::string& pathname)
+{
+    endModule();
+    _mode = Mode::Off;
+    _updates.clear();
+
+    vfs_FILE *file = vfs_openRead(pathname);
+    if (!file)
+    {
+        Log::get().warn("unable to open replay file `%s`\n", pathname.c_str());
+        return false;
+    }
+
+    const long length = vfs_fileLength(file);
+    Uint32 magic = 0, seed = 0;
+    Uint16 version = 0, nameLength = 0;
+    vfs_read_Uint32(*file, &magic);
+    vfs_read_Uint16(*file, &version);
+    vfs_read_Uint32(*file, &seed);
+    vfs_read_Uint16(*file, &nameLength);
+    std::string moduleName(nameLength, '\0');
+    if (REPLAY_MAGIC != magic || REPLAY_VERSION != version || (nameLength > 0 && 1 != vfs_read(&moduleName[0], nameLength, 1, file)))
+    {
+        Log::get().warn("`%s` is not a replay file of version %d\n", pathname.c_str(), REPLAY_VERSION);
+        vfs_close(file);
+        return false;
+    }
+
+    while (vfs_tell(file) < length && 0 == vfs_error(file))
+    {
+        Update update;
+        Uint8 latchCount = 0;
+        vfs_read_Uint8(*file, &latchCount);
+        update.latches.resize(latchCount);
+        for (PlayerLatch& latch : update.latches)
+        {
+            Uint32 buttons = 0;
+            vfs_read_Uint8(*file, &latch.player);
+            vfs_read_float(*file, &latch.x);
+            vfs_read_float(*file, &latch.y);
+            vfs_read_Uint32(*file, &buttons);
+            latch.buttons = buttons;
+        }
+        Uint64 hash = 0;
+        vfs_read_Uint64(*file, &hash);
+        update.hash = hash;
+        _updates.push_back(std::move(update));
+    }
+    if (0 != vfs_error(file))
+    {
+        Log::get().warn("replay file `%s` is truncated, %" PRIuZ " updates read\n", pathname.c_str(), _updates.size());
+    }
+    vfs_close(file);
+
+    _mode = Mode::Playback;
+    _pathname = pathname;
+    _moduleName = moduleName;
+    _seed = seed;
+    Log::get().info("replay: playing back %" PRIuZ " updates of module `%s` from `%s`\n", _updates.size(), _moduleName.c_str(), _pathname.c_str());
+    return true;
+}
+
+uint32_t ReplaySystem::beginModule(const std::string& moduleName, uint32_t seed)
+{
+    endModule();
+    _updateCount = 0;
+    _mismatchCount = 0;
+    _update = Update();
+
+    switch (_mode)
+    {
+        case Mode::Record:
+        {
+            _file = vfs_openWrite(_pathname);
+            if (!_file)
+            {
+                Log::get().warn("unable to create replay file `%s`\n", _pathname.c_str());
+                _mode = Mode::Off;
+                return seed;
+            }
+            _active = true;
+            _moduleName = moduleName;
+            _seed = seed;
+            vfs_write<Uint32>(*_file, REPLAY_MAGIC);
+            vfs_write<Uint16>(*_file, REPLAY_VERSION);
+            vfs_write<Uint32>(*_file, _seed);
+            vfs_write<Uint16>(*_file, static_cast<Uint16>(_moduleName.length()));
+            vfs_write(_moduleName.data(), 1, _moduleName.length(), _file);
+            Log::get().info("replay: recording module `%s` into `%s`\n", _moduleName.c_str(), _pathname.c_str());
+            return _seed;
+        }
+
+        case Mode::Playback:
+            if (moduleName != _moduleName)
+            {
+                Log::get().warn("replay: recorded module `%s` but module `%s` was started\n", _moduleName.c_str(), moduleName.c_str());
+            }
+            _active = true;
+            return _seed;
+
+        case Mode::Off:
+        default:
+            return seed;
+    }
+}
+
+void ReplaySystem::endModule()
+{
+    if (!_active)
+    {
+        return;
+    }
+    _active = false;
+
+    if (Mode::Record == _mode)
+    {
+        vfs_close(_file);
+        _file = nullptr;
+        Log::get().info("replay: recorded %" PRIuZ " updates into `%s`\n", _updateCount, _pathname.c_str());
+    }
+    else if (Mode::Playback == _mode)
+    {
+        Log::get().info("replay: played back %" PRIuZ " of %" PRIuZ " updates, %" PRIuZ " world hash mismatches\n",
+                        _updateCount, _updates.size(), _mismatchCount);
+    }
+
+    // A replay covers one module.
+    _mode = Mode::Off;
+}
+
+void ReplaySystem::updateLatches()
+{
+    if (!_active)
+    {
+        return;
+    }
+
+    if (Mode::Record == _mode)
+    {
+        _update.latches.clear();
+        for (PLA_REF ipla = 0; ipla < MAX_PLAYER; ++ipla)
+        {
+            if (!PlaStack.lst[ipla].valid) continue;
+            const latch_t& latch = PlaStack.lst[ipla].net_latch;
+            _update.latches.push_back(PlayerLatch{static_cast<uint8_t>(ipla), latch.x, latch.y, static_cast<uint32_t>(latch.b.to_ulong())});
+        }
+    }
+    else if (Mode::Playback == _mode && _updateCount < _updates.size())
+    {
+        for (PLA_REF ipla = 0; ipla < MAX_PLAYER; ++ipla)
+        {
+            PlaStack.lst[ipla].net_latch.clear();
+        }
+        for (const PlayerLatch& recorded : _updates[_updateCount].latches)
+        {
+            if (recorded.player >= MAX_PLAYER) continue;
+            latch_t& latch = PlaStack.lst[recorded.player].net_latch;
+            latch.x = recorded.x;
+            latch.y = recorded.y;
+            latch.b = std::bitset<32>(recorded.buttons);
+        }
+    }
+}
+
+void ReplaySystem::endUpdate()
+{
+    if (!_active)
+    {
+        return;
+    }
+
+    if (Mode::Record == _mode)
+    {
+        _update.hash = hashWorld();
+        const bool written = writeUpdate(_update);
+        _update.latches.clear();
+        _updateCount++;
+        if (!written)
+        {
+            Log::get().warn("replay: unable to write to `%s`, recording stopped\n", _pathname.c_str());
+            endModule();
+        }
+    }
+    else if (Mode::Playback == _mode && _updateCount < _updates.size())
+    {
+        const uint64_t hash = hashWorld();
+        if (hash != _updates[_updateCount].hash)
+        {
+            if (0 == _mismatchCount)
+            {
+                Log::get().warn("replay: world state differs from the recording in update %" PRIuZ "\n", _updateCount);
+            }
+            _mismatchCount++;
+        }
+        _updateCount++;
+        if (_updateCount == _updates.size())
+        {
+            Log::get().info("replay: end of replay reached\n");
+        }
+    }
+}
+
+bool ReplaySystem::writeUpdate(const Update& update)
+{
+    vfs_write<Uint8>(*_file, static_cast<Uint8>(update.latches.size()));
+    for (const PlayerLatch& latch : update.latches)
+    {
+        vfs_write<Uint8>(*_file, latch.player);
+        vfs_write<float>(*_file, latch.x);
+        vfs_write<float>(*_file, latch.y);
+        vfs_write<Uint32>(*_file, latch.buttons);
+    }
+    vfs_write<Uint64>(*_file, update.hash);
+    return 0 == vfs_error(_file);
+}
+
+uint64_t ReplaySystem::hashWorld()
+{
+    Hash hash;
+    hash.add(update_wld);
+
+    for (const std::shared_ptr<Object>& object : _currentModule->getObjectHandler().iterator())
+    {
+        if (object->isTerminated()) continue;
+        hash.add(object->getObjRef().get());
+        hash.add(object->getPosition());
+        hash.add(object->vel);
+        hash.add(object->ori.facing_z);
+        hash.add(object->getLife());
+    }
+
+    for (const std::shared_ptr<Ego::Particle>& particle : ParticleHandler::get().iterator())
+    {
+        if (particle->isTerminated()) continue;
+        hash.add(particle->getParticleID().get());
+        hash.add(particle->getPosition());
+        hash.add(particle->vel);
+    }
+
+    return hash.get();
+}
@@ -0,0 +1,151 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   game/Core/ReplaySystem.hpp
+/// @brief  Recording and playback of the random seed and the player latches of a module.
+
+#pragma once
+
+#include "IdLib/IdLib.hpp"
+#include "egolib/egolib.h"
+
+/**
+* @brief
+*   Records a module run into a replay file and plays it back, so that a module can be run
+*   identically any number of times, e.g. to benchmark the game logic.
+*
+*   A replay contains the name of the module, the random seed of the module and for every
+*   update the network latches of the players and a hash of the state of the world. During
+*   playback the recorded seed and latches replace the live ones and the hash of every update
+*   is compared with the recorded one, so changes of the game logic results are detected.
+* @remark
+*   Replay file format (little endian):
+*   - Uint32 magic "EGRP", Uint16 version, Uint32 seed, Uint16 length and bytes of the module name
+*   - for every update: Uint8 number of latches, for each latch the Uint8 player index, float x,
+*     float y and Uint32 button bits, then the Uint64 world hash
+* @remark
+*   The module has to be started with the same players as when the replay was recorded.
+*   Input which does not go through the latches (e.g. the inventory) is not recorded.
+**/
+class ReplaySystem : public Ego::Core::Singleton<ReplaySystem>
+{
+public:
+    enum class Mode
+    {
+        Off,        ///< Neither recording nor playing back
+        Record,     ///< Record the next module into a replay file
+        Playback,   ///< Play back a replay file in the next module
+    };
+
+    /**
+    * @brief
+    *   Record the next module started into a replay file.
+    * @param pathname
+    *   the virtual pathname of the replay file, e.g. "/debug/replay.egr"
+    **/
+    void startRecording(const std::string& pathname);
+
+    /**
+    * @brief
+    *   Play back a replay file in the next module started.
+    * @param pathname
+    *   the virtual pathname of the replay file
+    * @return
+    *   true if the replay file was read, false otherwise
+    **/
+    bool startPlayback(const std::string& pathname);
+
+    Mode getMode() const;
+
+    /**
+    * @brief
+    *   Called when a module is started.
+    * @param moduleName
+    *   the folder name of the module
+    * @param seed
+    *   the random seed the module would use
+    * @return
+    *   the random seed the module has to use
+    **/
+    uint32_t beginModule(const std::string& moduleName, uint32_t seed);
+
+    /**
+    * @brief
+    *   Called when the module is left. Closes the replay file.
+    **/
+    void endModule();
+
+    /**
+    * @brief
+    *   Record the network latches of all players or replace them by the recorded ones.
+    *   Called once per update after the network latches have been determined.
+    **/
+    void updateLatches();
+
+    /**
+    * @brief
+    *   Called at the end of every update. Records the world hash or compares it with the recorded one.
+    **/
+    void endUpdate();
+
+    /**
+    * @return
+    *   a hash of the state of all Objects and Particles
+    **/
+    static uint64_t hashWorld();
+
+protected:
+    // Befriend with singleton to grant access to ReplaySystem::ReplaySystem and ReplaySystem::~ReplaySystem.
+    using TheSingleton = Ego::Core::Singleton<ReplaySystem>;
+    friend TheSingleton;
+
+    ReplaySystem();
+    ~ReplaySystem();
+
+private:
+    /// The network latch of a player in one update
+    struct PlayerLatch
+    {
+        uint8_t player;
+        float x;
+        float y;
+        uint32_t buttons;
+    };
+
+    /// Everything recorded in one update
+    struct Update
+    {
+        std::vector<PlayerLatch> latches;
+        uint64_t hash;
+    };
+
+    bool writeUpdate(const Update& update);
+
+private:
+    Mode _mode;
+    bool _active;                   ///< Is a module being recorded or played back?
+    std::string _pathname;          ///< Virtual pathname of the replay file
+    vfs_FILE *_file;                ///< The replay file while recording
+    std::string _moduleName;        ///< Name of the recorded module
+    uint32_t _seed;                 ///< Random seed of the recorded module
+    std::vector<Update> _updates;   ///< The recorded updates while playing back
+    Update _update;                 ///< The current update
+    size_t _updateCount;            ///< Number of updates recorded or played back so far
+    size_t _mismatchCount;          ///< Number of updates whose world hash differed from the recorded one
+};
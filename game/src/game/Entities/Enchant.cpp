@@ -176,6 +176,7 @@ Enchantment::~Enchantment()
                 target->getTempAttributes()[modifier._type] -= modifier._value;
             }
         }
+        target->updateAttributes();
     }
 
     //Remove boost effects from owner
@@ -183,6 +184,7 @@ Enchantment::~Enchantment()
     if(owner != nullptr && !owner->isTerminated()) {
         owner->getTempAttributes()[Ego::Attribute::MANA_REGEN] -= _ownerManaSustain;
         owner->getTempAttributes()[Ego::Attribute::LIFE_REGEN] -= _ownerLifeSustain;
+        owner->updateAttributes();
     }
 }
 
@@ -447,12 +449,14 @@ void Enchantment::applyEnchantment(std::shared_ptr<Object> target)
             target->getTempAttributes()[modifier._type] += modifier._value;            
         }
     }
+    target->updateAttributes();
 
     //Finally apply boost values to owner as well
     std::shared_ptr<Object> owner = _owner.lock();
     if(owner != nullptr && !owner->isTerminated()) {
         owner->getTempAttributes()[Ego::Attribute::MANA_REGEN] += _ownerManaSustain;
         owner->getTempAttributes()[Ego::Attribute::LIFE_REGEN] += _ownerLifeSustain;
+        owner->updateAttributes();
     }
 
     //Insert this enchantment into the Objects list of active enchants
@@ -487,6 +491,7 @@ void Enchantment::setBoostValues(float ownerManaSustain, float ownerLifeSustain,
         owner->getTempAttributes()[Ego::Attribute::LIFE_REGEN] -= _ownerLifeSustain;
         owner->getTempAttributes()[Ego::Attribute::MANA_REGEN] += ownerManaSustain;
         owner->getTempAttributes()[Ego::Attribute::LIFE_REGEN] += ownerLifeSustain;
+        owner->updateAttributes();
     }
     _ownerManaSustain = ownerManaSustain;
     _ownerLifeSustain = ownerLifeSustain;
@@ -506,6 +511,7 @@ void Enchantment::setBoostValues(float ownerManaSustain, float ownerLifeSustain,
                 target->getTempAttributes()[Ego::Attribute::LIFE_REGEN] += modifier._value;            
             }
         }        
+        target->updateAttributes();
     }  
     _targetManaDrain = targetManaDrain;
     _targetLifeDrain = targetLifeDrain;
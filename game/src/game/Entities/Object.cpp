@@ -137,6 +137,7 @@ Object::Object(const PRO_REF proRef, ObjectRef objRef) :
     _currentMana(0.0f),
     _baseAttribute(),
     _tempAttribute(),
+    _attribute(),
 
     _inventory(),
     _perks(),
@@ -174,6 +175,7 @@ Object::Object(const PRO_REF proRef, ObjectRef objRef) :
         const FRange& baseRange = _profile->getAttributeBase(static_cast<Ego::Attribute::AttributeType>(i));
         _baseAttribute[i] = Random::next(baseRange);
     }
+    updateAttributes();
 }
 
 Object::~Object()
@@ -229,6 +231,7 @@ bool Object::setSkin(const size_t skinNumber)
 
     //Defence from Armour
     _baseAttribute[Ego::Attribute::DEFENCE] = newSkin.defence;
+    updateAttributes();
 
     //Set new skin
     this->skin = skinNumber;
@@ -861,14 +864,16 @@ void Object::update()
         // update some special skills (players and NPC's)
         if(getShowStatus())
         {
+            std::shared_ptr<PlayingState> playingState = _gameEngine->getActivePlayingState();
+
             //Cartography perk reveals the minimap
-            if(hasPerk(Ego::Perks::CARTOGRAPHY)) {
-                _gameEngine->getActivePlayingState()->getMiniMap()->setVisible(true);
+            if(hasPerk(Ego::Perks::CARTOGRAPHY) && playingState) {
+                playingState->getMiniMap()->setVisible(true);
             }
 
             //Navigation reveals the players position on the minimap
-            if(hasPerk(Ego::Perks::NAVIGATION)) {
-                _gameEngine->getActivePlayingState()->getMiniMap()->setShowPlayerPosition(true);
+            if(hasPerk(Ego::Perks::NAVIGATION) && playingState) {
+                playingState->getMiniMap()->setShowPlayerPosition(true);
             }
 
             //Danger Sense reveals enemies on the minimap
@@ -1129,6 +1134,7 @@ bool Object::detatchFromHolder(const bool ignoreKurse, const bool doShop)
 	if (pholder->holdingwhich[SLOT_RIGHT] == getObjRef()) {
 		pholder->holdingwhich[SLOT_RIGHT] = ObjectRef::Invalid;
 	}
+	pholder->updateAttributes();
 
     if ( isAlive() )
     {
@@ -1348,6 +1354,7 @@ void Object::checkLevelUp()
             for(size_t i = 0; i < Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES; ++i) {
                 _baseAttribute[i] += Random::next(getProfile()->getAttributeGain(static_cast<Ego::Attribute::AttributeType>(i)));
             }
+            updateAttributes();
 
             //Grab random Perk? (ZF> just uncomment if we want to do this for AI characters as well)
             //std::vector<Ego::Perks::PerkID> perkPool = getValidPerks();
@@ -1862,6 +1869,7 @@ void Object::respawn()
     platform        = profile->isPlatform();
     canuseplatforms = profile->canUsePlatforms();
     _baseAttribute[Ego::Attribute::FLY_TO_HEIGHT] = profile->getFlyHeight();
+    updateAttributes();
     phys.bumpdampen = profile->getBumpDampen();
 
     ai.alert = ALERTIF_CLEANEDUP;
@@ -1993,12 +2001,21 @@ void Object::setBaseAttribute(const Ego::Attribute::AttributeType type, float va
 {
     EGOBOO_ASSERT(type < _baseAttribute.size() && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
     _baseAttribute[type] = value;
+    updateAttributes();
 }
 
-float Object::getAttribute(const Ego::Attribute::AttributeType type) const 
-{ 
-    EGOBOO_ASSERT(type < _baseAttribute.size() && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
+void Object::updateAttributes()
+{
+    // FLY_TO_HEIGHT has to be known before JUMP_POWER
+    _attribute[Ego::Attribute::FLY_TO_HEIGHT] = calculateAttribute(Ego::Attribute::FLY_TO_HEIGHT);
+    for(size_t i = 0; i < _attribute.size(); ++i) {
+        if(i == Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES) continue;
+        _attribute[i] = calculateAttribute(static_cast<Ego::Attribute::AttributeType>(i));
+    }
+}
 
+float Object::calculateAttribute(const Ego::Attribute::AttributeType type) const
+{
     float attributeValue = _baseAttribute[type];
 
     //Try to find temp value in map, but don't create it if it doesn't already exist
@@ -2030,7 +2047,7 @@ float Object::getAttribute(const Ego::Attribute::AttributeType type) const
 
         case Ego::Attribute::JUMP_POWER:
             //Special value for flying Objects
-            if(getAttribute(Ego::Attribute::FLY_TO_HEIGHT) > 0.0f) {
+            if(_attribute[Ego::Attribute::FLY_TO_HEIGHT] > 0.0f) {
                 return JUMPINFINITE;
             }
 
@@ -2068,6 +2085,7 @@ void Object::increaseBaseAttribute(const Ego::Attribute::AttributeType type, flo
 {
     EGOBOO_ASSERT(type < _baseAttribute.size() && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
     _baseAttribute[type] = Ego::Math::constrain(_baseAttribute[type] + value, 0.0f, 255.0f);
+    updateAttributes();
 
     //Handle current life and mana increase as well
     if(type == Ego::Attribute::MAX_LIFE) {
@@ -2124,6 +2142,7 @@ void Object::addPerk(Ego::Perks::PerkID perk)
 {
     if(perk == Ego::Perks::NR_OF_PERKS) return;
     _perks[perk] = true;
+    updateAttributes();
 }
 
 float Object::getLife() const
@@ -2396,6 +2415,12 @@ void Object::polymorphObject(const PRO_REF profileID, const SKIN_T newSkin)
     // Set the skin after changing the model in chr_instance_t::spawn()
     setSkin(newSkin);
 
+    // the holder might have a bonus for holding this kind of item
+    const std::shared_ptr<Object> &holder = getHolder();
+    if (holder) {
+        holder->updateAttributes();
+    }
+
     // Must set the wepon grip AFTER the model is changed in chr_instance_t::spawn()
     if (isBeingHeld())
     {
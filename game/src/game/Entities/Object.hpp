@@ -545,7 +545,17 @@ public:
     *   Get total value for the specified attribute. Includes bonuses from Enchants, Perks
     *   and other active boni or penalties.
     **/
-    float getAttribute(const Ego::Attribute::AttributeType type) const;
+    inline float getAttribute(const Ego::Attribute::AttributeType type) const {
+        EGOBOO_ASSERT(type < _attribute.size() && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
+        return _attribute[type];
+    }
+
+    /**
+    * @brief
+    *   Recalculates the total values of all attributes. Must be called whenever the base
+    *   attributes, the temporary attributes from Enchants, the Perks or the held items change.
+    **/
+    void updateAttributes();
 
     /**
     * @brief
@@ -769,6 +779,12 @@ private:
     **/
     void checkLevelUp();
 
+    /**
+    * @brief
+    *   Calculates the total value of an attribute from the base value, the Enchants, the Perks and the held items
+    **/
+    float calculateAttribute(const Ego::Attribute::AttributeType type) const;
+
 public:
     chr_spawn_data_t  spawn_data;
 
@@ -907,6 +923,7 @@ private:
     float _currentMana;
     std::array<float, Ego::Attribute::NR_OF_ATTRIBUTES> _baseAttribute; ///< Character attributes
     std::unordered_map<Ego::Attribute::AttributeType, float, std::hash<uint8_t>> _tempAttribute; ///< Character attributes with enchants
+    std::array<float, Ego::Attribute::NR_OF_ATTRIBUTES> _attribute; ///< Total values of the character attributes, see updateAttributes()
 
     Inventory _inventory;
     std::bitset<Ego::Perks::NR_OF_PERKS> _perks;         ///< Perks known (super-efficient bool array)
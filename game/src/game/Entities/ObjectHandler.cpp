@@ -58,6 +58,7 @@ bool ObjectHandler::remove(ObjectRef ref) {
 #endif
 
 	//Remove us from any holder first
+	const ObjectRef holderRef = _internalCharacterList[ref]->attachedto;
 	_internalCharacterList[ref]->detatchFromHolder(true, false);
 
 	// If we are inside a list loop, do not actually change the length of the
@@ -68,6 +69,12 @@ bool ObjectHandler::remove(ObjectRef ref) {
 	// We can safely modify the map, it is not iterable from the outside.
 	_internalCharacterList.erase(ref);
 
+	// The holder loses any bonus for holding us, even if we could not be detached.
+	const std::shared_ptr<Object> &holder = (*this)[holderRef];
+	if (holder) {
+		holder->updateAttributes();
+	}
+
 	return true;
 }
 
@@ -169,6 +176,8 @@ void ObjectHandler::clear()
 	_internalCharacterList.clear();
 	_iteratorList.clear();
     _dynamicObjects.clear(0, 0, 0, 0);
+    _staticObjects.clear(0, 0, 0, 0);
+    _updateStaticTreeClock = 0;
     _deletedCharacters = 0;
     _totalCharactersSpawned = 0;
 }
@@ -299,29 +308,29 @@ size_t ObjectHandler::getObjectCount() const
     return _iteratorList.size() + _allocateList.size() - _deletedCharacters;
 }
 
-void ObjectHandler::updateQuadTree(float minX, float minY, float maxX, float maxY)
+void ObjectHandler::updateSpatialIndex(float minX, float minY, float maxX, float maxY)
 {
-    //Reset quad-tree
+    //Reset spatial index
     _dynamicObjects.clear(minX, minY, maxX, maxY);
 
-    //Rebuild the static quad tree only once per second
-    bool updateStaticQuadTree = false;
+    //Rebuild the static index only once per second
+    bool updateStaticIndex = false;
     if(_updateStaticTreeClock <= 0) {
         _updateStaticTreeClock = ONESECOND;
-        updateStaticQuadTree = true;
+        updateStaticIndex = true;
         _staticObjects.clear(minX, minY, maxX, maxY);
     }
     else {
         _updateStaticTreeClock--;
     }
 
-    //Rebuild quad-tree
+    //Rebuild spatial index
     for(const std::shared_ptr<Object> &object : _iteratorList) {
         //Do not add objects that cannot interact with the rest of the world
         if(object->isTerminated() || object->isHidden()) continue;
 
         if(object->isScenery()) {
-            if(updateStaticQuadTree) {
+            if(updateStaticIndex) {
                 _staticObjects.insert(object);
             }
         }
@@ -335,12 +344,64 @@ std::vector<std::shared_ptr<Object>> ObjectHandler::findObjects(const float x, c
     std::vector<std::shared_ptr<Object>> result;
 	AABB2f searchArea = AABB2f(Vector2f(x-distance, y-distance), Vector2f(x+distance, y+distance));
     _dynamicObjects.find(searchArea, result);
-    if(includeSceneryObjects) _staticObjects.find(searchArea, result);
+    if(includeSceneryObjects) findSceneryObjects(searchArea, result);
     return result;
 }
 
 void ObjectHandler::findObjects(const AABB2f &searchArea, std::vector<std::shared_ptr<Object>> &result, bool includeSceneryObjects) const
 {
-    if(includeSceneryObjects) _staticObjects.find(searchArea, result);
-    return _dynamicObjects.find(searchArea, result);
+    if(includeSceneryObjects) findSceneryObjects(searchArea, result);
+    _dynamicObjects.find(searchArea, result);
+}
+
+std::shared_ptr<Object> ObjectHandler::findNearestObject(const Vector3f& origin, const float maxDistance, const float tolerance,
+                                                        const ObjectFilter& filter, const ObjectFilter& accept) const
+{
+    //Gather the candidates, search the spatial index if the range is limited
+    std::vector<std::shared_ptr<Object>> found;
+    if(maxDistance > 0.0f) {
+        findObjects(origin[kX], origin[kY], maxDistance, true).swap(found);
+    }
+    const std::vector<std::shared_ptr<Object>> &candidates = maxDistance > 0.0f ? found : _iteratorList;
+
+    //Apply the cheap test to everything in range. Keep the position of each candidate
+    //so that ties are broken in the order the candidates were found.
+    const float maxDistance2 = maxDistance > 0.0f ? maxDistance * maxDistance + tolerance : std::numeric_limits<float>::infinity();
+    std::vector<std::pair<float, size_t>> heap;
+    for(size_t i = 0; i < candidates.size(); ++i) {
+        const std::shared_ptr<Object> &object = candidates[i];
+        if(object->isTerminated()) continue;
+
+        const float distance2 = (object->getPosition() - origin).length_2();
+        if(distance2 >= maxDistance2) continue;
+
+        if(!filter(object)) continue;
+        heap.emplace_back(distance2, i);
+    }
+
+    //Visit the candidates nearest first until one passes the expensive test
+    std::make_heap(heap.begin(), heap.end(), std::greater<std::pair<float, size_t>>());
+    while(!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<std::pair<float, size_t>>());
+        const std::shared_ptr<Object> &object = candidates[heap.back().second];
+        heap.pop_back();
+
+        if(!accept || accept(object)) {
+            return object;
+        }
+    }
+
+    return nullptr;
+}
+
+void ObjectHandler::findSceneryObjects(const AABB2f &searchArea, std::vector<std::shared_ptr<Object>> &result) const
+{
+    const size_t first = result.size();
+    _staticObjects.find(searchArea, result);
+
+    //The static index is rebuilt only once per second, drop objects that have been removed
+    //or stopped being scenery (these are in the dynamic index now) since then
+    result.erase(std::remove_if(result.begin() + first, result.end(),
+                                [](const std::shared_ptr<Object> &object) { return object->isTerminated() || !object->isScenery(); }),
+                 result.end());
 }
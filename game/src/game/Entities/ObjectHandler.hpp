@@ -27,7 +27,7 @@
 #endif
 
 #include "game/egoboo_typedef.h"
-#include "egolib/Core/QuadTree.hpp"
+#include "egolib/Core/SpatialHash.hpp"
 
 //Forward declarations
 class Object;
@@ -153,8 +153,7 @@ public:
 
 	/**
 	* @brief
-	*	Find all elements that are within range of a specified point in this QuadTree's
-	*	bounding box
+	*	Find all elements that are within range of a specified point
 	* @param x
 	*	x position of point to search from
 	* @param y
@@ -174,7 +173,7 @@ public:
 	* @param searchArea
 	*	The bounding box to scan
 	* @param result
-	*	reference to the vector where the result is stored
+	*	reference to the vector the result is appended to. Reuse it to avoid allocations.
 	* @param includeSceneryObjects
 	*	if true, it will also include Scenery objects in the search as defined by Object::isScenery()
 	**/
@@ -182,12 +181,41 @@ public:
 
 	/**
 	* @brief
-	* 	Clear and rebuild the quad tree for this update frame
+	*	A test applied to an Object by findNearestObject()
+	**/
+	using ObjectFilter = std::function<bool(const std::shared_ptr<Object>&)>;
+
+	/**
+	* @brief
+	*	Find the nearest Object that passes two tests. The candidates are visited in increasing
+	*	distance, so the expensive test only runs until the first candidate passes it.
+	* @param origin
+	*	the point the distances are measured from
+	* @param maxDistance, tolerance
+	*	only Objects with a squared distance below maxDistance * maxDistance + tolerance are considered.
+	*	0 means unlimited range. A limited range is searched with the spatial index, which does not
+	*	contain hidden Objects.
+	* @param filter
+	*	cheap test (team, alive, ...) applied to all candidates within range
+	* @param accept
+	*	expensive test (line of sight, ...) applied in increasing distance. May be empty.
+	* @return
+	*	the nearest Object passing both tests, nullptr if there is none. Of Objects with the same
+	*	distance, the one found first is chosen.
+	* @remark
+	*	Both tests must not modify this ObjectHandler.
+	**/
+	std::shared_ptr<Object> findNearestObject(const Vector3f& origin, const float maxDistance, const float tolerance,
+	                                          const ObjectFilter& filter, const ObjectFilter& accept) const;
+
+	/**
+	* @brief
+	* 	Clear and rebuild the spatial index for this update frame
 	*	This function is NOT thread-safe
 	* @param minX, minY, maxX, maxY
-	*	Sets the bounds of this quad tree (size of the entire current level)
+	*	Sets the bounds of the spatial index (size of the entire current level)
 	**/
-	void updateQuadTree(float minX, float minY, float maxX, float maxY);
+	void updateSpatialIndex(float minX, float minY, float maxX, float maxY);
 
 	/**
 	* @return
@@ -197,6 +225,16 @@ public:
 
 private:
 
+	/**
+	* @brief
+	*	Find all scenery objects that collide with a 2D bounding box area
+	* @param searchArea
+	*	The bounding box to scan
+	* @param result
+	*	reference to the vector the result is appended to
+	**/
+	void findSceneryObjects(const AABB2f &searchArea, std::vector<std::shared_ptr<Object>> &result) const;
+
 	/**
 	 * @brief Locks all object containers to ensure no modification will happen.
 	 *		  Must be called before iterating.
@@ -223,8 +261,8 @@ private:
 #endif
 
 private:
-	Ego::QuadTree<Object> _dynamicObjects;			//Objects that can move (Creatures, moving platforms, etc.)
-	Ego::QuadTree<Object> _staticObjects;			//Objects that rarely move - if ever (Trees, pillars, chairs)
+	Ego::SpatialHash<Object> _dynamicObjects;		//Objects that can move (Creatures, moving platforms, etc.)
+	Ego::SpatialHash<Object> _staticObjects;		//Objects that rarely move - if ever (Trees, pillars, chairs)
 	int _updateStaticTreeClock;
 
 	std::unordered_map<ObjectRef, std::shared_ptr<Object>> _internalCharacterList; ///< Maps object references to shared pointers to objects
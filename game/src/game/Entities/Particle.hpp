@@ -290,6 +290,14 @@ public:
     **/
     void destroy();
 
+    /**
+    * @brief
+    *   Clear the data of a Particle
+    * @note
+    *   Should only ever be used by the ParticleHandler! *Do not use*
+    **/
+    void reset(ParticleRef ref);
+
 private:
     /**
      * @brief
@@ -322,12 +330,6 @@ private:
     **/
     void updateAttachedDamage();
 
-    /**
-    * @brief
-    *   Clear the data of a Particle
-    **/
-    void reset(ParticleRef ref);  
-
 public:
     static const std::shared_ptr<Particle> INVALID_PARTICLE;
 
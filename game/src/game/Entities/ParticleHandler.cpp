@@ -41,22 +41,22 @@ std::shared_ptr<Ego::Particle> ParticleHandler::spawnLocalParticle(const Vector3
 
 const std::shared_ptr<Ego::Particle>& ParticleHandler::operator[] (const ParticleRef index)
 {
-    auto result = _particleMap.find(index);
-    
+    const size_t slot = getSlotIndex(index);
+
     // If the referenced particle does not exist ...
-    if(result == _particleMap.end()) {
+    if(index == ParticleRef::Invalid || slot >= _slots.size()) {
         // ... return the null pointer.
         return Ego::Particle::INVALID_PARTICLE;
     }
 
-    // Check if particle was marked as terminated
-    if((*result).second->isTerminated() || (*result).second->getParticleID() != index) {
-        _particleMap.erase(index);
-        return Ego::Particle::INVALID_PARTICLE;        
+    // Check if particle was marked as terminated or the slot was reused by another particle
+    const std::shared_ptr<Ego::Particle> &particle = _slots[slot].particle;
+    if(particle->isTerminated() || particle->getParticleID() != index) {
+        return Ego::Particle::INVALID_PARTICLE;
     }
 
     // All good!
-    return (*result).second;
+    return particle;
 }
 
 std::shared_ptr<Ego::Particle> ParticleHandler::spawnGlobalParticle(const Vector3f& spawnPos, const FACING_T spawnFacing,
@@ -91,18 +91,23 @@ std::shared_ptr<Ego::Particle> ParticleHandler::spawnParticle(const Vector3f& sp
     ppip->_spawnRequestCount++;
 
     //Try to get a free particle
-    std::shared_ptr<Ego::Particle> particle = getFreeParticle(ppip->force);
-    if(particle) {
+    std::shared_ptr<Ego::Particle> particle = Ego::Particle::INVALID_PARTICLE;
+    const size_t slot = getFreeSlot(ppip->force);
+    if(slot < PARTICLES_MAX) {
+        particle = _slots[slot].particle;
+        const ParticleRef particleID = ParticleRef((_slots[slot].generation++ << SLOT_BITS) | slot);
+
         //Initialize particle and add it into the game
-        if(particle->initialize(ParticleRef(_totalParticlesSpawned++), spawnPos, spawnFacing, spawnProfile, particleProfile, spawnAttach, vrt_offset, 
+        if(particle->initialize(particleID, spawnPos, spawnFacing, spawnProfile, particleProfile, spawnAttach, vrt_offset, 
                                 spawnTeam, spawnOrigin, ParticleRef(spawnParticleOrigin), multispawn, spawnTarget, onlyOverWater)) 
         {
             _pendingParticles.push_back(particle);
-            _particleMap[particle->getParticleID()] = particle;
         }
         else {
-            //If we failed to spawn somehow, put it back to the unused pool
-            _unusedPool.push_back(particle);
+            //If we failed to spawn somehow, clear the particle and put it back to the unused slots
+            particle->reset(ParticleRef::Invalid);
+            particle = Ego::Particle::INVALID_PARTICLE;
+            releaseSlot(slot);
         }        
     }
 
@@ -119,13 +124,11 @@ std::shared_ptr<Ego::Particle> ParticleHandler::spawnParticle(const Vector3f& sp
     return particle;
 }
 
-std::shared_ptr<Ego::Particle> ParticleHandler::getFreeParticle(bool force)
+size_t ParticleHandler::getFreeSlot(bool force)
 {
-    std::shared_ptr<Ego::Particle> particle = Ego::Particle::INVALID_PARTICLE;
-
     //Reserve last 25% of free particle for FORCE spawn particles
     if(!force && getFreeCount() < _maxParticles/4) {
-        return particle;
+        return PARTICLES_MAX;
     }
 
     //Is this a high priority particle? If so, replace a less important particle
@@ -167,20 +170,37 @@ std::shared_ptr<Ego::Particle> ParticleHandler::getFreeParticle(bool force)
         }
     }
 
-    //If we have no free particles in the memory pool but we are allowed to allocate new memory
-    if(_unusedPool.empty() && getCount() < _maxParticles) {
-        return std::make_shared<Ego::Particle>();
+    //If we have no free slots but we are allowed to allocate new memory
+    if(_freeSlots.empty() && getCount() < _maxParticles && _slots.size() < PARTICLES_MAX) {
+        const size_t slot = _slots.size();
+
+        //Allocate a new block of particles if the last one is used up
+        if(0 == slot % BLOCK_SIZE) {
+            _blocks.push_back(std::shared_ptr<Ego::Particle>(new Ego::Particle[BLOCK_SIZE], std::default_delete<Ego::Particle[]>()));
+        }
+        const std::shared_ptr<Ego::Particle> &block = _blocks.back();
+        _slots.push_back({std::shared_ptr<Ego::Particle>(block, block.get() + slot % BLOCK_SIZE), 0});
+        return slot;
     }
 
-    //Get a free, unused particle from the particle pool
-    if (!_unusedPool.empty())
+    //Get a free, unused slot
+    if (!_freeSlots.empty())
     {
-        //Retrieve particle from the pool
-        particle = _unusedPool.back();
-        _unusedPool.pop_back();
+        const size_t slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        return slot;
     }
 
-    return particle;
+    return PARTICLES_MAX;
+}
+
+void ParticleHandler::releaseSlot(size_t slot)
+{
+    //Retire the slot if another particle would wrap around its generation and re-use an old reference
+    if(_slots[slot].generation > MAX_GENERATION) {
+        return;
+    }
+    _freeSlots.push_back(slot);
 }
 
 size_t ParticleHandler::getDisplayLimit() const
@@ -214,11 +234,11 @@ void ParticleHandler::unlock()
             }
 
             //Play end sound, trigger end spawn, etc.
+            const size_t slot = getSlotIndex(particle->getParticleID());
             particle->destroy();
 
             //Free to be used by another instance again
-            _unusedPool.push_back(particle);
-            _particleMap.erase(particle->getParticleID());
+            releaseSlot(slot);
 
             return true;
         };
@@ -253,9 +273,9 @@ void ParticleHandler::clear()
 
     _pendingParticles.clear();
     _activeParticles.clear();
-    _unusedPool.clear();
-    _particleMap.clear();
-    _totalParticlesSpawned = 0;
+    _freeSlots.clear();
+    _slots.clear();
+    _blocks.clear();
 }
 
 const Ego::Texture* ParticleHandler::getLightParticleTexture()
@@ -32,6 +32,28 @@
 class ParticleHandler : public Ego::Core::Singleton<ParticleHandler>
 {
 public:
+    /**
+     * @brief
+     *  The number of low bits of a particle reference holding the index of the slot of the particle.
+     *  The remaining bits hold the generation of the slot, which is incremented whenever the slot is
+     *  reused, so a particle reference is not re-used after its particle is removed from the game.
+     */
+    static constexpr size_t SLOT_BITS = 16;
+    static_assert(PARTICLES_MAX <= (size_t(1) << SLOT_BITS), "PARTICLES_MAX does not fit into SLOT_BITS");
+
+    /**
+     * @brief
+     *  The greatest generation which fits into a particle reference.
+     *  A slot which has used up all its generations is retired and never reused.
+     */
+    static constexpr size_t MAX_GENERATION = std::numeric_limits<size_t>::max() >> SLOT_BITS;
+
+    /**
+     * @brief
+     *  Particles are allocated in contiguous blocks of this many particles.
+     */
+    static constexpr size_t BLOCK_SIZE = 256;
+
 
     /**
     * @brief A completely recursive loop safe container for accessing instances of in-game objects
@@ -89,10 +111,11 @@ public:
     ParticleHandler() :
         _maxParticles(0),
         _semaphoreLock(0),
-        _totalParticlesSpawned(0),
-        _unusedPool(),
+        _blocks(),
+        _slots(),
+        _freeSlots(),
         _activeParticles(),
-        _particleMap(),
+        _pendingParticles(),
         
         _transparentParticleTexture("mp_data/globalparticles/particle_trans"),
         _lightParticleTexture("mp_data/globalparticles/particle_light")
@@ -216,7 +239,33 @@ public:
     void spawnDefencePing(const std::shared_ptr<Object> &object, const std::shared_ptr<Object> &attacker);
 
 private:
-    std::shared_ptr<Ego::Particle> getFreeParticle(bool force);
+    /// A slot holding a particle.
+    struct Slot
+    {
+        std::shared_ptr<Ego::Particle> particle;
+        size_t generation;      ///< The generation of the next particle spawned into this slot
+    };
+
+    /// @return the index of the slot of the specified particle reference
+    static size_t getSlotIndex(const ParticleRef ref) { return ref.get() & ((size_t(1) << SLOT_BITS) - 1); }
+
+    /**
+     * @brief
+     *  Get an unused slot, allocating a new slot if necessary.
+     * @param force
+     *  if @a true, a particle which is not forced might be terminated to make room
+     * @return
+     *  the index of the slot or @a PARTICLES_MAX if no slot is available
+     */
+    size_t getFreeSlot(bool force);
+
+    /**
+     * @brief
+     *  Return a slot to the unused slots unless its generations are used up.
+     * @param slot
+     *  the index of the slot
+     */
+    void releaseSlot(size_t slot);
 
     void lock();
 
@@ -225,14 +274,13 @@ private:
 private:
     size_t _maxParticles;   ///< Maximum allowed active particles to be alive at the same time
     std::atomic<size_t> _semaphoreLock;
-    std::atomic<size_t> _totalParticlesSpawned;
 
-    std::vector<std::shared_ptr<Ego::Particle>> _unusedPool;         //Particles currently unused
+    std::vector<std::shared_ptr<Ego::Particle>> _blocks;             //Blocks of BLOCK_SIZE particles the slots point into
+    std::vector<Slot> _slots;                                        //Mapping from the slot index of a PRT_REF to Particle
+    std::vector<size_t> _freeSlots;                                  //Indices of the slots currently unused
     std::vector<std::shared_ptr<Ego::Particle>> _activeParticles;    //List of all particles that are active ingame
     std::vector<std::shared_ptr<Ego::Particle>> _pendingParticles;   //Particles that will be added to the active list as soon as it is unlocked
 
-    std::unordered_map<ParticleRef, std::shared_ptr<Ego::Particle>> _particleMap; //Mapping from PRT_REF to Particle
-
     Ego::DeferredTexture _transparentParticleTexture;
     Ego::DeferredTexture _lightParticleTexture;
 };
@@ -52,12 +52,15 @@ void InternalDebugWindow::drawContainer()
     int xOffset = getX() + 5;
     int yOffset = getY() + 32;
 
-    //Draw all monitored variables
+    //Draw all monitored variables in one batch
+    const std::shared_ptr<Ego::Font> &font = _gameEngine->getUIManager()->getDebugFont();
+    font->beginBatch();
     for(const auto &element : _watchedVariables)
     {
-        _gameEngine->getUIManager()->getDebugFont()->drawText(element.first + ": " + element.second(), xOffset, yOffset);
+        font->drawText(element.first + ": " + element.second(), xOffset, yOffset);
 
-        _gameEngine->getUIManager()->getDebugFont()->getTextSize(element.first, &textWidth, &textHeight);
+        font->getTextSize(element.first, &textWidth, &textHeight);
         yOffset += textHeight + 5;
     }
+    font->endBatch();
 }
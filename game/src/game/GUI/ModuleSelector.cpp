@@ -94,19 +94,18 @@ void ModuleSelector::drawContainer()
 	renderer.getTextureUnit().setActivated(nullptr);
     
     renderer.setColour(backDrop);
-	Ego::VertexBuffer vb(4, Ego::VertexFormatDescriptor::get<Ego::VertexFormat::P2F>());
+	auto vb = Ego::VertexArena::get().allocate(Ego::VertexFormatDescriptor::get<Ego::VertexFormat::P2F>(), 4);
 	{
 		struct Vertex {
 			float x, y;
 		};
-		Ego::VertexBufferScopedLock vblck(vb);
-		Vertex *vertices = vblck.get<Vertex>();
+		Vertex *vertices = vb.get<Vertex>();
 		vertices[0].x = getX(); vertices[0].y = getY();
 		vertices[1].x = getX(); vertices[1].y = getY() + getHeight();
 		vertices[2].x = getX() + getWidth(); vertices[2].y = getY() + getHeight();
 		vertices[3].x = getX() + getWidth(); vertices[3].y = getY();
 	}
-	renderer.render(vb, Ego::PrimitiveType::Quadriliterals, 0, 4);
+	Ego::VertexArena::get().render(vb, Ego::PrimitiveType::Quadriliterals);
 
     // Module description
     if(_selectedModule != nullptr)
@@ -204,19 +203,18 @@ void ModuleSelector::ModuleButton::draw()
         renderer.setColour( DEFAULT_BUTTON_COLOUR );
     }
 
-	Ego::VertexBuffer vb(4, Ego::VertexFormatDescriptor::get<Ego::VertexFormat::P2F>());
+	auto vb = Ego::VertexArena::get().allocate(Ego::VertexFormatDescriptor::get<Ego::VertexFormat::P2F>(), 4);
 	{
 		struct Vertex {
 			float x, y;
 		};
-		Ego::VertexBufferScopedLock vblck(vb);
-		Vertex *vertices = vblck.get<Vertex>();
+		Vertex *vertices = vb.get<Vertex>();
 		vertices[0].x = getX(); vertices[0].y = getY();
 		vertices[1].x = getX(); vertices[1].y = getY() + getHeight();
 		vertices[2].x = getX() + getWidth(); vertices[2].y = getY() + getHeight();
 		vertices[3].x = getX() + getWidth(); vertices[3].y = getY();
 	}
-	renderer.render(vb, Ego::PrimitiveType::Quadriliterals, 0, 4);
+	Ego::VertexArena::get().render(vb, Ego::PrimitiveType::Quadriliterals);
 
     //Draw module title image
     _gameEngine->getUIManager()->drawImage(*(_moduleSelector->_modules[_moduleSelector->_startIndex + _offset]->getIcon()), getX() + 5, getY() + 5, getWidth()-10, getHeight()-10);
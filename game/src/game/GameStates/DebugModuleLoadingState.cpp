@@ -165,6 +165,9 @@ void DebugModuleLoadingState::addToQueue(const std::shared_ptr<ModuleGUIContaine
 //TODO: HACK (no multithreading yet)
 void DebugModuleLoadingState::singleThreadRedrawHack(const std::string &loadingText)
 {
+    // release the transient vertices of the last frame
+    Ego::VertexArena::get().reset();
+
     // clear the screen
     gfx_request_clear_screen();
     gfx_do_clear_screen();
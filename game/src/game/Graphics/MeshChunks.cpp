@@ -0,0 +1,244 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file game/Graphics/MeshChunks.cpp
+/// @brief The static geometry of a mesh, baked into vertex buffers
+
+#include "game/Graphics/MeshChunks.hpp"
+#include "game/graphic.h"
+#include "game/mesh.h"
+#include "egolib/FileFormats/Globals.hpp"
+
+namespace Ego {
+namespace Graphics {
+
+MeshChunks::MeshChunks() :
+    _blocks(),
+    _renderChunks()
+{
+    //ctor
+}
+
+MeshChunks::~MeshChunks()
+{
+    //dtor
+}
+
+void MeshChunks::build(const ego_mesh_t& mesh)
+{
+    _blocks.clear();
+    _blocks.resize(mesh._blocks.getBlockCountX() * mesh._blocks.getBlockCountY());
+    for (uint32_t block = 0; block < _blocks.size(); ++block)
+    {
+        buildBlock(mesh, block);
+    }
+}
+
+uint32_t MeshChunks::getBlock(const ego_mesh_t& mesh, const Index1D& tile) const
+{
+    const uint32_t x = tile.getI() % mesh._info.getTileCountX();
+    const uint32_t y = tile.getI() / mesh._info.getTileCountX();
+    return (x / MeshBlocks::BLOCK_SIZE) + (y / MeshBlocks::BLOCK_SIZE) * mesh._blocks.getBlockCountX();
+}
+
+uint32_t MeshChunks::getTexture(const ego_tile_info_t& tile)
+{
+    uint32_t texture = TILE_GET_LOWER_BITS(tile._img);
+    if (tile._type >= tile_dict.offset)
+    {
+        texture += MESH_IMG_COUNT;
+    }
+    return texture;
+}
+
+void MeshChunks::invalidate(const ego_mesh_t& mesh, const Index1D& tile)
+{
+    const uint32_t block = getBlock(mesh, tile);
+    if (block < _blocks.size())
+    {
+        _blocks[block]._dirty = true;
+    }
+}
+
+void MeshChunks::invalidateColours(const ego_mesh_t& mesh, const Index1D& tile)
+{
+    const uint32_t block = getBlock(mesh, tile);
+    if (block < _blocks.size())
+    {
+        _blocks[block]._coloursDirty = true;
+    }
+}
+
+void MeshChunks::buildBlock(const ego_mesh_t& mesh, uint32_t index)
+{
+    const tile_mem_t& tmem = mesh._tmem;
+    const uint32_t startX = (index % mesh._blocks.getBlockCountX()) * MeshBlocks::BLOCK_SIZE;
+    const uint32_t startY = (index / mesh._blocks.getBlockCountX()) * MeshBlocks::BLOCK_SIZE;
+    const uint32_t endX = std::min<uint32_t>(startX + MeshBlocks::BLOCK_SIZE, mesh._info.getTileCountX());
+    const uint32_t endY = std::min<uint32_t>(startY + MeshBlocks::BLOCK_SIZE, mesh._info.getTileCountY());
+
+    Block& block = _blocks[index];
+    block._chunks.clear();
+
+    // Expand the fans of the tiles into triangles, grouped by texture and reflectiveness.
+    for (uint32_t y = startY; y < endY; ++y)
+    {
+        for (uint32_t x = startX; x < endX; ++x)
+        {
+            const Index1D tileIndex = x + y * mesh._info.getTileCountX();
+            const ego_tile_info_t& tile = tmem.get(tileIndex);
+            if (tile.isFanOff()) continue;
+
+            const tile_definition_t *pdef = tile_dict.get(tile._type);
+            if (nullptr == pdef) continue;
+
+            const uint32_t texture = getTexture(tile);
+            const bool reflective = 0 != tile.testFX(MAPFX_REFLECTIVE);
+            const bool animated = 0 != tile.testFX(MAPFX_ANIM);
+
+            auto it = std::find_if(block._chunks.begin(), block._chunks.end(),
+                                   [texture, reflective, animated](const Chunk& chunk)
+                                   { return chunk._texture == texture && chunk._reflective == reflective && chunk._animated == animated; });
+            if (it == block._chunks.end())
+            {
+                block._chunks.emplace_back();
+                it = block._chunks.end() - 1;
+                it->_texture = texture;
+                it->_reflective = reflective;
+                it->_animated = animated;
+                it->_tile = tileIndex;
+            }
+
+            for (size_t command = 0, entry = 0; command < pdef->command_count; ++command)
+            {
+                const uint8_t numEntries = pdef->command_entries[command];
+                for (size_t i = 2; i < numEntries; ++i)
+                {
+                    it->_sources.push_back(tile._vrtstart + pdef->command_verts[entry]);
+                    it->_sources.push_back(tile._vrtstart + pdef->command_verts[entry + i - 1]);
+                    it->_sources.push_back(tile._vrtstart + pdef->command_verts[entry + i]);
+                }
+                entry += numEntries;
+            }
+        }
+    }
+
+    // Fill the vertex buffers.
+    for (Chunk& chunk : block._chunks)
+    {
+        chunk._vertexBuffer = std::unique_ptr<VertexBuffer>(new VertexBuffer(chunk._sources.size(), VertexFormatDescriptor::get<VertexFormat::P3FC4FT2F>()));
+        Vertex *vertices = static_cast<Vertex *>(chunk._vertexBuffer->lock());
+        for (size_t i = 0; i < chunk._sources.size(); ++i)
+        {
+            const uint32_t source = chunk._sources[i];
+            Vertex& vertex = vertices[i];
+            vertex.x = tmem._plst[source][XX];
+            vertex.y = tmem._plst[source][YY];
+            vertex.z = tmem._plst[source][ZZ];
+            vertex.r = tmem._clst[source][RR];
+            vertex.g = tmem._clst[source][GG];
+            vertex.b = tmem._clst[source][BB];
+            vertex.a = 1.0f;
+            vertex.s = tmem._tlst[source][SS];
+            vertex.t = tmem._tlst[source][TT];
+        }
+        chunk._vertexBuffer->unlock();
+    }
+
+    block._dirty = false;
+    block._coloursDirty = false;
+}
+
+void MeshChunks::copyColours(const ego_mesh_t& mesh, Block& block)
+{
+    const tile_mem_t& tmem = mesh._tmem;
+    for (Chunk& chunk : block._chunks)
+    {
+        Vertex *vertices = static_cast<Vertex *>(chunk._vertexBuffer->lock());
+        for (size_t i = 0; i < chunk._sources.size(); ++i)
+        {
+            const uint32_t source = chunk._sources[i];
+            vertices[i].r = tmem._clst[source][RR];
+            vertices[i].g = tmem._clst[source][GG];
+            vertices[i].b = tmem._clst[source][BB];
+        }
+        chunk._vertexBuffer->unlock();
+    }
+    block._coloursDirty = false;
+}
+
+size_t MeshChunks::render(const ego_mesh_t& mesh, const std::vector<uint32_t>& blocks, bool reflective)
+{
+    // Bring the blocks up to date and collect their chunks.
+    _renderChunks.clear();
+    for (uint32_t index : blocks)
+    {
+        if (index >= _blocks.size()) continue;
+
+        Block& block = _blocks[index];
+        if (block._dirty)
+        {
+            buildBlock(mesh, index);
+        }
+        else if (block._coloursDirty)
+        {
+            copyColours(mesh, block);
+        }
+        for (Chunk& chunk : block._chunks)
+        {
+            if (chunk._reflective == reflective && !chunk._sources.empty())
+            {
+                // The tiles of an animated chunk have moved on to the image of its first tile.
+                if (chunk._animated)
+                {
+                    chunk._texture = getTexture(mesh._tmem.get(chunk._tile));
+                }
+                _renderChunks.push_back(&chunk);
+            }
+        }
+    }
+    if (_renderChunks.empty())
+    {
+        return 0;
+    }
+
+    // Bind each texture only once.
+    std::sort(_renderChunks.begin(), _renderChunks.end(),
+              [](const Chunk *x, const Chunk *y) { return x->_texture < y->_texture; });
+
+    auto& renderer = Renderer::get();
+    renderer.setGouraudShadingEnabled(true);
+
+    // restart the mesh texture code
+    TileRenderer::invalidate();
+
+    for (const Chunk *chunk : _renderChunks)
+    {
+        TileRenderer::bind(mesh._tmem.get(chunk->_tile));
+        renderer.render(*chunk->_vertexBuffer, PrimitiveType::Triangles, 0, chunk->_sources.size());
+    }
+
+    // let the mesh texture code know that someone else is in control now
+    TileRenderer::invalidate();
+
+    return _renderChunks.size();
+}
+
+} // namespace Graphics
+} // namespace Ego
@@ -0,0 +1,126 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file game/Graphics/MeshChunks.hpp
+/// @brief The static geometry of a mesh, baked into vertex buffers
+
+#pragma once
+
+#include "game/egoboo_typedef.h"
+#include "egolib/Mesh/Info.hpp"
+
+class ego_mesh_t;
+class ego_tile_info_t;
+
+namespace Ego {
+namespace Graphics {
+
+/**
+ * @brief
+ *  The geometry of the tiles of a mesh, baked into one vertex buffer per block of tiles
+ *  (see MeshBlocks), texture and reflectiveness.
+ *
+ *  The fans of the tiles are expanded into triangle lists, so all tiles of a block sharing
+ *  a texture are drawn with a single draw call. A block is rebuilt if the texture or the FX
+ *  of one of its tiles change, and only the colours of a block are copied again if the
+ *  lighting of one of its tiles changes. Animated tiles are kept in chunks of their own:
+ *  an animation step changes the images of all of them alike, so such a chunk just binds
+ *  the texture of its current image.
+ */
+class MeshChunks
+{
+public:
+    MeshChunks();
+    ~MeshChunks();
+
+    /**
+     * @brief
+     *  Bake all blocks of a mesh.
+     * @param mesh
+     *  the mesh. Its blocks, vertex positions and texture coordinates must be up to date.
+     */
+    void build(const ego_mesh_t& mesh);
+
+    /**
+     * @brief
+     *  Mark the block of a tile for rebuilding, e.g. because the texture or FX of the tile changed.
+     */
+    void invalidate(const ego_mesh_t& mesh, const Index1D& tile);
+
+    /**
+     * @brief
+     *  Mark the colours of the block of a tile as stale, because the lighting of the tile changed.
+     */
+    void invalidateColours(const ego_mesh_t& mesh, const Index1D& tile);
+
+    /**
+     * @brief
+     *  Render the reflective or the non-reflective tiles of some blocks.
+     * @param mesh
+     *  the mesh
+     * @param blocks
+     *  the indices of the blocks
+     * @param reflective
+     *  if @a true the tiles with MAPFX_REFLECTIVE are rendered, otherwise the other tiles
+     * @return
+     *  the number of draw calls
+     */
+    size_t render(const ego_mesh_t& mesh, const std::vector<uint32_t>& blocks, bool reflective);
+
+private:
+    /// The vertex type of the vertex buffers.
+    struct Vertex
+    {
+        float x, y, z;
+        float r, g, b, a;
+        float s, t;
+    };
+
+    /// The tiles of a block with the same texture and reflectiveness.
+    struct Chunk
+    {
+        uint32_t _texture;                      ///< The texture index, see TileRenderer
+        bool _reflective;                       ///< Are the tiles reflective?
+        bool _animated;                         ///< Are the tiles animated (MAPFX_ANIM)?
+        Index1D _tile;                          ///< A tile of this chunk, to bind the texture
+        std::vector<uint32_t> _sources;         ///< The mesh vertex of each vertex in the vertex buffer
+        std::unique_ptr<VertexBuffer> _vertexBuffer;
+    };
+
+    /// The chunks of a block.
+    struct Block
+    {
+        std::vector<Chunk> _chunks;
+        bool _dirty;            ///< Must the chunks be rebuilt?
+        bool _coloursDirty;     ///< Must the colours be copied again?
+    };
+
+    std::vector<Block> _blocks;
+
+    /// Pointers to the chunks rendered by a call to render, kept to avoid allocations.
+    std::vector<const Chunk *> _renderChunks;
+
+    uint32_t getBlock(const ego_mesh_t& mesh, const Index1D& tile) const;
+    static uint32_t getTexture(const ego_tile_info_t& tile);
+    void buildBlock(const ego_mesh_t& mesh, uint32_t block);
+    void copyColours(const ego_mesh_t& mesh, Block& block);
+};
+
+} // namespace Graphics
+} // namespace Ego
@@ -48,6 +48,11 @@ public:
 	 *	The clock for measuring the time spent in this render pass.
 	 */
 	Clock<ClockPolicy::NonRecursive> _clock;
+	/**
+	 * @brief
+	 *	The number of draw calls of the mesh issued by the last run of this render pass.
+	 */
+	size_t _drawCalls;
 	/**
 	 * @brief
 	 *	Construct this render pass.
@@ -57,7 +62,7 @@ public:
 	 *	Intentionally protected.
 	 */
 	RenderPass(const std::string& name)
-		: _clock(name, 512) {
+		: _clock(name, 512), _drawCalls(0) {
 	}
 	/**
 	 * @brief
@@ -91,6 +96,7 @@ public:
 	 */
 	void run(::Camera& camera, const TileList& tileList, const EntityList& entityList) {
 		ClockScope<ClockPolicy::NonRecursive> clockScope(_clock);
+		_drawCalls = 0;
 		OpenGL::Utilities::isError();
 		doRun(camera, tileList, entityList);
 		OpenGL::Utilities::isError();
@@ -39,6 +39,7 @@
 #include "game/char.h"
 #include "game/mesh.h"
 #include "game/Graphics/CameraSystem.hpp"
+#include "game/Graphics/MeshChunks.hpp"
 #include "egolib/FileFormats/Globals.hpp"
 #include "game/Module/Module.hpp"
 
@@ -84,12 +85,12 @@ struct by_element2_t {
 	}
 };
 
-void render_fans_by_list(const ego_mesh_t& mesh, const Ego::Graphics::renderlist_lst_t& rlst)
+size_t render_fans_by_list(const ego_mesh_t& mesh, const Ego::Graphics::renderlist_lst_t& rlst)
 {
 	size_t tcnt = mesh._tmem.getInfo().getTileCount();
 
 	if (0 == rlst.size) {
-		return;
+		return 0;
 	}
 
 	// insert the rlst values into lst_vals
@@ -122,6 +123,7 @@ void render_fans_by_list(const ego_mesh_t& mesh, const Ego::Graphics::renderlist
 	// restart the mesh texture code
 	TileRenderer::invalidate();
 
+	size_t drawCalls = 0;
 	for (size_t i = 0; i < rlst.size; ++i)
 	{
 		Index1D tmp_itile = lst_vals[i]._tileIndex;
@@ -131,10 +133,35 @@ void render_fans_by_list(const ego_mesh_t& mesh, const Ego::Graphics::renderlist
 		{
 			Log::get().warn("%s - error rendering tile %d.\n", __FUNCTION__, tmp_itile.getI());
 		}
+		if (gfx_success == render_rv && !mesh._tmem.get(tmp_itile).isFanOff())
+		{
+			drawCalls += tile_dict.get(mesh._tmem.get(tmp_itile)._type)->command_count;
+		}
 	}
 
 	// let the mesh texture code know that someone else is in control now
 	TileRenderer::invalidate();
+
+	return drawCalls;
+}
+
+size_t render_fans(const TileList& tl, bool reflective)
+{
+	const ego_mesh_t& mesh = *tl._mesh;
+	const renderlist_lst_t& rlst = reflective ? tl._reflective : tl._nonReflective;
+
+	// The baked chunks always use per-vertex colours and can not show the normals.
+	if (!mesh._chunks || !gfx.gouraudShading_enable || egoboo_config_t::get().debug_mesh_renderNormals.getValue())
+	{
+		return render_fans_by_list(mesh, rlst);
+	}
+
+	size_t drawCalls = mesh._chunks->render(mesh, tl._blocks, reflective);
+
+	// Render the tiles of the blocks which did not fit completely into the tile list one by one.
+	drawCalls += render_fans_by_list(mesh, reflective ? tl._reflectiveRest : tl._nonReflectiveRest);
+
+	return drawCalls;
 }
 
 }
@@ -417,7 +444,7 @@ void Reflective0::doReflectionsEnabled(::Camera& camera, const TileList& tl, con
 		renderer.setAlphaFunction(CompareFunction::Greater, 0.0f);
 		// reduce texture hashing by loading up each texture only once
 		if (tl._mesh) {
-			Internal::render_fans_by_list(*tl._mesh, tl._reflective);
+			_drawCalls += Internal::render_fans(tl, true);
 		}
 	}
 	ATTRIB_POP(__FUNCTION__);
@@ -458,7 +485,7 @@ void Reflective1::doReflectionsEnabled(::Camera& camera, const TileList& tl, con
 
 		// reduce texture hashing by loading up each texture only once
 		if (tl._mesh) {
-			Internal::render_fans_by_list(*tl._mesh, tl._reflective);
+			_drawCalls += Internal::render_fans(tl, true);
 		}
 	}
 	ATTRIB_POP(__FUNCTION__);
@@ -485,7 +512,7 @@ void Reflective1::doReflectionsDisabled(::Camera& camera, const TileList& tl, co
 
 		// reduce texture hashing by loading up each texture only once
 		if (tl._mesh) {
-			Internal::render_fans_by_list(*tl._mesh, tl._reflective);
+			_drawCalls += Internal::render_fans(tl, true);
 		}
 	}
 	ATTRIB_POP(__FUNCTION__);
@@ -513,7 +540,7 @@ void NonReflective::doRun(::Camera& camera, const TileList& tl, const EntityList
 
 		// reduce texture hashing by loading up each texture only once
 		if (tl._mesh) {
-			Internal::render_fans_by_list(*tl._mesh, tl._nonReflective);
+			_drawCalls += Internal::render_fans(tl, false);
 		}
 	}
 	ATTRIB_POP(__FUNCTION__);
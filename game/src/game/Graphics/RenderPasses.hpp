@@ -31,7 +31,13 @@ namespace Graphics {
 namespace RenderPasses {
 
 namespace Internal {
-void render_fans_by_list(const ego_mesh_t& mesh, const Ego::Graphics::renderlist_lst_t& rlst);
+/// @brief Render the tiles of a list one by one, sorted by texture.
+/// @return the number of draw calls
+size_t render_fans_by_list(const ego_mesh_t& mesh, const Ego::Graphics::renderlist_lst_t& rlst);
+/// @brief Render the reflective or the non-reflective tiles of a tile list.
+/// Whole blocks are drawn from the baked mesh chunks, the remaining tiles one by one.
+/// @return the number of draw calls
+size_t render_fans(const TileList& tl, bool reflective);
 }
 
 /// The first pass for reflective tiles
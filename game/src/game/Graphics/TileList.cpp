@@ -48,6 +48,10 @@ TileList::TileList() :
 	_reflective(), 
 	_nonReflective(), 
 	_water(),
+	_blocks(),
+	_reflectiveRest(),
+	_nonReflectiveRest(),
+	_visibleBlocks(),
 
 	_renderTiles(),
 	_lastRenderTiles()
@@ -65,6 +69,10 @@ void TileList::init()
 	_reflective.reset();
 	_nonReflective.reset();
 	_water.reset();
+	_blocks.clear();
+	_reflectiveRest.reset();
+	_nonReflectiveRest.reset();
+	_visibleBlocks.clear();
 
 	_mesh = nullptr;
 }
@@ -167,12 +175,7 @@ gfx_rv TileList::add(const Index1D& index, ::Camera& camera)
 		tile._lightingCache.setLastFrame(-1);
 	}
 
-	if (gfx_error == insert(index, camera))
-	{
-		return gfx_error;
-	}
-
-	return gfx_success;
+	return insert(index, camera);
 }
 
 bool TileList::inRenderList(const Index1D& index) const
@@ -59,7 +59,7 @@ struct renderlist_lst_t
 	*    i.e. the maximum number of tiles in a render list
 	*    i.e. the maximum number of tiles to draw.
 	*/
-	static const size_t CAPACITY = 1024;
+	static const size_t CAPACITY = 4096;
 	size_t size;                          ///< The number of entries.
 	std::array<element_t, CAPACITY> lst;  ///< The entries.
 
@@ -108,6 +108,22 @@ struct TileList
 	 * 	Tiles on which the MAPFX_WATER bit is set are added to this list.
 	 */
 	renderlist_lst_t _water;
+	/**
+	 * @brief
+	 *	The blocks of the mesh (see MeshBlocks) all tiles of which are in this list.
+	 */
+	std::vector<uint32_t> _blocks;
+	/**
+	 * @brief
+	 *	The tiles of #_reflective and #_nonReflective which are not in a block of #_blocks.
+	 */
+	renderlist_lst_t _reflectiveRest;
+	renderlist_lst_t _nonReflectiveRest;
+	/**
+	 * @brief
+	 *	The blocks of the mesh (see MeshBlocks) which are in the view frustum, nearest first.
+	 */
+	std::vector<uint32_t> _visibleBlocks;
 
 	TileList();
 	virtual ~TileList();
@@ -131,6 +147,7 @@ struct TileList
 	/// @brief Insert a tile into this render list.
 	/// @param the index of the tile to insert
 	/// @param camera the camera
+	/// @return #gfx_fail if this render list is full
 	gfx_rv add(const Index1D& index, ::Camera& camera);
 
 	/**
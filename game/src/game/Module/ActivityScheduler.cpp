@@ -0,0 +1,174 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file game/Module/ActivityScheduler.cpp
+/// @details Decides how often the objects of a module are updated.
+
+#include "game/Module/ActivityScheduler.hpp"
+#include "game/game.h"
+#include "game/player.h"
+#include "game/Entities/_Include.hpp"
+
+constexpr float ActivityScheduler::ACTIVE_DISTANCE;
+constexpr float ActivityScheduler::SLEEP_DISTANCE;
+constexpr uint32_t ActivityScheduler::ACTIVE_LINGER;
+constexpr uint32_t ActivityScheduler::LOW_FREQUENCY_PERIOD;
+constexpr uint32_t ActivityScheduler::SLEEP_PERIOD;
+
+ActivityScheduler::ActivityScheduler() :
+    _entries(),
+    _frame(0),
+    _enabled(true),
+    _counts{0, 0, 0}
+{
+    //ctor
+}
+
+void ActivityScheduler::setEnabled(bool enabled)
+{
+    _enabled = enabled;
+}
+
+bool ActivityScheduler::isEnabled() const
+{
+    return _enabled;
+}
+
+size_t ActivityScheduler::getCount(Bucket bucket) const
+{
+    return _counts[static_cast<size_t>(bucket)];
+}
+
+bool ActivityScheduler::isBusy(Object& object) const
+{
+    // Players, and anything alerted or with input to process.
+    if (VALID_PLA(object.is_which_player) || 0 != object.ai.alert) return true;
+    if (0.0f != object.latch.x || 0.0f != object.latch.y || object.latch.b.any()) return true;
+
+    // The script timer runs out: IfTimeOut becomes true in this update.
+    if (object.ai.timer + 1 == _frame) return true;
+
+    // Anything moving or carried along.
+    if (!object.vel.isZero() || object.isBeingHeld() || object.isInsideInventory() || object.getAttachedPlatform()) return true;
+    if (!object.isFlying() && !object.getObjectPhysics().isTouchingGround()) return true;
+
+    // Enchants have their own timers and effects.
+    return !object.getActiveEnchants().empty();
+}
+
+void ActivityScheduler::update(ObjectHandler& objects, uint32_t frame)
+{
+    _frame = frame;
+    _counts.fill(0);
+
+    // Gather the positions of the players.
+    std::vector<Vector3f> players;
+    for (PLA_REF ipla = 0; ipla < MAX_PLAYER; ipla++)
+    {
+        if (!PlaStack.lst[ipla].valid) continue;
+        const std::shared_ptr<Object> &player = objects[PlaStack.lst[ipla].index];
+        if (player && !player->isTerminated())
+        {
+            players.push_back(player->getPosition());
+        }
+    }
+
+    for (const std::shared_ptr<Object> &object : objects.iterator())
+    {
+        if (object->isTerminated()) continue;
+
+        // A new object starts out active.
+        auto it = _entries.find(object->getObjRef().get());
+        if (it == _entries.end())
+        {
+            it = _entries.emplace(object->getObjRef().get(), Entry{Bucket::Active, frame + ACTIVE_LINGER, frame}).first;
+        }
+        Entry& entry = it->second;
+        entry.frame = frame;
+
+        // The distance to the closest player.
+        float distance2 = std::numeric_limits<float>::infinity();
+        for (const Vector3f& player : players)
+        {
+            distance2 = std::min(distance2, (player - object->getPosition()).length_2());
+        }
+
+        if (!_enabled || distance2 <= ACTIVE_DISTANCE * ACTIVE_DISTANCE || isBusy(*object))
+        {
+            entry.awakeUntil = std::max(entry.awakeUntil, frame + ACTIVE_LINGER);
+        }
+
+        if (frame <= entry.awakeUntil)
+        {
+            entry.bucket = Bucket::Active;
+        }
+        else if (distance2 <= SLEEP_DISTANCE * SLEEP_DISTANCE)
+        {
+            entry.bucket = Bucket::LowFrequency;
+        }
+        else
+        {
+            entry.bucket = Bucket::Sleeping;
+        }
+        _counts[static_cast<size_t>(entry.bucket)]++;
+    }
+
+    // Forget the objects which are gone.
+    for (auto it = _entries.begin(); it != _entries.end();)
+    {
+        if (it->second.frame != frame)
+        {
+            it = _entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+bool ActivityScheduler::isDue(const Object& object)
+{
+    const size_t index = object.getObjRef().get();
+    const auto it = _entries.find(index);
+    if (it == _entries.end() || it->second.frame != _frame)
+    {
+        return true;
+    }
+
+    // An object alerted since update() was called wakes up right away.
+    if (0 != object.ai.alert && Bucket::Active != it->second.bucket)
+    {
+        _counts[static_cast<size_t>(it->second.bucket)]--;
+        _counts[static_cast<size_t>(Bucket::Active)]++;
+        it->second.bucket = Bucket::Active;
+        it->second.awakeUntil = std::max(it->second.awakeUntil, _frame + ACTIVE_LINGER);
+    }
+
+    // Stagger the objects of a bucket over its period.
+    switch (it->second.bucket)
+    {
+        case Bucket::LowFrequency:
+            return 0 == (_frame + index) % LOW_FREQUENCY_PERIOD;
+        case Bucket::Sleeping:
+            return 0 == (_frame + index) % SLEEP_PERIOD;
+        default:
+            return true;
+    }
+}
@@ -0,0 +1,115 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file game/Module/ActivityScheduler.hpp
+/// @details Decides how often the objects of a module are updated.
+
+#pragma once
+
+#include "egolib/typedef.h"
+#include "game/egoboo_typedef.h"
+
+//Forward declarations
+class Object;
+class ObjectHandler;
+
+/**
+ * @brief
+ *  Puts objects which are far from all players and have not done anything for a while into
+ *  buckets which think and move less often than every update.
+ *
+ *  An object is active, i.e. updated every update, if it is close to a player, or if it
+ *  is alerted, has input latched, is moving or in the air, is held, rides a platform, is
+ *  enchanted, or its script timer runs out. It stays active for a while after the last of
+ *  these. Other objects are put into the low frequency bucket, or into the sleeping bucket
+ *  if they are very far away. These objects run their scripts and physics only every
+ *  LOW_FREQUENCY_PERIOD or SLEEP_PERIOD updates, staggered by their object reference. Any
+ *  collision, order or damage raises an alert and wakes the object right away, even in the
+ *  middle of an update.
+ *
+ *  The buckets depend only on the game state, so updates stay deterministic.
+ */
+class ActivityScheduler : public Id::NonCopyable
+{
+public:
+    /// The buckets.
+    enum class Bucket : uint8_t
+    {
+        Active,         ///< Updated every update
+        LowFrequency,   ///< Updated every LOW_FREQUENCY_PERIOD updates
+        Sleeping,       ///< Updated every SLEEP_PERIOD updates
+    };
+
+    /// Objects closer than this to a player are always active.
+    static constexpr float ACTIVE_DISTANCE = 16 * 128.0f;
+    /// Idle objects farther than this from all players are sleeping.
+    static constexpr float SLEEP_DISTANCE = 32 * 128.0f;
+    /// The number of updates an object stays active after it was woken.
+    static constexpr uint32_t ACTIVE_LINGER = 50;
+    /// The number of updates between two updates of a low frequency object.
+    static constexpr uint32_t LOW_FREQUENCY_PERIOD = 8;
+    /// The number of updates between two updates of a sleeping object.
+    static constexpr uint32_t SLEEP_PERIOD = 32;
+
+    ActivityScheduler();
+
+    /**
+     * @brief
+     *  Put the objects into their buckets for this update.
+     * @param objects
+     *  the objects
+     * @param frame
+     *  the number of this update
+     */
+    void update(ObjectHandler& objects, uint32_t frame);
+
+    /**
+     * @brief
+     *  Get if an object is to be updated in this update.
+     * @return
+     *  @a true if the object is to think and move in this update.
+     *  Objects which were not put into a bucket by this update's update() are always due.
+     * @remark
+     *  An alerted object is moved into the active bucket.
+     */
+    bool isDue(const Object& object);
+
+    /// @brief Enable or disable scheduling. If disabled, all objects are active.
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    /// @brief Get the number of objects in a bucket in this update.
+    size_t getCount(Bucket bucket) const;
+
+private:
+    struct Entry
+    {
+        Bucket bucket;
+        uint32_t awakeUntil;    ///< The object stays active until this update
+        uint32_t frame;         ///< The update in which the bucket was determined
+    };
+
+    /// Get if an object is doing something which requires it to be updated every update.
+    bool isBusy(Object& object) const;
+
+    std::unordered_map<size_t, Entry> _entries; ///< The entries, indexed by object reference
+    uint32_t _frame;
+    bool _enabled;
+    std::array<size_t, 3> _counts;
+};
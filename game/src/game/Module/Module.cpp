@@ -35,6 +35,7 @@
 GameModule::GameModule(const std::shared_ptr<ModuleProfile> &profile, const uint32_t seed) :
     _moduleProfile(profile),
     _gameObjects(),
+    _activityScheduler(),
     _playerList(),
     _teamList(),
     _name(profile->getName()),
@@ -25,6 +25,7 @@
 #include "game/egoboo_typedef.h"
 #include "game/mesh.h"
 #include "game/Module/Water.hpp"
+#include "game/Module/ActivityScheduler.hpp"
 
 //@todo This is an ugly hack to work around cyclic dependency and private header guards
 #ifndef GAME_ENTITIES_PRIVATE
@@ -165,6 +166,12 @@ public:
     **/
     ObjectHandler& getObjectHandler() {return _gameObjects;}
 
+    /**
+    * @return
+    *   Get the ActivityScheduler deciding how often the objects of this Module are updated
+    **/
+    ActivityScheduler& getActivityScheduler() {return _activityScheduler;}
+
     /**
     * @return
     *   true if the specified position is inside the level
@@ -202,6 +209,7 @@ private:
     std::vector<std::shared_ptr<Passage>> _passages;    ///< All passages in this module
     std::vector<Team> _teamList;
     ObjectHandler _gameObjects;
+    ActivityScheduler _activityScheduler;       ///< Reduced rate updates of idle objects
     std::list<std::string> _playerList;     ///< List of all import players
 
     std::string  _name;                       ///< Module load names
@@ -34,7 +34,8 @@ public:
         _spawnPosition(0.0f, 0.0f, 0.0f),
         _safePosition(0.0f, 0.0f, 0.0f),
         _safeValid(false),
-		_tile(Index1D::Invalid)
+		_tile(Index1D::Invalid),
+        _sweepRank(std::numeric_limits<uint32_t>::max())
     {
         //ctor
     }
@@ -239,6 +240,14 @@ private:
      */
     Index1D _tile;
 
+    /**
+     * @brief
+     *  The position of this entity in the last sweep list of the CollisionSystem.
+     *  Only valid if the CollisionSystem remembers this entity at that position.
+     */
+    uint32_t _sweepRank;
+
+    friend class CollisionSystem;
 };
 
 } //Physics
@@ -21,6 +21,7 @@
 #include "game/game.h" //for update_wld
 
 #include "particle_collision.h"
+#include "egolib/Core/JobSystem.hpp"
 
 namespace Ego
 {
@@ -30,7 +31,32 @@ namespace Physics
 static bool do_chr_chr_collision(const std::shared_ptr<Object> &objectA, const std::shared_ptr<Object> &objectB, float tmax, float tmin);
 static void get_recoil_factors( float wta, float wtb, float * recoil_a, float * recoil_b );
 
-CollisionSystem::CollisionSystem()
+//Minimum number of entities handed to a single update job
+static const size_t OBJECT_JOB_GRAIN = 32;
+static const size_t PARTICLE_JOB_GRAIN = 64;
+
+//Convert the volume an oct_bb_t sweeps during this update into a 2D bounding box
+static AABB2f to_aabb2d(const oct_bb_t& oct)
+{
+    return AABB2f(Vector2f(oct._mins[OCT_X], oct._mins[OCT_Y]), Vector2f(oct._maxs[OCT_X], oct._maxs[OCT_Y]));
+}
+
+const uint32_t CollisionSystem::INVALID_INDEX;
+
+CollisionSystem::CollisionSystem() :
+    _objectBounds(),
+    _particleBounds(),
+    _particleCanCollide(),
+    _sweepList(),
+    _sweepOrder(),
+    _sweepRefs(),
+    _objectPairs(),
+    _particleCellCountX(1),
+    _particleCellCountY(1),
+    _particleCellHeads(),
+    _particleCellLinks(),
+    _particleCellRanges(),
+    _particlePairs()
 {
 
 }
@@ -152,121 +178,149 @@ void CollisionSystem::update()
     }
 
     // accumulate the accumulators
-    for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
+    // this only touches the particle itself, so it is done by an update job
+    ParticleHandler::ParticleIterator particleIterator = ParticleHandler::get().iterator();
+    const auto particles = particleIterator.begin();
+    Ego::Core::JobSystem::get().parallelFor(particleIterator.end() - particles, PARTICLE_JOB_GRAIN, [&particles](size_t begin, size_t end)
     {
-        float tmpx, tmpy;
-        bool position_updated = false;
-        Vector3f max_apos;
+        for(size_t i = begin; i < end; ++i)
+        {
+            const std::shared_ptr<Ego::Particle> &particle = particles[i];
+            float tmpx, tmpy;
+            bool position_updated = false;
+            Vector3f max_apos;
 
-        if(particle->isTerminated()) {
-            continue;
-        }
+            if(particle->isTerminated()) {
+                continue;
+            }
 
-        Vector3f tmp_pos = particle->getPosition();
+            Vector3f tmp_pos = particle->getPosition();
 
-        // do the "integration" of the accumulated accelerations
-        particle->vel += particle->phys.avel;
+            // do the "integration" of the accumulated accelerations
+            particle->vel += particle->phys.avel;
 
-        position_updated = false;
+            position_updated = false;
 
-        // get a net displacement vector from aplat and acoll
-        {
-            // create a temporary apos_t
-            apos_t  apos_tmp;
+            // get a net displacement vector from aplat and acoll
+            {
+                // create a temporary apos_t
+                apos_t  apos_tmp;
 
-            // copy 1/2 of the data over
-            apos_tmp = particle->phys.aplat;
+                // copy 1/2 of the data over
+                apos_tmp = particle->phys.aplat;
 
-            // get the resultant apos_t
-            apos_tmp.join(particle->phys.acoll);
+                // get the resultant apos_t
+                apos_tmp.join(particle->phys.acoll);
 
-            // turn this into a vector
-            apos_t::evaluate(apos_tmp, max_apos);
-        }
+                // turn this into a vector
+                apos_t::evaluate(apos_tmp, max_apos);
+            }
 
-        max_apos[kX] = Ego::Math::constrain( max_apos[kX], -Info<float>::Grid::Size(), Info<float>::Grid::Size());
-        max_apos[kY] = Ego::Math::constrain( max_apos[kY], -Info<float>::Grid::Size(), Info<float>::Grid::Size());
-        max_apos[kZ] = Ego::Math::constrain( max_apos[kZ], -Info<float>::Grid::Size(), Info<float>::Grid::Size());
+            max_apos[kX] = Ego::Math::constrain( max_apos[kX], -Info<float>::Grid::Size(), Info<float>::Grid::Size());
+            max_apos[kY] = Ego::Math::constrain( max_apos[kY], -Info<float>::Grid::Size(), Info<float>::Grid::Size());
+            max_apos[kZ] = Ego::Math::constrain( max_apos[kZ], -Info<float>::Grid::Size(), Info<float>::Grid::Size());
 
-        // do the "integration" on the position
-        if (std::abs(max_apos[kX]) > 0.0f)
-        {
-            tmpx = tmp_pos[kX];
-            tmp_pos[kX] += max_apos[kX];
-            if ( EMPTY_BIT_FIELD != particle->test_wall( tmp_pos ) )
+            // do the "integration" on the position
+            if (std::abs(max_apos[kX]) > 0.0f)
             {
-                // restore the old values
-                tmp_pos[kX] = tmpx;
-            }
-            else
-            {
-                //bdl.prt_ptr->vel[kX] += bdl.prt_ptr->phys.apos_coll[kX] * bump_str;
-                position_updated = true;
+                tmpx = tmp_pos[kX];
+                tmp_pos[kX] += max_apos[kX];
+                if ( EMPTY_BIT_FIELD != particle->test_wall( tmp_pos ) )
+                {
+                    // restore the old values
+                    tmp_pos[kX] = tmpx;
+                }
+                else
+                {
+                    //bdl.prt_ptr->vel[kX] += bdl.prt_ptr->phys.apos_coll[kX] * bump_str;
+                    position_updated = true;
+                }
             }
-        }
 
-        if (std::abs(max_apos[kY]) > 0.0f)
-        {
-            tmpy = tmp_pos[kY];
-            tmp_pos[kY] += max_apos[kY];
-            if ( EMPTY_BIT_FIELD != particle->test_wall( tmp_pos ) )
-            {
-                // restore the old values
-                tmp_pos[kY] = tmpy;
-            }
-            else
+            if (std::abs(max_apos[kY]) > 0.0f)
             {
-                //bdl.prt_ptr->vel[kY] += bdl.prt_ptr->phys.apos_coll[kY] * bump_str;
-                position_updated = true;
+                tmpy = tmp_pos[kY];
+                tmp_pos[kY] += max_apos[kY];
+                if ( EMPTY_BIT_FIELD != particle->test_wall( tmp_pos ) )
+                {
+                    // restore the old values
+                    tmp_pos[kY] = tmpy;
+                }
+                else
+                {
+                    //bdl.prt_ptr->vel[kY] += bdl.prt_ptr->phys.apos_coll[kY] * bump_str;
+                    position_updated = true;
+                }
             }
-        }
 
-        if (std::abs(max_apos[kZ]) > 0.0f)
-        {
-            tmp_pos[kZ] += max_apos[kZ];
-            if ( tmp_pos[kZ] < particle->enviro.floor_level )
+            if (std::abs(max_apos[kZ]) > 0.0f)
             {
-                // restore the old values
-                tmp_pos[kZ] = particle->enviro.floor_level;
-                if ( particle->vel[kZ] < 0 )
+                tmp_pos[kZ] += max_apos[kZ];
+                if ( tmp_pos[kZ] < particle->enviro.floor_level )
                 {
-                    particle->vel[kZ] += -( 1.0f + particle->getProfile()->dampen ) * particle->vel[kZ];
+                    // restore the old values
+                    tmp_pos[kZ] = particle->enviro.floor_level;
+                    if ( particle->vel[kZ] < 0 )
+                    {
+                        particle->vel[kZ] += -( 1.0f + particle->getProfile()->dampen ) * particle->vel[kZ];
+                    }
+                    position_updated = true;
+                }
+                else
+                {
+                    //bdl.prt_ptr->vel[kZ] += bdl.prt_ptr->phys.apos_coll[kZ] * bump_str;
+                    position_updated = true;
                 }
-                position_updated = true;
             }
-            else
+
+            // Change the direction of the particle
+            if ( particle->getProfile()->rotatetoface )
             {
-                //bdl.prt_ptr->vel[kZ] += bdl.prt_ptr->phys.apos_coll[kZ] * bump_str;
-                position_updated = true;
+                // Turn to face new direction
+                particle->facing = vec_to_facing( particle->vel[kX] , particle->vel[kY] );
             }
-        }
 
-        // Change the direction of the particle
-        if ( particle->getProfile()->rotatetoface )
-        {
-            // Turn to face new direction
-            particle->facing = vec_to_facing( particle->vel[kX] , particle->vel[kY] );
-        }
-
-        if ( position_updated )
-        {
-            particle->setPosition(tmp_pos);
+            if ( position_updated )
+            {
+                particle->setPosition(tmp_pos);
+            }
         }
-    }
+    });
 }
 
 void CollisionSystem::updateObjectCollisions()
 {
-    std::unordered_set<std::shared_ptr<Object>> handledObjects;
+    ObjectHandler::ObjectIterator iterator = _currentModule->getObjectHandler().iterator();
+    const auto objects = iterator.begin();
+    const size_t objectCount = iterator.end() - objects;
+
+    //Broad-phase: find the volume each object will occupy during this update.
+    //Collision handling does not move objects which can still collide, so these can be computed up front.
+    _objectBounds.resize(objectCount);
+    Ego::Core::JobSystem::get().parallelFor(objectCount, OBJECT_JOB_GRAIN, [this, &objects](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; ++i)
+        {
+            oct_bb_t tmp_oct;
+            if(phys_expand_chr_bb(objects[i].get(), 0.0f, 1.0f, tmp_oct)) {
+                _objectBounds[i] = to_aabb2d(tmp_oct);
+            }
+        }
+    });
+
+    //Find all pairs of objects which might collide
+    findObjectPairs(objects, objectCount);
 
     //Detect character -> character collisions
-    for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator()) {
+    //Pairs are sorted by their first object, so the pairs of each object are handled when it is its turn
+    size_t pair = 0;
+    for(size_t i = 0; i < objectCount; ++i) {
+        const std::shared_ptr<Object> &object = objects[i];
 
         //Can we collide?
         if (!object->canCollide()) {
             continue;
         }
-        handledObjects.insert(object);
 
         //First check if this object is still attached to it's Platform
         const std::shared_ptr<Object> &platform = _currentModule->getObjectHandler()[object->onwhichplatform_ref];
@@ -279,28 +333,16 @@ void CollisionSystem::updateObjectCollisions()
             }
         }
 
-        //TODO: Remove this messy block and replace it with something better
-        // use the object velocity to figure out where the volume that the object will occupy during this update
-        // convert the oct_bb_t to a correct BSP_aabb_t
-        oct_bb_t tmp_oct;
-        phys_expand_chr_bb(object.get(), 0.0f, 1.0f, tmp_oct);
-        const AABB2f aabb2d = AABB2f(Vector2f(tmp_oct._mins[OCT_X], tmp_oct._mins[OCT_Y]), Vector2f(tmp_oct._maxs[OCT_X], tmp_oct._maxs[OCT_Y]));
-
-        //Do not collide scenery with other scenery objects - unless they can use platforms,
-        //for example boxes stacked on top of other boxes
-        bool canCollideWithScenery = !object->isScenery() || object->canuseplatforms;
-
         // Check collisions to nearby Objects
-        std::vector<std::shared_ptr<Object>> possibleCollisions;
-        _currentModule->getObjectHandler().findObjects(aabb2d, possibleCollisions, canCollideWithScenery);
-        for (const std::shared_ptr<Object> &other : possibleCollisions)
+        for(; pair < _objectPairs.size() && _objectPairs[pair].first <= i; ++pair)
         {
-            //Skip possible interactions that have already been handled earlier this iteration
-            if(handledObjects.find(other) != handledObjects.end()) {
+            //Skip pairs of objects which could no longer collide when it was their turn
+            if(_objectPairs[pair].first < i) {
                 continue;
             }
 
             //Can it collide?
+            const std::shared_ptr<Object> &other = objects[_objectPairs[pair].second];
             if(!other->canCollide()) {
                 continue;
             }
@@ -314,11 +356,140 @@ void CollisionSystem::updateObjectCollisions()
     }
 }
 
+void CollisionSystem::findObjectPairs(const std::vector<std::shared_ptr<Object>>::iterator &objects, const size_t objectCount)
+{
+    //Put the collidable objects into the order they had in the sweep list of the last update.
+    //Objects move little between updates, so the list is almost sorted already.
+    _sweepOrder.assign(_sweepRefs.size(), INVALID_INDEX);
+    _sweepList.clear();
+    for(size_t i = 0; i < objectCount; ++i) {
+        const std::shared_ptr<Object> &object = objects[i];
+        if(!object->canCollide()) {
+            continue;
+        }
+
+        const uint32_t rank = object->_sweepRank;
+        if(rank < _sweepRefs.size() && _sweepRefs[rank] == object->getObjRef() && _sweepOrder[rank] == INVALID_INDEX) {
+            _sweepOrder[rank] = i;
+        }
+        else {
+            //New in the sweep list, append these after the known objects
+            _sweepList.push_back(makeSweepEntry(object, i));
+        }
+    }
+    const size_t newcomerCount = _sweepList.size();
+    for(const uint32_t index : _sweepOrder) {
+        if(index != INVALID_INDEX) {
+            _sweepList.push_back(makeSweepEntry(objects[index], index));
+        }
+    }
+    std::rotate(_sweepList.begin(), _sweepList.begin() + newcomerCount, _sweepList.end());
+
+    //Insertion sort along the x-axis, which is about linear for an almost sorted list
+    for(size_t i = 1; i < _sweepList.size(); ++i) {
+        const SweepEntry entry = _sweepList[i];
+        size_t j = i;
+        for(; j > 0 && _sweepList[j-1].minX > entry.minX; --j) {
+            _sweepList[j] = _sweepList[j-1];
+        }
+        _sweepList[j] = entry;
+    }
+
+    //Remember the order for the next update
+    _sweepRefs.clear();
+    for(const SweepEntry &entry : _sweepList) {
+        const std::shared_ptr<Object> &object = objects[entry.index];
+        object->_sweepRank = _sweepRefs.size();
+        _sweepRefs.push_back(object->getObjRef());
+    }
+
+    //Sweep along the x-axis and collect all pairs whose volumes overlap
+    _objectPairs.clear();
+    for(size_t i = 0; i < _sweepList.size(); ++i) {
+        const SweepEntry &a = _sweepList[i];
+        for(size_t j = i + 1; j < _sweepList.size() && _sweepList[j].minX <= a.maxX; ++j) {
+            const SweepEntry &b = _sweepList[j];
+            if(!_objectBounds[a.index].overlaps(_objectBounds[b.index])) {
+                continue;
+            }
+
+            //The object coming first in the object list handles the pair
+            const SweepEntry &first = a.index < b.index ? a : b;
+            const SweepEntry &second = a.index < b.index ? b : a;
+
+            //Do not collide scenery with other scenery objects - unless they can use platforms,
+            //for example boxes stacked on top of other boxes
+            if(second.scenery && !first.collidesWithScenery) {
+                continue;
+            }
+
+            _objectPairs.emplace_back(first.index, second.index);
+        }
+    }
+    std::sort(_objectPairs.begin(), _objectPairs.end());
+}
+
+CollisionSystem::SweepEntry CollisionSystem::makeSweepEntry(const std::shared_ptr<Object> &object, const size_t index) const
+{
+    SweepEntry entry;
+    entry.index = index;
+    entry.minX = _objectBounds[index].getMin()[kX];
+    entry.maxX = _objectBounds[index].getMax()[kX];
+    entry.scenery = object->isScenery();
+    entry.collidesWithScenery = !entry.scenery || object->canuseplatforms;
+    return entry;
+}
+
+void CollisionSystem::clear()
+{
+    _sweepList.clear();
+    _sweepOrder.clear();
+    _sweepRefs.clear();
+    _objectPairs.clear();
+    _particlePairs.clear();
+}
+
+size_t CollisionSystem::getObjectPairCount() const
+{
+    return _objectPairs.size();
+}
+
 void CollisionSystem::updateParticleCollisions()
 {
+    ObjectHandler::ObjectIterator objectIterator = _currentModule->getObjectHandler().iterator();
+    const auto objects = objectIterator.begin();
+    const size_t objectCount = objectIterator.end() - objects;
+
+    ParticleHandler::ParticleIterator iterator = ParticleHandler::get().iterator();
+    const auto particles = iterator.begin();
+    const size_t particleCount = iterator.end() - particles;
+
+    //Broad-phase: find the volume each particle will occupy during this update,
+    //particles which cannot collide (mostly because of their profile) are culled here
+    _particleBounds.resize(particleCount);
+    _particleCanCollide.resize(particleCount);
+    Ego::Core::JobSystem::get().parallelFor(particleCount, PARTICLE_JOB_GRAIN, [this, &particles](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; ++i)
+        {
+            oct_bb_t tmp_oct;
+            _particleCanCollide[i] = particles[i]->canCollide() && phys_expand_prt_bb(particles[i].get(), 0.0f, 1.0f, tmp_oct);
+            if(_particleCanCollide[i]) {
+                _particleBounds[i] = to_aabb2d(tmp_oct);
+            }
+        }
+    });
+
+    //Find all pairs of particles and objects which might collide
+    findParticlePairs(particles, particleCount, objects, objectCount);
+
     //Check collisions with particles
-    for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
+    //Pairs are sorted by their particle, so the pairs of each particle are handled when it is its turn
+    size_t pair = 0;
+    for(size_t i = 0; i < particleCount; ++i)
     {
+        const std::shared_ptr<Ego::Particle> &particle = particles[i];
+
         if(!particle->canCollide()) {
             continue;
         }
@@ -329,18 +500,16 @@ void CollisionSystem::updateParticleCollisions()
             detach_particle_from_platform( particle.get() );
         }
 
-        // use the object velocity to figure out where the volume that the object will occupy during this update
-        // convert the oct_bb_t to a correct AABB2f
-        oct_bb_t   tmp_oct;
-        phys_expand_prt_bb(particle.get(), 0.0f, 1.0f, tmp_oct);
-        const AABB2f aabb2d = AABB2f(Vector2f(tmp_oct._mins[OCT_X], tmp_oct._mins[OCT_Y]), Vector2f(tmp_oct._maxs[OCT_X], tmp_oct._maxs[OCT_Y]));
-
         //Detect collisions with nearby Objects
-        std::vector<std::shared_ptr<Object>> possibleCollisions;
-         _currentModule->getObjectHandler().findObjects(aabb2d, possibleCollisions, true);
-        for (const std::shared_ptr<Object> &object : possibleCollisions)
+        for(; pair < _particlePairs.size() && _particlePairs[pair].first <= i; ++pair)
         {
+            //Skip pairs of particles which could no longer collide when it was their turn
+            if(_particlePairs[pair].first < i) {
+                continue;
+            }
+
             //Is it a valid collision?
+            const std::shared_ptr<Object> &object = objects[_particlePairs[pair].second];
             if(!object->canCollide()) {
                 continue;
             }
@@ -355,6 +524,89 @@ void CollisionSystem::updateParticleCollisions()
     }    
 }
 
+void CollisionSystem::findParticlePairs(const std::vector<std::shared_ptr<Ego::Particle>>::iterator &particles, const size_t particleCount,
+                                        const std::vector<std::shared_ptr<Object>>::iterator &objects, const size_t objectCount)
+{
+    //Use the cells of the object index, covering the entire mesh
+    const float cellSize = Ego::SpatialHash<Object>::DEFAULT_CELL_SIZE;
+    _particleCellCountX = std::max<uint32_t>(1, std::ceil(_currentModule->getMeshPointer()->_info.getTileCountX() * Info<float>::Grid::Size() / cellSize));
+    _particleCellCountY = std::max<uint32_t>(1, std::ceil(_currentModule->getMeshPointer()->_info.getTileCountY() * Info<float>::Grid::Size() / cellSize));
+
+    //Bin all particles which can collide
+    _particleCellHeads.assign(_particleCellCountX * _particleCellCountY, INVALID_INDEX);
+    _particleCellLinks.clear();
+    _particleCellRanges.resize(particleCount);
+    for(size_t i = 0; i < particleCount; ++i) {
+        if(!_particleCanCollide[i]) {
+            continue;
+        }
+
+        const CellRange range = getParticleCellRange(_particleBounds[i]);
+        _particleCellRanges[i] = range;
+        for(uint32_t y = range.minY; y <= range.maxY; ++y) {
+            for(uint32_t x = range.minX; x <= range.maxX; ++x) {
+                uint32_t &head = _particleCellHeads[x + y * _particleCellCountX];
+                _particleCellLinks.emplace_back(i, head);
+                head = _particleCellLinks.size() - 1;
+            }
+        }
+    }
+
+    //Resolve the pairs cell by cell for every object
+    _particlePairs.clear();
+    for(size_t j = 0; j < objectCount; ++j) {
+        const std::shared_ptr<Object> &object = objects[j];
+        if(!object->canCollide()) {
+            continue;
+        }
+
+        const AABB2f objectBounds = object->getAABB2D();
+        const CellRange range = getParticleCellRange(objectBounds);
+        for(uint32_t y = range.minY; y <= range.maxY; ++y) {
+            for(uint32_t x = range.minX; x <= range.maxX; ++x) {
+                for(uint32_t link = _particleCellHeads[x + y * _particleCellCountX]; link != INVALID_INDEX; link = _particleCellLinks[link].second) {
+                    const uint32_t i = _particleCellLinks[link].first;
+
+                    //Only pair the particle in the first cell it shares with the object
+                    const CellRange &particleRange = _particleCellRanges[i];
+                    if(x != std::max(particleRange.minX, range.minX) || y != std::max(particleRange.minY, range.minY)) {
+                        continue;
+                    }
+
+                    if(_particleBounds[i].overlaps(objectBounds)) {
+                        _particlePairs.emplace_back(i, j);
+                    }
+                }
+            }
+        }
+    }
+    std::sort(_particlePairs.begin(), _particlePairs.end());
+}
+
+CollisionSystem::CellRange CollisionSystem::getParticleCellRange(const AABB2f &bounds) const
+{
+    const float invCellSize = 1.0f / Ego::SpatialHash<Object>::DEFAULT_CELL_SIZE;
+    auto toCell = [invCellSize](const float coordinate, const uint32_t cellCount)
+    {
+        const float cell = std::floor(coordinate * invCellSize);
+        if(cell <= 0.0f) return uint32_t(0);
+        if(cell >= cellCount - 1) return cellCount - 1;
+        return static_cast<uint32_t>(cell);
+    };
+
+    CellRange range;
+    range.minX = toCell(bounds.getMin()[kX], _particleCellCountX);
+    range.minY = toCell(bounds.getMin()[kY], _particleCellCountY);
+    range.maxX = toCell(bounds.getMax()[kX], _particleCellCountX);
+    range.maxY = toCell(bounds.getMax()[kY], _particleCellCountY);
+    return range;
+}
+
+size_t CollisionSystem::getParticlePairCount() const
+{
+    return _particlePairs.size();
+}
+
 bool CollisionSystem::detectCollision(const std::shared_ptr<Ego::Particle> &particle, const std::shared_ptr<Object> &object, float *tmin, float *tmax) const
 {
     // particles don't "collide" with anything they are attached to.
@@ -46,7 +46,69 @@ public:
 
     void update();
 
+    /**
+    * @brief
+    *   Forget the broad-phase state of the last update, e.g. when the objects of a module are freed
+    **/
+    void clear();
+
+    /**
+    * @return
+    *   the number of Object pairs found by the broad-phase during the last update
+    **/
+    size_t getObjectPairCount() const;
+
+    /**
+    * @return
+    *   the number of Particle and Object pairs found by the broad-phase during the last update
+    **/
+    size_t getParticlePairCount() const;
+
 private:
+    /// An Object in the sweep list of the broad-phase
+    struct SweepEntry
+    {
+        uint32_t index;             ///< Index of the Object in iteration order
+        float minX;                 ///< Minimum of its broad-phase volume along the x-axis
+        float maxX;                 ///< Maximum of its broad-phase volume along the x-axis
+        bool scenery;               ///< Is the Object a scenery object?
+        bool collidesWithScenery;   ///< Can the Object collide with scenery objects?
+    };
+
+    /**
+    * @brief
+    *   Broad-phase for Object to Object collisions. Sweeps the broad-phase volumes of all
+    *   Objects which can collide along the x-axis and collects the pairs which overlap.
+    * @param objects, objectCount
+    *   All Objects, in iteration order
+    * @remark
+    *   The sweep list is kept between updates and re-sorted with an insertion sort, which is
+    *   about linear as Objects barely move in one update.
+    **/
+    void findObjectPairs(const std::vector<std::shared_ptr<Object>>::iterator &objects, const size_t objectCount);
+
+    SweepEntry makeSweepEntry(const std::shared_ptr<Object> &object, const size_t index) const;
+
+    /// Inclusive range of cells of the particle grid
+    struct CellRange
+    {
+        uint32_t minX, minY, maxX, maxY;
+    };
+
+    /**
+    * @brief
+    *   Broad-phase for Particle to Object collisions. Bins all Particles which can collide into
+    *   the cells of the object index, then collects the Particles overlapping each Object cell by cell.
+    * @param particles, particleCount
+    *   All Particles, in iteration order
+    * @param objects, objectCount
+    *   All Objects, in iteration order
+    **/
+    void findParticlePairs(const std::vector<std::shared_ptr<Ego::Particle>>::iterator &particles, const size_t particleCount,
+                           const std::vector<std::shared_ptr<Object>>::iterator &objects, const size_t objectCount);
+
+    CellRange getParticleCellRange(const AABB2f &bounds) const;
+
     /**
     * @brief
     *   Detects if a collision occurs between two Objects
@@ -103,6 +165,24 @@ protected:
 
     CollisionSystem();
     ~CollisionSystem();
+
+private:
+    std::vector<AABB2f> _objectBounds;      ///< Broad-phase volume of each Object, in iteration order
+    std::vector<AABB2f> _particleBounds;    ///< Broad-phase volume of each Particle, in iteration order
+    std::vector<char> _particleCanCollide;  ///< Can each Particle collide, in iteration order
+
+    static const uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+    std::vector<SweepEntry> _sweepList;     ///< Collidable Objects sorted by the minimum of their volume along the x-axis
+    std::vector<uint32_t> _sweepOrder;      ///< Objects in the order of the last sweep list, INVALID_INDEX for the missing ones
+    std::vector<ObjectRef> _sweepRefs;      ///< The Objects in the last sweep list, each knows its position in it
+    std::vector<std::pair<uint32_t, uint32_t>> _objectPairs;   ///< Pairs of Objects which might collide, sorted
+
+    uint32_t _particleCellCountX;           ///< Number of cells of the particle grid along the x-axis
+    uint32_t _particleCellCountY;           ///< Number of cells of the particle grid along the y-axis
+    std::vector<uint32_t> _particleCellHeads;                       ///< First link of each cell or INVALID_INDEX
+    std::vector<std::pair<uint32_t, uint32_t>> _particleCellLinks;  ///< Particle index and next link of the cell lists
+    std::vector<CellRange> _particleCellRanges;                     ///< Cells covered by each Particle
+    std::vector<std::pair<uint32_t, uint32_t>> _particlePairs;      ///< Pairs of Particle and Object indices which might collide, sorted
 };
 
 } //namespace Physics
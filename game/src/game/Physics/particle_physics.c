@@ -33,6 +33,7 @@
 #include "game/Entities/ParticleHandler.hpp"
 #include "game/Entities/ObjectHandler.hpp"
 #include "game/Physics/PhysicalConstants.hpp"
+#include "egolib/Core/JobSystem.hpp"
 
 static const float STOPBOUNCINGPART = 10.0f;        ///< To make particles stop bouncing
 
@@ -637,6 +638,14 @@ prt_bundle_t *prt_bundle_t::move_one_particle_integrate_motion()
 
 //--------------------------------------------------------------------------------------------
 bool prt_bundle_t::move_one_particle()
+{
+    if (!this->move_one_particle_begin()) return false;
+
+    return this->move_one_particle_end();
+}
+
+//--------------------------------------------------------------------------------------------
+bool prt_bundle_t::move_one_particle_begin()
 {
     if (NULL == this->_prt_ptr) return false;
     Ego::Particle *loc_pprt = this->_prt_ptr;
@@ -664,6 +673,14 @@ bool prt_bundle_t::move_one_particle()
     if (!this->move_one_particle_get_environment()) return false;
     if (!this->_prt_ptr) return false;
 
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------
+bool prt_bundle_t::move_one_particle_end()
+{
+    if (NULL == this->_prt_ptr) return false;
+
     //ZF> Disabled, this doesn't really work yet
     // wind, current, and other fluid friction effects
     //if (!this->move_one_particle_do_fluid_friction()) return false;
@@ -694,14 +711,45 @@ void move_all_particles()
     /// @author ZZ
     /// @details This is the particle physics function
 
-    // move every particle
-    for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
+    // The environment of a particle only depends on the particle itself, the mesh and the
+    // platform it stands on, so it is gathered by an update job. Particles on a platform
+    // may update the platform's matrix and are prepared in order on this thread. The rest
+    // of the motion plays sounds and draws random numbers and is done in order as well.
+    static const size_t PARTICLE_JOB_GRAIN = 64;
+
+    ParticleHandler::ParticleIterator iterator = ParticleHandler::get().iterator();
+
+    std::vector<Ego::Particle *> particles;
+    particles.reserve(ParticleHandler::get().getCount());
+    for(const std::shared_ptr<Ego::Particle> &particle : iterator)
     {
         if(particle->isTerminated()) continue;
+        particles.push_back(particle.get());
+    }
+
+    std::vector<char> prepared(particles.size(), 0);
+    Ego::Core::JobSystem::get().parallelFor(particles.size(), PARTICLE_JOB_GRAIN, [&particles, &prepared](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (_currentModule->getObjectHandler().exists(particles[i]->onwhichplatform_ref)) continue;
+            prepared[i] = prt_bundle_t(particles[i]).move_one_particle_begin();
+        }
+    });
+    for (size_t i = 0; i < particles.size(); ++i)
+    {
+        if (!_currentModule->getObjectHandler().exists(particles[i]->onwhichplatform_ref)) continue;
+        prepared[i] = prt_bundle_t(particles[i]).move_one_particle_begin();
+    }
+
+    // move every particle
+    for (size_t i = 0; i < particles.size(); ++i)
+    {
+        if (!prepared[i]) continue;
 
-        prt_bundle_t prt_bdl = prt_bundle_t(particle.get());
+        prt_bundle_t prt_bdl = prt_bundle_t(particles[i]);
 
-        prt_bdl.move_one_particle();
+        prt_bdl.move_one_particle_end();
     }
 }
 
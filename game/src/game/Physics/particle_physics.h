@@ -61,6 +61,15 @@ struct prt_bundle_t
     /// @brief
     /// The master method to compute a particle's motion.
     bool move_one_particle();
+    /// @brief
+    /// The first half of move_one_particle(): store the old state and get the environment.
+    /// Only writes to this particle and may run in an update job unless the particle stands on a platform.
+    /// @return @a true if move_one_particle_end() should be called for this particle
+    bool move_one_particle_begin();
+    /// @brief
+    /// The second half of move_one_particle(): friction, homing, gravity and the motion itself.
+    /// Must run on the main thread in particle order.
+    bool move_one_particle_end();
 private:
     /// @brief
     /// A helper method to compute the next valid position of this particle.
@@ -45,6 +45,8 @@
 #include "game/Module/Module.hpp"
 #include "game/ObjectAnimation.h"
 #include "game/Physics/CollisionSystem.hpp"
+#include "game/Core/ReplaySystem.hpp"
+#include "egolib/Core/JobSystem.hpp"
 #include "game/physics.h"
 #include "game/Physics/PhysicalConstants.hpp"
 #include "game/Entities/ObjectHandler.hpp"
@@ -76,6 +78,14 @@ Uint32          update_wld       = 0;
 int chr_stoppedby_tests = 0;
 int chr_pressure_tests = 0;
 
+/// Profiling timers for the phases of update_game().
+static Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_misc_timer("update.misc", 512);
+static Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_ai_timer("update.ai", 512);
+static Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_objects_timer("update.objects", 512);
+static Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_movement_timer("update.movement", 512);
+static Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_collisions_timer("update.collisions", 512);
+static Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_camera_timer("update.camera", 512);
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
@@ -89,6 +99,8 @@ static void update_pits();
 static void do_damage_tiles();
 static void set_local_latches();
 static void let_all_characters_think();
+static bool can_character_think(const Object *object);
+static void start_character_think(Object *object, script_run_t& run);
 
 // module initialization / deinitialization - not accessible by scripts
 static bool game_load_module_data( const std::string& smallname );
@@ -416,12 +428,19 @@ void move_all_objects()
 
     move_all_particles();
 
+    ActivityScheduler& activityScheduler = _currentModule->getActivityScheduler();
+
     // Move every character
     for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator())
     {
         if(object->isTerminated()) {
             continue;
         }
+        // Idle objects far away from all players keep animating, but only move when they are due.
+        if(!activityScheduler.isDue(*object)) {
+            move_one_character_do_animation(object.get());
+            continue;
+        }
         object->getObjectPhysics().updatePhysics();
         //chr_update_matrix( object.get(), true );
     }
@@ -551,14 +570,24 @@ int update_game()
     InputSystem::read_mouse();
     InputSystem::read_joysticks();
 
-    set_local_latches();
+    // Live input is ignored while a replay is played back.
+    if (ReplaySystem::get().getMode() != ReplaySystem::Mode::Playback)
+    {
+        set_local_latches();
+    }
 
-    //Rebuild the quadtree for fast object lookup
-    _currentModule->getObjectHandler().updateQuadTree(0.0f, 0.0f, _currentModule->getMeshPointer()->_info.getTileCountX()*Info<float>::Grid::Size(),
+    //Rebuild the spatial index for fast object lookup
+    _currentModule->getObjectHandler().updateSpatialIndex(0.0f, 0.0f, _currentModule->getMeshPointer()->_info.getTileCountX()*Info<float>::Grid::Size(),
 		                                                          _currentModule->getMeshPointer()->_info.getTileCountY()*Info<float>::Grid::Size());
 
+    //Decide which objects think and move during this update
+    ActivityScheduler& activityScheduler = _currentModule->getActivityScheduler();
+    activityScheduler.setEnabled(egoboo_config_t::get().game_activityScheduling_enable.getValue());
+    activityScheduler.update(_currentModule->getObjectHandler(), update_wld);
+
     //---- begin the code for updating misc. game stuff
     {
+        Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(update_misc_timer);
         BillboardSystem::get().update();
         g_animatedTilesState.animate();
         _currentModule->getWater().move();
@@ -572,20 +601,31 @@ int update_game()
     //---- Run AI (but not on first update frame)
     if(update_wld > 0)
     {
+        Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(update_ai_timer);
         let_all_characters_think();           // sets the non-player latches
         net_unbuffer_player_latches();            // sets the player latches
     }
 
     //---- begin the code for updating in-game objects
-    update_all_objects();
     {
+        Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(update_objects_timer);
+        update_all_objects();
+    }
+    {
+        Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(update_movement_timer);
         move_all_objects();                            //movement
+    }
+    {
+        Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(update_collisions_timer);
         Ego::Physics::CollisionSystem::get().update(); //collisions
     }
     //---- end the code for updating in-game objects
 
     // put the camera movement inside here
-    CameraSystem::get()->updateAll(_currentModule->getMeshPointer().get());
+    {
+        Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(update_camera_timer);
+        CameraSystem::get()->updateAll(_currentModule->getMeshPointer().get());
+    }
 
     // Timers
     clock_wld += TICKS_PER_SEC / GameEngine::GAME_TARGET_UPS; ///< 1000 tics per sec / 50 UPS = 20 ticks
@@ -599,9 +639,21 @@ int update_game()
 
     update_wld++;
 
+    ReplaySystem::get().endUpdate();
+
     return 1;
 }
 
+//--------------------------------------------------------------------------------------------
+void log_update_timings()
+{
+    for (const auto *timer : { &update_misc_timer, &update_ai_timer, &update_objects_timer,
+                               &update_movement_timer, &update_collisions_timer, &update_camera_timer })
+    {
+        Log::get().info("%-20s %8.3f ms\n", timer->getName().c_str(), timer->avg() * 1000.0);
+    }
+}
+
 //--------------------------------------------------------------------------------------------
 void game_reset_timers()
 {
@@ -633,60 +685,48 @@ ObjectRef prt_find_target( const Vector3f& pos, FACING_T facing,
     /// @author ZF
     /// @details This is the new improved targeting system for particles. Also includes distance in the Z direction.
 
-    const float max_dist2 = WIDE * WIDE;
-
     std::shared_ptr<pip_t> ppip;
 
-    ObjectRef besttarget = ObjectRef::Invalid;
-    float  longdist2 = max_dist2;
-
     if ( !LOADED_PIP( particletype ) ) return ObjectRef::Invalid;
     ppip = ParticleProfileSystem::get().get_ptr( particletype );
 
-    for(const std::shared_ptr<Object> &pchr : _currentModule->getObjectHandler().iterator())
-    {
-        if ( !pchr->isAlive() || pchr->isitem || _currentModule->getObjectHandler().exists( pchr->inwhich_inventory ) ) continue;
+    Team &particleTeam = _currentModule->getTeamList()[team];
 
-        // prefer targeting riders over the mount itself
-        if ( pchr->isMount() && ( _currentModule->getObjectHandler().exists( pchr->holdingwhich[SLOT_LEFT] ) || _currentModule->getObjectHandler().exists( pchr->holdingwhich[SLOT_RIGHT] ) ) ) continue;
+    const std::shared_ptr<Object> besttarget = _currentModule->getObjectHandler().findNearestObject(pos, WIDE, 0.0f,
+        [&ppip, &particleTeam, &pos, facing, donttarget, oldtarget](const std::shared_ptr<Object> &pchr)
+        {
+            if ( !pchr->isAlive() || pchr->isitem || _currentModule->getObjectHandler().exists( pchr->inwhich_inventory ) ) return false;
 
-        // ignore invictus
-        if ( pchr->invictus ) continue;
+            // prefer targeting riders over the mount itself
+            if ( pchr->isMount() && ( _currentModule->getObjectHandler().exists( pchr->holdingwhich[SLOT_LEFT] ) || _currentModule->getObjectHandler().exists( pchr->holdingwhich[SLOT_RIGHT] ) ) ) return false;
 
-        // we are going to give the player a break and not target things that
-        // can't be damaged, unless the particle is homing. If it homes in,
-        // the he damage_timer could drop off en route.
-        if ( !ppip->homing && ( 0 != pchr->damage_timer ) ) continue;
+            // ignore invictus
+            if ( pchr->invictus ) return false;
 
-        // Don't retarget someone we already had or not supposed to target
-        if ( pchr->getObjRef() == oldtarget || pchr->getObjRef() == donttarget ) continue;
+            // we are going to give the player a break and not target things that
+            // can't be damaged, unless the particle is homing. If it homes in,
+            // the he damage_timer could drop off en route.
+            if ( !ppip->homing && ( 0 != pchr->damage_timer ) ) return false;
 
-        Team &particleTeam = _currentModule->getTeamList()[team];
+            // Don't retarget someone we already had or not supposed to target
+            if ( pchr->getObjRef() == oldtarget || pchr->getObjRef() == donttarget ) return false;
 
-        bool target_friend = ppip->onlydamagefriendly && particleTeam == pchr->getTeam();
-        bool target_enemy  = !ppip->onlydamagefriendly && particleTeam.hatesTeam(pchr->getTeam() );
+            bool target_friend = ppip->onlydamagefriendly && particleTeam == pchr->getTeam();
+            bool target_enemy  = !ppip->onlydamagefriendly && particleTeam.hatesTeam(pchr->getTeam() );
+            if ( !target_friend && !target_enemy ) return false;
 
-        if ( target_friend || target_enemy )
-        {
+            // Only proceed if we are facing the target
             FACING_T angle = - facing + vec_to_facing( pchr->getPosX() - pos[kX] , pchr->getPosY() - pos[kY] );
+            return angle < ppip->targetangle || angle > ( 0xFFFF - ppip->targetangle );
+        },
+        nullptr);
 
-            // Only proceed if we are facing the target
-            if ( angle < ppip->targetangle || angle > ( 0xFFFF - ppip->targetangle ) )
-            {
-                float dist2 = (pchr->getPosition() - pos).length_2();
+    if ( !besttarget ) return ObjectRef::Invalid;
 
-                if ( dist2 < longdist2 && dist2 <= max_dist2 )
-                {
-                    (*targetAngle) = angle;
-                    besttarget = pchr->getObjRef();
-                    longdist2 = dist2;
-                }
-            }
-        }
-    }
+    (*targetAngle) = - facing + vec_to_facing( besttarget->getPosX() - pos[kX] , besttarget->getPosY() - pos[kY] );
 
     // All done
-    return besttarget;
+    return besttarget->getObjRef();
 }
 
 //--------------------------------------------------------------------------------------------
@@ -786,79 +826,34 @@ ObjectRef chr_find_target( Object * psrc, float max_dist, IDSZ idsz, const BIT_F
 
     if (!psrc || psrc->isTerminated()) return ObjectRef::Invalid;
 
-    std::vector<std::shared_ptr<Object>> searchList;
-
-    //Only loop through the players
-    if ( HAS_SOME_BITS( targeting_bits, TARGET_PLAYERS ) || HAS_SOME_BITS( targeting_bits, TARGET_QUEST ) )
-    {
-        for (PLA_REF ipla = 0; ipla < MAX_PLAYER; ipla++)
-        {
-            if (!PlaStack.lst[ipla].valid) continue;
-
-            const std::shared_ptr<Object> &player = _currentModule->getObjectHandler()[PlaStack.lst[ipla].index];
-            if(player) {
-
-                //Within range?
-                float distance = (player->getPosition() - psrc->getPosition()).length();
-                if(max_dist == NEAREST || distance < max_dist) {
-                    searchList.push_back(player);
-                }
-
-            }
-        }
-    }
-
-    //All objects in level
-    else if(max_dist == NEAREST)
-    {
-        searchList = _currentModule->getObjectHandler().getAllObjects();
-    }
-
-    //All objects within range
-    else
-    {
-        searchList = _currentModule->getObjectHandler().findObjects(psrc->getPosX(), psrc->getPosY(), max_dist, true);
-    }
-
-
     // set the line-of-sight source
     los_info.x0         = psrc->getPosX();
     los_info.y0         = psrc->getPosY();
     los_info.z0         = psrc->getPosZ() + psrc->bump.height;
     los_info.stopped_by = psrc->stoppedby;
 
-    ObjectRef best_target = ObjectRef::Invalid;
-    float best_dist2  = (max_dist == NEAREST) ? std::numeric_limits<float>::max() : max_dist*max_dist + 1.0f;
-    for(const std::shared_ptr<Object> &ptst : searchList)
-    {
-        if(ptst->isTerminated()) continue;
-
-        //Skip held items
-        if(ptst->isBeingHeld()) continue;
-
-        if ( !chr_check_target( psrc, ptst->getObjRef(), idsz, targeting_bits ) ) continue;
+    const std::shared_ptr<Object> best_target = _currentModule->getObjectHandler().findNearestObject(psrc->getPosition(), max_dist, 1.0f,
+        [psrc, idsz, targeting_bits](const std::shared_ptr<Object> &ptst)
+        {
+            //Skip held items
+            if(ptst->isBeingHeld()) return false;
 
-		float dist2 = (psrc->getPosition() - ptst->getPosition()).length_2();
-        if (dist2 < best_dist2)
+            return chr_check_target( psrc, ptst->getObjRef(), idsz, targeting_bits );
+        },
+        [psrc, &los_info](const std::shared_ptr<Object> &ptst)
         {
             //Invictus chars do not need a line of sight
-            if ( !psrc->isInvincible() )
-            {
-                // set the line-of-sight source
-                los_info.x1 = ptst->getPosition()[kX];
-                los_info.y1 = ptst->getPosition()[kY];
-                los_info.z1 = ptst->getPosition()[kZ] + std::max( 1.0f, ptst->bump.height );
+            if ( psrc->isInvincible() ) return true;
 
-                if ( line_of_sight_info_t::blocked( los_info, _currentModule->getMeshPointer() ) ) continue;
-            }
+            // set the line-of-sight target
+            los_info.x1 = ptst->getPosition()[kX];
+            los_info.y1 = ptst->getPosition()[kY];
+            los_info.z1 = ptst->getPosition()[kZ] + std::max( 1.0f, ptst->bump.height );
 
-            //Set the new best target found
-            best_target = ptst->getObjRef();
-            best_dist2  = dist2;
-        }
-    }
+            return !line_of_sight_info_t::blocked( los_info, _currentModule->getMeshPointer() );
+        });
 
-    return best_target;
+    return best_target ? best_target->getObjRef() : ObjectRef::Invalid;
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1656,6 +1651,9 @@ void game_load_profile_ai()
     // ensure that the script parser exists
     parser_state_t& ps = parser_state_t::get();
 
+    // the scripts are compiled against the function table of the script runtime
+    scripting_system_begin();
+
     for (const auto &element : ProfileSystem::get().getLoadedProfiles())
     {
         const std::shared_ptr<ObjectProfile> &profile = element.second;
@@ -1683,17 +1681,20 @@ void game_load_module_profiles( const std::string& modname )
     import_data.slot = -100;
     make_newloadname( modname.c_str(), "objects", newloadname );
 
+    std::vector<std::string> folderPaths;
     ctxt = vfs_findFirst( newloadname, "obj", VFS_SEARCH_DIR );
     filehandle = vfs_search_context_get_current( ctxt );
 
     while ( NULL != ctxt && VALID_CSTR( filehandle ) )
     {
-        ProfileSystem::get().loadOneProfile(filehandle);
+        folderPaths.push_back(filehandle);
 
         ctxt = vfs_findNext( &ctxt );
         filehandle = vfs_search_context_get_current( ctxt );
     }
     vfs_findClose( &ctxt );
+
+    ProfileSystem::get().loadProfiles(folderPaths);
 }
 
 //--------------------------------------------------------------------------------------------
@@ -2185,6 +2186,9 @@ void game_quit_module()
     /// @author BB
     /// @details all of the de-initialization code after the module actually ends
 
+    // finish the replay of the module
+    ReplaySystem::get().endModule();
+
     // stop the module
     _currentModule.reset(nullptr);
 
@@ -2211,7 +2215,7 @@ bool game_begin_module(const std::shared_ptr<ModuleProfile> &module)
     if ( !setup_init_module_vfs_paths( module->getPath().c_str() ) ) return false;
 
     // start the module
-    _currentModule = std::unique_ptr<GameModule>(new GameModule(module, time(NULL)));
+    _currentModule = std::unique_ptr<GameModule>(new GameModule(module, ReplaySystem::get().beginModule(module->getFolderName(), time(NULL))));
 
     // load all the in-game module data
     if ( !game_load_module_data( module->getPath().c_str() ) )
@@ -2338,44 +2342,116 @@ void let_all_characters_think()
 {
     /// @author ZZ
     /// @details This function funst the ai scripts for all eligible objects
-    for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator())
+
+    // The scripts are run in two phases. The first phase runs every script up to its first
+    // instruction which affects more than the object itself, which is done by update jobs.
+    // The second phase finishes the scripts one after another in object order, so anything
+    // touching other objects, spawning or drawing random numbers happens in a fixed order.
+    static const size_t SCRIPT_JOB_GRAIN = 16;
+
+    // Make sure that the scripting system is initialized before the jobs run.
+    scripting_system_begin();
+
+    // Keep the object list locked until all scripts are finished.
+    ObjectHandler::ObjectIterator iterator = _currentModule->getObjectHandler().iterator();
+
+    // Idle objects far away from all players only think when they are due.
+    ActivityScheduler& activityScheduler = _currentModule->getActivityScheduler();
+
+    std::vector<Object *> thinkers;
+    for(const std::shared_ptr<Object> &object : iterator)
     {
-        if(object->isTerminated()) {
-            continue;
+        if(can_character_think(object.get()) && activityScheduler.isDue(*object)) {
+            thinkers.push_back(object.get());
         }
+    }
 
-        //Only inventory items marked as equipment has active AI scripts
-        if(object->isInsideInventory() && !object->getProfile()->isEquipment()) {
-            continue;
-        }
-        
-        // check for actions that must always be handled
-        bool is_cleanedup = HAS_SOME_BITS( object->ai.alert, ALERTIF_CLEANEDUP );
-        bool is_crushed   = HAS_SOME_BITS( object->ai.alert, ALERTIF_CRUSHED );
+    // Script tracing runs whole scripts in the first phase, so every script is started right
+    // before it is finished then. Otherwise the first phase is done for all thinkers before the
+    // first script is finished, with or without update jobs, so both give the same result.
+    const bool tracing = debug_scripts;
 
-        // only let dead/destroyed things think if they have beem crushed/cleanedup
-        if (object->isAlive() || is_crushed || is_cleanedup )
-        {
-            // Figure out alerts that weren't already set
-            set_alerts(object->getObjRef());
+    // Script profiling is not thread-safe.
+    const bool profiling = egoboo_config_t::get().debug_scriptProfiling_enable.getValue();
 
-            // Cleaned up characters shouldn't be alert to anything else
-            if (is_cleanedup) { 
-                object->ai.alert = ALERTIF_CLEANEDUP; 
-                /*object->ai.timer = update_wld + 1;*/ 
+    std::vector<script_run_t> runs(thinkers.size());
+    if (!tracing)
+    {
+        auto job = [&thinkers, &runs](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                start_character_think(thinkers[i], runs[i]);
             }
+        };
+        if (profiling)
+        {
+            job(0, thinkers.size());
+        }
+        else
+        {
+            Ego::Core::JobSystem::get().parallelFor(thinkers.size(), SCRIPT_JOB_GRAIN, job);
+        }
+    }
 
-            // Crushed characters shouldn't be alert to anything else
-            if (is_crushed)  { 
-                object->ai.alert = ALERTIF_CRUSHED; 
-                object->ai.timer = update_wld + 1;  //Prevents IfTimeOut from triggering
-            }
+    for (size_t i = 0; i < thinkers.size(); ++i)
+    {
+        Object *object = thinkers[i];
 
-            scr_run_chr_script(object.get());
+        // Objects might have been changed by the scripts finished before them,
+        // if they can no longer think the result of the first phase is dropped.
+        if (!can_character_think(object)) continue;
+        if (tracing)
+        {
+            start_character_think(object, runs[i]);
         }
+        scr_finish_chr_script(object, runs[i]);
     }
 }
 
+//--------------------------------------------------------------------------------------------
+bool can_character_think(const Object *object)
+{
+    if(object->isTerminated()) {
+        return false;
+    }
+
+    //Only inventory items marked as equipment has active AI scripts
+    if(object->isInsideInventory() && !object->getProfile()->isEquipment()) {
+        return false;
+    }
+
+    // only let dead/destroyed things think if they have beem crushed/cleanedup
+    return object->isAlive() || HAS_SOME_BITS( object->ai.alert, ALERTIF_CRUSHED | ALERTIF_CLEANEDUP );
+}
+
+//--------------------------------------------------------------------------------------------
+void start_character_think(Object *object, script_run_t& run)
+{
+    /// @details This function polls the alerts of an object and runs the local part of its script
+
+    // check for actions that must always be handled
+    bool is_cleanedup = HAS_SOME_BITS( object->ai.alert, ALERTIF_CLEANEDUP );
+    bool is_crushed   = HAS_SOME_BITS( object->ai.alert, ALERTIF_CRUSHED );
+
+    // Figure out alerts that weren't already set
+    set_alerts(object->getObjRef());
+
+    // Cleaned up characters shouldn't be alert to anything else
+    if (is_cleanedup) { 
+        object->ai.alert = ALERTIF_CLEANEDUP; 
+        /*object->ai.timer = update_wld + 1;*/ 
+    }
+
+    // Crushed characters shouldn't be alert to anything else
+    if (is_crushed)  { 
+        object->ai.alert = ALERTIF_CRUSHED; 
+        object->ai.timer = update_wld + 1;  //Prevents IfTimeOut from triggering
+    }
+
+    scr_run_chr_script_local(object, run);
+}
+
 //--------------------------------------------------------------------------------------------
 void free_all_objects()
 {
@@ -2385,6 +2461,9 @@ void free_all_objects()
     //free all particles
     ParticleHandler::get().clear();
 
+    //forget the objects of the collision broad-phase
+    Ego::Physics::CollisionSystem::get().clear();
+
     // free all the characters
     if(_currentModule) {
         _currentModule->getObjectHandler().clear();
@@ -135,6 +135,9 @@ struct AnimatedTilesState {
 
 int update_game();
 
+/// Write the average durations of the phases of update_game() over the last 512 updates to the log.
+void log_update_timings();
+
 //--------------------------------------------------------------------------------------------
 
 /// The actual in-game state of the damage tiles
@@ -41,9 +41,12 @@
 #include "game/char.h"
 #include "game/mesh.h"
 #include "game/Graphics/CameraSystem.hpp"
+#include "game/Graphics/MeshChunks.hpp"
+#include "game/Physics/CollisionSystem.hpp"
 #include "game/Module/Module.hpp"
 #include "game/Entities/_Include.hpp"
 #include "egolib/FileFormats/Globals.hpp"
+#include "egolib/Core/JobSystem.hpp"
 #include "game/Graphics/TextureAtlasManager.hpp"
 
 //--------------------------------------------------------------------------------------------
@@ -318,6 +321,7 @@ void GFX::uninitialize()
 
 void GFX::uninitializeOpenGL()
 {
+    Ego::VertexArena::uninitialize();
     TextureManager::uninitialize();
     Ego::Renderer::uninitialize();
 }
@@ -329,6 +333,8 @@ int GFX::initializeOpenGL()
     Renderer::initialize(); ///< @todo Add error handling.
     // Start-up the texture manager.
     TextureManager::initialize(); ///< @todo Add error handling.
+    // Start-up the allocator for transient vertices.
+    VertexArena::initialize();
 
     auto& renderer = Renderer::get();
     // Set clear colour and clear depth.
@@ -873,6 +879,19 @@ float draw_debug(float y)
         y = draw_string_raw(0, y, "!!!DEBUG MODE-6!!!");
         y = draw_string_raw(0, y, "~~FREEPRT %" PRIuZ, ParticleHandler::get().getFreeCount());
         y = draw_string_raw(0, y, "~~FREECHR %" PRIuZ, OBJECTS_MAX - _currentModule->getObjectHandler().getObjectCount());
+        y = draw_string_raw(0, y, "~~CHRPAIRS %" PRIuZ, Ego::Physics::CollisionSystem::get().getObjectPairCount());
+        y = draw_string_raw(0, y, "~~PRTPAIRS %" PRIuZ, Ego::Physics::CollisionSystem::get().getParticlePairCount());
+        {
+            const ActivityScheduler& activityScheduler = _currentModule->getActivityScheduler();
+            y = draw_string_raw(0, y, "~~ACTIVECHR %" PRIuZ "/%" PRIuZ "/%" PRIuZ,
+                                activityScheduler.getCount(ActivityScheduler::Bucket::Active),
+                                activityScheduler.getCount(ActivityScheduler::Bucket::LowFrequency),
+                                activityScheduler.getCount(ActivityScheduler::Bucket::Sleeping));
+        }
+        y = draw_string_raw(0, y, "~~MESHDRAWS %" PRIuZ " %" PRIuZ " %" PRIuZ,
+                            Ego::Graphics::RenderPasses::g_nonReflective._drawCalls,
+                            Ego::Graphics::RenderPasses::g_reflective0._drawCalls,
+                            Ego::Graphics::RenderPasses::g_reflective1._drawCalls);
 #if 0
         y = draw_string_raw( 0, y, "~~MACHINE %d", egonet_get_local_machine() );
 #endif
@@ -1852,6 +1871,12 @@ void GridIllumination::light_fans_update_clst(Ego::Graphics::TileList& tl)
 				= INV_FF<float>() * Ego::Math::constrain(light, 0.0f, 255.0f);
         }
 
+        // the baked tiles need the new colours
+        if (mesh->_chunks)
+        {
+            mesh->_chunks->invalidateColours(*mesh, fan);
+        }
+
         // clear out the deltas
         ptile._vertexLightingCache._d1_cache.fill(0.0f);
         ptile._vertexLightingCache._d2_cache.fill(0.0f);
@@ -2038,6 +2063,90 @@ gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& cam)
     return gfx_success;
 }
 
+//--------------------------------------------------------------------------------------------
+dynalight_grid_t::dynalight_grid_t() :
+    _x0(0.0f), _y0(0.0f),
+    _cellCountX(0), _cellCountY(0),
+    _cellStarts(), _lights()
+{}
+
+int dynalight_grid_t::toCell(float offset, int cellCount) const
+{
+    int cell = std::floor(offset / (Info<float>::Grid::Size() * CELL_TILES));
+    return Ego::Math::constrain(cell, 0, cellCount - 1);
+}
+
+void dynalight_grid_t::build(const dynalight_registry_t reg[], size_t reg_count, float margin)
+{
+    _cellCountX = _cellCountY = 0;
+    if (0 == reg_count) return;
+
+    // find the area covered by the lights
+    float x1, y1;
+    _x0 = reg[0].bound.xmin - margin; x1 = reg[0].bound.xmax + margin;
+    _y0 = reg[0].bound.ymin - margin; y1 = reg[0].bound.ymax + margin;
+    for (size_t cnt = 1; cnt < reg_count; cnt++)
+    {
+        _x0 = std::min(_x0, reg[cnt].bound.xmin - margin); x1 = std::max(x1, reg[cnt].bound.xmax + margin);
+        _y0 = std::min(_y0, reg[cnt].bound.ymin - margin); y1 = std::max(y1, reg[cnt].bound.ymax + margin);
+    }
+
+    const float cellSize = Info<float>::Grid::Size() * CELL_TILES;
+    _cellCountX = std::max(1, (int)std::ceil((x1 - _x0) / cellSize));
+    _cellCountY = std::max(1, (int)std::ceil((y1 - _y0) / cellSize));
+
+    // count the lights of each cell ...
+    _cellStarts.assign(_cellCountX * _cellCountY + 1, 0);
+    for (size_t cnt = 0; cnt < reg_count; cnt++)
+    {
+        const ego_frect_t& bound = reg[cnt].bound;
+        for (int iy = toCell(bound.ymin - margin - _y0, _cellCountY); iy <= toCell(bound.ymax + margin - _y0, _cellCountY); iy++)
+        {
+            for (int ix = toCell(bound.xmin - margin - _x0, _cellCountX); ix <= toCell(bound.xmax + margin - _x0, _cellCountX); ix++)
+            {
+                _cellStarts[ix + iy * _cellCountX + 1]++;
+            }
+        }
+    }
+    for (size_t cell = 1; cell < _cellStarts.size(); cell++)
+    {
+        _cellStarts[cell] += _cellStarts[cell - 1];
+    }
+
+    // ... and fill them in registry order. The starts are shifted by one cell while filling.
+    _lights.resize(_cellStarts.back());
+    for (size_t cnt = 0; cnt < reg_count; cnt++)
+    {
+        const ego_frect_t& bound = reg[cnt].bound;
+        for (int iy = toCell(bound.ymin - margin - _y0, _cellCountY); iy <= toCell(bound.ymax + margin - _y0, _cellCountY); iy++)
+        {
+            for (int ix = toCell(bound.xmin - margin - _x0, _cellCountX); ix <= toCell(bound.xmax + margin - _x0, _cellCountX); ix++)
+            {
+                _lights[_cellStarts[ix + iy * _cellCountX]++] = cnt;
+            }
+        }
+    }
+    for (size_t cell = _cellStarts.size() - 1; cell > 0; cell--)
+    {
+        _cellStarts[cell] = _cellStarts[cell - 1];
+    }
+    _cellStarts[0] = 0;
+}
+
+size_t dynalight_grid_t::find(float x, float y, const uint16_t *& lst) const
+{
+    const float cellSize = Info<float>::Grid::Size() * CELL_TILES;
+    if (0 == _cellCountX || x < _x0 || y < _y0 || x > _x0 + _cellCountX * cellSize || y > _y0 + _cellCountY * cellSize)
+    {
+        lst = nullptr;
+        return 0;
+    }
+
+    const int cell = toCell(x - _x0, _cellCountX) + toCell(y - _y0, _cellCountY) * _cellCountX;
+    lst = _lights.data() + _cellStarts[cell];
+    return _cellStarts[cell + 1] - _cellStarts[cell];
+}
+
 //--------------------------------------------------------------------------------------------
 gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_t& dyl, Camera& cam)
 {
@@ -2059,6 +2168,8 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
     ego_frect_t mesh_bound, light_bound;
     dynalight_data_t fake_dynalight;
 
+    dynalight_grid_t& light_grid = dyl.grid;
+
 	auto mesh = tl.getMesh();
     if (!mesh)
     {
@@ -2203,6 +2314,12 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
         }
     }
 
+    // bin the lights. a grid vertex is lit by the lights overlapping the grid box around it
+    if (needs_dynalight)
+    {
+        light_grid.build(reg, reg_count, Info<float>::Grid::Size() * 0.5f);
+    }
+
     // sum up the lighting from global sources
     sum_global_lighting(global_lighting);
 
@@ -2270,11 +2387,15 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
                 if (fgrid_rect.ymin <= light_bound.ymax && fgrid_rect.ymax >= light_bound.ymin)
                 {
                     // this grid has dynamic lighting. add it.
-                    for (cnt = 0; cnt < reg_count; cnt++)
+                    const uint16_t *cell_lst;
+                    const size_t cell_count = light_grid.find(x0, y0, cell_lst);
+                    for (size_t light = 0; light < cell_count; light++)
                     {
 						Vector3f nrm;
                         dynalight_data_t *pdyna;
 
+                        cnt = cell_lst[light];
+
                         // does this dynamic light intersects this grid?
                         if (fgrid_rect.xmin > reg[cnt].bound.xmax || fgrid_rect.xmax < reg[cnt].bound.xmin) continue;
                         if (fgrid_rect.ymin > reg[cnt].bound.ymax || fgrid_rect.ymax < reg[cnt].bound.ymin) continue;
@@ -2323,48 +2444,66 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
 //--------------------------------------------------------------------------------------------
 gfx_rv gfx_make_tileList(Ego::Graphics::TileList& tl, Camera& cam)
 {
-	// @a true if clipping is enabled, @a false otherwise.
-	static const bool clippingEnabled = true;
-
-    // Because the main loop of the program will always flip the
-    // page before rendering the 1st frame of the actual game,
-    // game_frame_all will always start at 1
-    if (1 != (game_frame_all & 3))
-    {
-        return gfx_success;
-    }
-
     // reset the renderlist
     if (gfx_error == tl.reset())
     {
         return gfx_error;
     }
 
-    // get the tiles in the center of the view (TODO: calculate actual tile view from camera frustrum)
-	int startX, startY, endX, endY;
-	if (clippingEnabled)
-	{
-		static const float offset = 10;
-		float centerX = cam.getTrackPosition()[kX] / Info<float>::Grid::Size();
-		float centerY = cam.getTrackPosition()[kY] / Info<float>::Grid::Size();
-		startX = Ego::Math::constrain<int>(centerX - offset, 0, _currentModule->getMeshPointer()->_info.getTileCountX());
-		startY = Ego::Math::constrain<int>(centerY - offset, 0, _currentModule->getMeshPointer()->_info.getTileCountY());
-		endX = Ego::Math::constrain<int>(centerX + offset, 0, _currentModule->getMeshPointer()->_info.getTileCountX());
-		endY = Ego::Math::constrain<int>(centerY + offset, 0, _currentModule->getMeshPointer()->_info.getTileCountY());
-	}
-	else
-	{
-		startX = 0;
-		startY = 0;
-		endX = _currentModule->getMeshPointer()->_info.getTileCountX();
-		endY = _currentModule->getMeshPointer()->_info.getTileCountY();
-	}
-    for(size_t x = startX; x < endX; ++x) {
-        for(size_t y = startY; y < endY; ++y) {
-            if (gfx_error == tl.add(x + y * _currentModule->getMeshPointer()->_info.getTileCountX(), cam))
+    auto mesh = tl.getMesh();
+    const MeshBlocks& blocks = mesh->_blocks;
+    const uint32_t tileCountX = mesh->_info.getTileCountX();
+    const uint32_t tileCountY = mesh->_info.getTileCountY();
+
+    // Cull the blocks of the mesh against the view frustum.
+    std::vector<uint32_t>& visibleBlocks = tl._visibleBlocks;
+    blocks.findVisible(cam.getFrustum(), visibleBlocks);
+
+    // Add the blocks nearest to the camera first: if the tile list runs full, the farthest tiles are dropped.
+    const Vector2f center = Vector2f(cam.getTrackPosition()[kX], cam.getTrackPosition()[kY]);
+    auto distance = [&blocks, &center](uint32_t block)
+    {
+        const Vector3f blockCenter = blocks.getBounds(block).getCenter();
+        return (Vector2f(blockCenter[kX], blockCenter[kY]) - center).length_2();
+    };
+    std::sort(visibleBlocks.begin(), visibleBlocks.end(), [&distance](uint32_t x, uint32_t y) { return distance(x) < distance(y); });
+
+    for (uint32_t block : visibleBlocks)
+    {
+        bool complete = true;
+        const size_t reflectiveStart = tl._reflective.size;
+        const size_t nonReflectiveStart = tl._nonReflective.size;
+        const uint32_t startX = (block % blocks.getBlockCountX()) * MeshBlocks::BLOCK_SIZE;
+        const uint32_t startY = (block / blocks.getBlockCountX()) * MeshBlocks::BLOCK_SIZE;
+        const uint32_t endX = std::min(startX + MeshBlocks::BLOCK_SIZE, tileCountX);
+        const uint32_t endY = std::min(startY + MeshBlocks::BLOCK_SIZE, tileCountY);
+        for (uint32_t y = startY; y < endY; ++y)
+        {
+            for (uint32_t x = startX; x < endX; ++x)
             {
-                return gfx_error;
-            }        
+                gfx_rv rv = tl.add(x + y * tileCountX, cam);
+                if (gfx_error == rv)
+                {
+                    return gfx_error;
+                }
+                complete = complete && gfx_success == rv;
+            }
+        }
+        if (complete)
+        {
+            tl._blocks.push_back(block);
+        }
+        else
+        {
+            // The tiles of this block are drawn one by one.
+            for (size_t i = reflectiveStart; i < tl._reflective.size; ++i)
+            {
+                tl._reflectiveRest.push(tl._reflective.lst[i]._index, tl._reflective.lst[i]._distance);
+            }
+            for (size_t i = nonReflectiveStart; i < tl._nonReflective.size; ++i)
+            {
+                tl._nonReflectiveRest.push(tl._nonReflective.lst[i]._index, tl._nonReflective.lst[i]._distance);
+            }
         }
     }
 
@@ -2521,12 +2660,19 @@ gfx_rv gfx_update_flashing(Ego::Graphics::EntityList& el)
 //--------------------------------------------------------------------------------------------
 gfx_rv gfx_update_all_chr_instance()
 {
+    static const size_t INSTANCE_JOB_GRAIN = 8;
+
     gfx_rv retval;
     gfx_rv tmp_rv;
 
     // assume the best
     retval = gfx_success;
 
+    // gather the instances. Instances which are up to date only need their collision
+    // bound refreshed, broken instances take the serial path so that errors are reported
+    // from this thread.
+    std::vector<Object *> updated, pending;
+    auto mesh = _currentModule->getMeshPointer();
     for (const std::shared_ptr<Object> &pchr : _currentModule->getObjectHandler().iterator())
     {
         //Dont do terminated characters
@@ -2534,23 +2680,78 @@ gfx_rv gfx_update_all_chr_instance()
             continue;
         }
 
-		auto mesh = _currentModule->getMeshPointer();
         if (!mesh->grid_is_valid(pchr->getTile())) continue;
 
-        tmp_rv = update_one_chr_instance(pchr.get());
+        const chr_instance_t& pinst = pchr->inst;
+        if (pinst.update_frame >= 0 && (Uint32)pinst.update_frame >= game_frame_all) {
+            updated.push_back(pchr.get());
+        } else if (chr_instance_t::is_consistent(pinst)) {
+            pending.push_back(pchr.get());
+        } else {
+            tmp_rv = update_one_chr_instance(pchr.get());
+            if (gfx_error == tmp_rv) {
+                retval = gfx_error;
+            } else if (gfx_success == tmp_rv) {
+                updated.push_back(pchr.get());
+            }
+        }
+    }
+
+    Ego::Core::JobSystem& jobSystem = Ego::Core::JobSystem::get();
+
+    // interpolate the vertices. this only touches the instance itself.
+    std::vector<gfx_rv> results(pending.size(), gfx_success);
+    jobSystem.parallelFor(pending.size(), INSTANCE_JOB_GRAIN, [&pending, &results](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            results[i] = chr_instance_t::update_vertices(pending[i]->inst, -1, -1, true);
+        }
+    });
+
+    // update the matrices. this might update the holder and the grip vertices of the held items,
+    // so it is done in order on this thread.
+    std::vector<char> lit(pending.size(), 0);
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        if (gfx_error == results[i]) continue;
+        lit[i] = chr_instance_t::begin_lighting_update(pending[i]->inst, pending[i], false);
+    }
 
+    // do the basic lighting
+    jobSystem.parallelFor(pending.size(), INSTANCE_JOB_GRAIN, [&pending, &lit](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (!lit[i]) continue;
+            chr_instance_t::update_lighting_vertices(pending[i]->inst, pending[i]);
+        }
+    });
+
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
         // deal with return values
-        if (gfx_error == tmp_rv)
+        if (gfx_error == results[i])
         {
             retval = gfx_error;
+            continue;
         }
-        else if (gfx_success == tmp_rv)
+
+        // set the update_frame to the current frame
+        pending[i]->inst.update_frame = game_frame_all;
+
+        if (gfx_success == results[i])
         {
-            // the instance has changed, refresh the collision bound
-            pchr->getObjectPhysics().updateCollisionSize(true);
+            updated.push_back(pending[i]);
         }
     }
 
+    // the instances have changed, refresh the collision bounds
+    for (Object *pchr : updated)
+    {
+        pchr->getObjectPhysics().updateCollisionSize(true);
+    }
+
     return retval;
 }
 
@@ -438,24 +438,50 @@ float draw_game_icon(const Ego::Texture* icontype, float x, float y, Uint8 spark
 void draw_blip(float sizeFactor, Uint8 color, float x, float y);
 void draw_mouse_cursor();
 
+/// Structure for keeping track of which dynalights are visible
+struct dynalight_registry_t {
+    int reference;
+    ego_frect_t bound;
+};
+
+/// Bins the visible dynalights into coarse cells over the mesh, so that lighting a grid vertex
+/// only has to look at the lights near it instead of all lights.
+struct dynalight_grid_t {
+    /// The edge length of a cell in tiles.
+    static const int CELL_TILES = 4;
+
+    dynalight_grid_t();
+
+    /// Bin the registered dynalights. A light is put into every cell its bound, grown by @a margin, overlaps.
+    void build(const dynalight_registry_t reg[], size_t reg_count, float margin);
+
+    /// Get the dynalights which might light a point.
+    /// @param lst set to the registry indices of the lights, in registry order
+    /// @return the number of lights
+    size_t find(float x, float y, const uint16_t *& lst) const;
+
+private:
+    int toCell(float offset, int cellCount) const;
+
+    float _x0, _y0;                     ///< Lower corner of the grid
+    int _cellCountX, _cellCountY;       ///< Number of cells along the x- and y-axis
+    std::vector<uint32_t> _cellStarts;  ///< Start of the lights of each cell in _lights, plus the end
+    std::vector<uint16_t> _lights;      ///< Registry indices of the lights of all cells
+};
+
 /// The active dynamic lights
 struct dynalist_t
 {
 	int frame; ///< The last frame in shich the list was updated. @a -1 if there was no update yet.
 	size_t size; ///< The size of the list.
 	dynalight_data_t lst[TOTAL_MAX_DYNA];  ///< The list.
+	dynalight_grid_t grid; ///< The lights visible to the camera lit last, binned over the mesh. Kept to reuse its memory.
 	static void init(dynalist_t& self);
     dynalist_t()
-        : frame(-1), size(0), lst{}
+        : frame(-1), size(0), lst{}, grid()
     {}
 };
 
-/// Structure for keeping track of which dynalights are visible
-struct dynalight_registry_t {
-    int reference;
-    ego_frect_t bound;
-};
-
 /// Illuminate the "grid".
 struct GridIllumination {
 private:
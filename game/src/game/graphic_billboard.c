@@ -297,10 +297,15 @@ std::shared_ptr<Billboard> BillboardSystem::makeBillboard(ObjectRef obj_ref, con
     }
     auto obj_ptr = _currentModule->getObjectHandler()[obj_ref];
 
+    // Without a user interface (e.g. when running headless) there is no font to render the text with.
+    if (!_gameEngine->getUIManager()) {
+        return nullptr;
+    }
+
     // Pre-render the text.
     std::shared_ptr<Ego::Texture> tex;
     try {
-        tex = std::make_shared<Ego::OpenGL::Texture>();
+        tex = Ego::Renderer::get().createTexture();
     } catch (...) {
         return nullptr;
     }
@@ -94,7 +94,7 @@ bool animate_tile( ego_mesh_t& mesh, Uint32 itile )
     image    = frame_add + basetile;
 
     // actually update the animated texture info
-    return mesh.set_texture( itile, image );
+    return mesh.animate_texture( itile, image );
 }
 
 //--------------------------------------------------------------------------------------------
@@ -329,8 +329,8 @@ gfx_rv render_water_fan( ego_mesh_t& mesh, const Index1D& tileIndex, const Uint8
         float r, g, b, a;
         float s, t;
     };
-    auto vb = std::make_shared<Ego::VertexBuffer>(4, Ego::VertexFormatDescriptor::get<Ego::VertexFormat::P3FC4FT2F>());
-    Vertex *v = static_cast<Vertex *>(vb->lock());
+    auto vb = Ego::VertexArena::get().allocate(Ego::VertexFormatDescriptor::get<Ego::VertexFormat::P3FC4FT2F>(), 4);
+    Vertex *v = vb.get<Vertex>();
 
     // Original points
     badvertex = ptile._vrtstart;
@@ -395,8 +395,6 @@ gfx_rv render_water_fan( ego_mesh_t& mesh, const Index1D& tileIndex, const Uint8
         }
     }
 
-    vb->unlock();
-
     // tell the mesh texture code that someone else is controlling the texture
     TileRenderer::invalidate();
 
@@ -433,7 +431,7 @@ gfx_rv render_water_fan( ego_mesh_t& mesh, const Index1D& tileIndex, const Uint8
 
         // per-vertex coloring
         renderer.setGouraudShadingEnabled(true);
-        renderer.render(*vb, Ego::PrimitiveType::TriangleFan, 0, 4);
+        Ego::VertexArena::get().render(vb, Ego::PrimitiveType::TriangleFan);
     }
     ATTRIB_POP( __FUNCTION__ );
 
@@ -38,6 +38,12 @@
 #include "game/Entities/ObjectHandler.hpp"
 #include "game/Entities/ParticleHandler.hpp"
 
+// SSE2 is part of every x86-64 CPU, so it needs no extra compiler flags there.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define EGO_MD2_INTERPOLATE_SSE2 1
+    #include <emmintrin.h>
+#endif
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
@@ -960,11 +966,18 @@ void chr_instance_t::update_lighting_base(chr_instance_t& self, Object *pchr, bo
     /// @author BB
     /// @details determine the basic per-vertex lighting
 
+    if (chr_instance_t::begin_lighting_update(self, pchr, force)) {
+        chr_instance_t::update_lighting_vertices(self, pchr);
+    }
+}
+
+bool chr_instance_t::begin_lighting_update(chr_instance_t& self, Object *pchr, bool force)
+{
     const int frame_skip = 1 << 2;
     const int frame_mask = frame_skip - 1;
 
 	if (!pchr) {
-		return;
+		return false;
 	}
 
     // force this function to be evaluated the 1st time through
@@ -974,27 +987,27 @@ void chr_instance_t::update_lighting_base(chr_instance_t& self, Object *pchr, bo
 
     // has this already been calculated this update?
 	if (!force && self.lighting_update_wld >= 0 && (Uint32)self.lighting_update_wld >= update_wld) {
-		return;
+		return false;
 	}
-	self.lighting_update_wld = update_wld;
+    self.lighting_update_wld = update_wld;
 
     // make sure the matrix is valid
     chr_update_matrix(pchr, true);
 
     // has this already been calculated in the last frame_skip frames?
 	if (!force && self.lighting_frame_all >= 0 && (Uint32)self.lighting_frame_all >= game_frame_all) {
-		return;
+		return false;
 	}
 
     // reduce the amount of updates to one every frame_skip frames, but dither
     // the updating so that not all objects update on the same frame
     self.lighting_frame_all = game_frame_all + ((game_frame_all + pchr->getObjRef().get()) & frame_mask);
 
-	if (!self.imad) {
-		return;
-	}
-    self.vrt_count = self.vrt_count;
+    return nullptr != self.imad;
+}
 
+void chr_instance_t::update_lighting_vertices(chr_instance_t& self, const Object *pchr)
+{
     // interpolate the lighting for the origin of the object
 
 	auto mesh = _currentModule->getMeshPointer();
@@ -1128,80 +1141,109 @@ gfx_rv chr_instance_t::needs_update(chr_instance_t& self, int vmin, int vmax, bo
     return (!(*verts_match) || !( *frames_match )) ? gfx_success : gfx_fail;
 }
 
-void chr_instance_t::interpolate_vertices_raw( GLvertex dst_ary[], const std::vector<MD2_Vertex> &lst_ary, const std::vector<MD2_Vertex> &nxt_ary, int vmin, int vmax, float flip )
+#if defined(EGO_MD2_INTERPOLATE_SSE2)
+/// Load four packed 8-bit coordinates as floats.
+static inline __m128 load_packed_coordinates(const uint8_t *coordinates)
 {
-    /// raw indicates no bounds checking, so be careful
-
-    int i;
+    int32_t packed;
+    std::memcpy(&packed, coordinates, sizeof(packed));
+    const __m128i zero = _mm_setzero_si128();
+    __m128i unpacked = _mm_cvtsi32_si128(packed);
+    unpacked = _mm_unpacklo_epi8(unpacked, zero);
+    unpacked = _mm_unpacklo_epi16(unpacked, zero);
+    return _mm_cvtepi32_ps(unpacked);
+}
+#endif
 
-    GLvertex     * dst;
+void chr_instance_t::interpolate_vertices_raw(GLvertex dst_ary[], const MD2_Frame& lst_frame, const MD2_Frame& nxt_frame, bool equallyLit, int vmin, int vmax, float flip)
+{
+    /// raw indicates no bounds checking, so be careful
 
-    if ( 0.0f == flip )
+    // The interpolated position of a vertex is
+    //     (1 - flip) * (lst * lst_scale + lst_translate) + flip * (nxt * nxt_scale + nxt_translate)
+    //   = lst * a + nxt * b + c
+    // where a, b and c are the same for all vertices.
+    const float flip0 = 1.0f - flip;
+    const float a[3] = { lst_frame.scale[kX] * flip0, lst_frame.scale[kY] * flip0, lst_frame.scale[kZ] * flip0 };
+    const float b[3] = { nxt_frame.scale[kX] * flip, nxt_frame.scale[kY] * flip, nxt_frame.scale[kZ] * flip };
+    const float c[3] = { lst_frame.translate[kX] * flip0 + nxt_frame.translate[kX] * flip,
+                         lst_frame.translate[kY] * flip0 + nxt_frame.translate[kY] * flip,
+                         lst_frame.translate[kZ] * flip0 + nxt_frame.translate[kZ] * flip };
+
+    const uint8_t *lst_x = lst_frame.vertexX.data(), *lst_y = lst_frame.vertexY.data(), *lst_z = lst_frame.vertexZ.data();
+    const uint8_t *nxt_x = nxt_frame.vertexX.data(), *nxt_y = nxt_frame.vertexY.data(), *nxt_z = nxt_frame.vertexZ.data();
+
+    int i = vmin;
+
+#if defined(EGO_MD2_INTERPOLATE_SSE2)
+    // Four vertices at a time. The operations are the same as in the scalar loop,
+    // so the results do not depend on which loop processed a vertex.
     {
-        for ( i = vmin; i <= vmax; i++ )
+        const __m128 ax = _mm_set1_ps(a[0]), ay = _mm_set1_ps(a[1]), az = _mm_set1_ps(a[2]);
+        const __m128 bx = _mm_set1_ps(b[0]), by = _mm_set1_ps(b[1]), bz = _mm_set1_ps(b[2]);
+        const __m128 cx = _mm_set1_ps(c[0]), cy = _mm_set1_ps(c[1]), cz = _mm_set1_ps(c[2]);
+        for ( /* Intentionally empty. */ ; i + 3 <= vmax; i += 4)
         {
-            dst     = dst_ary + i;
-            const MD2_Vertex &srcLast = lst_ary[i];
-
-			dst->pos[XX] = srcLast.pos[kX];
-			dst->pos[YY] = srcLast.pos[kY];
-			dst->pos[ZZ] = srcLast.pos[kZ];
-            dst->pos[WW] = 1.0f;
-
-			dst->nrm[XX] = srcLast.nrm[kX];
-			dst->nrm[YY] = srcLast.nrm[kY];
-			dst->nrm[ZZ] = srcLast.nrm[kZ];
-
-            dst->env[XX] = indextoenvirox[srcLast.normal];
-            dst->env[YY] = 0.5f * ( 1.0f + dst->nrm[ZZ] );
+            __m128 x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(load_packed_coordinates(lst_x + i), ax), _mm_mul_ps(load_packed_coordinates(nxt_x + i), bx)), cx);
+            __m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(load_packed_coordinates(lst_y + i), ay), _mm_mul_ps(load_packed_coordinates(nxt_y + i), by)), cy);
+            __m128 z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(load_packed_coordinates(lst_z + i), az), _mm_mul_ps(load_packed_coordinates(nxt_z + i), bz)), cz);
+            __m128 w = _mm_set1_ps(1.0f);
+
+            // From one register per component to one register per vertex.
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            _mm_storeu_ps(dst_ary[i + 0].pos, x);
+            _mm_storeu_ps(dst_ary[i + 1].pos, y);
+            _mm_storeu_ps(dst_ary[i + 2].pos, z);
+            _mm_storeu_ps(dst_ary[i + 3].pos, w);
         }
     }
-    else if ( 1.0f == flip )
+#endif
+
+    for ( /* Intentionally empty. */ ; i <= vmax; i++ )
     {
-        for ( i = vmin; i <= vmax; i++ )
-        {
-            dst     = dst_ary + i;
-            const MD2_Vertex &srcNext = nxt_ary[i];
+        GLvertex *dst = dst_ary + i;
+        dst->pos[XX] = (lst_x[i] * a[0] + nxt_x[i] * b[0]) + c[0];
+        dst->pos[YY] = (lst_y[i] * a[1] + nxt_y[i] * b[1]) + c[1];
+        dst->pos[ZZ] = (lst_z[i] * a[2] + nxt_z[i] * b[2]) + c[2];
+        dst->pos[WW] = 1.0f;
+    }
 
-			dst->pos[XX] = srcNext.pos[kX];
-			dst->pos[YY] = srcNext.pos[kY];
-			dst->pos[ZZ] = srcNext.pos[kZ];
-            dst->pos[WW] = 1.0f;
+    // The normals are looked up in the id normals.
+    const MD2_Normal *normals = MD2Model::getMD2Normals();
+    const uint8_t *lst_normal = lst_frame.vertexNormal.data(), *nxt_normal = nxt_frame.vertexNormal.data();
+    for ( i = vmin; i <= vmax; i++ )
+    {
+        GLvertex *dst = dst_ary + i;
+        const MD2_Normal& srcLast = normals[lst_normal[i]];
+        const MD2_Normal& srcNext = normals[nxt_normal[i]];
 
-            dst->nrm[XX] = srcNext.nrm[kX];
-            dst->nrm[YY] = srcNext.nrm[kY];
-            dst->nrm[ZZ] = srcNext.nrm[kZ];
+        dst->nrm[XX] = srcLast[0] + ( srcNext[0] - srcLast[0] ) * flip;
+        dst->nrm[YY] = srcLast[1] + ( srcNext[1] - srcLast[1] ) * flip;
+        dst->nrm[ZZ] = srcLast[2] + ( srcNext[2] - srcLast[2] ) * flip;
 
-            dst->env[XX] = indextoenvirox[srcNext.normal];
-            dst->env[YY] = 0.5f * ( 1.0f + dst->nrm[ZZ] );
+        if ( equallyLit )
+        {
+            dst->env[XX] = indextoenvirox[EGO_NORMAL_COUNT - 1];
         }
-    }
-    else
-    {
-        Uint16 vrta_lst, vrta_nxt;
-
-        for ( i = vmin; i <= vmax; i++ )
+        else
         {
-            dst     = dst_ary + i;
-            const MD2_Vertex &srcLast = lst_ary[i];
-            const MD2_Vertex &srcNext = nxt_ary[i];
-
-            dst->pos[XX] = srcLast.pos[kX] + ( srcNext.pos[kX] - srcLast.pos[kX] ) * flip;
-            dst->pos[YY] = srcLast.pos[kY] + ( srcNext.pos[kY] - srcLast.pos[kY] ) * flip;
-            dst->pos[ZZ] = srcLast.pos[kZ] + ( srcNext.pos[kZ] - srcLast.pos[kZ] ) * flip;
-            dst->pos[WW] = 1.0f;
-
-            dst->nrm[XX] = srcLast.nrm[kX] + ( srcNext.nrm[kX] - srcLast.nrm[kX] ) * flip;
-            dst->nrm[YY] = srcLast.nrm[kY] + ( srcNext.nrm[kY] - srcLast.nrm[kY] ) * flip;
-            dst->nrm[ZZ] = srcLast.nrm[kZ] + ( srcNext.nrm[kZ] - srcLast.nrm[kZ] ) * flip;
-
-            vrta_lst = srcLast.normal;
-            vrta_nxt = srcNext.normal;
-
-            dst->env[XX] = indextoenvirox[vrta_lst] + ( indextoenvirox[vrta_nxt] - indextoenvirox[vrta_lst] ) * flip;
-            dst->env[YY] = 0.5f * ( 1.0f + dst->nrm[ZZ] );
+            dst->env[XX] = indextoenvirox[lst_normal[i]] + ( indextoenvirox[nxt_normal[i]] - indextoenvirox[lst_normal[i]] ) * flip;
         }
+        dst->env[YY] = 0.5f * ( 1.0f + dst->nrm[ZZ] );
+    }
+}
+
+bool chr_instance_t::is_consistent(const chr_instance_t& self)
+{
+    if (!self.imad) {
+        return false;
+    }
+    const std::shared_ptr<MD2Model> &pmd2 = self.imad->getMD2();
+    if (self.vrt_count != pmd2->getVertexCount()) {
+        return false;
     }
+    const size_t frameCount = pmd2->getFrames().size();
+    return self.frame_nxt < frameCount && self.frame_lst < frameCount;
 }
 
 gfx_rv chr_instance_t::update_vertices(chr_instance_t& self, int vmin, int vmax, bool force)
@@ -1317,13 +1359,13 @@ gfx_rv chr_instance_t::update_vertices(chr_instance_t& self, int vmin, int vmax,
     // interpolate the 1st dirty region
     if ( vdirty1_min >= 0 && vdirty1_max >= 0 )
     {
-		chr_instance_t::interpolate_vertices_raw(self.vrt_lst, lastFrame.vertexList, nextFrame.vertexList, vdirty1_min, vdirty1_max, loc_flip);
+		chr_instance_t::interpolate_vertices_raw(self.vrt_lst, lastFrame, nextFrame, pmd2->isEquallyLit(), vdirty1_min, vdirty1_max, loc_flip);
     }
 
     // interpolate the 2nd dirty region
     if ( vdirty2_min >= 0 && vdirty2_max >= 0 )
     {
-		chr_instance_t::interpolate_vertices_raw(self.vrt_lst, lastFrame.vertexList, nextFrame.vertexList, vdirty2_min, vdirty2_max, loc_flip);
+		chr_instance_t::interpolate_vertices_raw(self.vrt_lst, lastFrame, nextFrame, pmd2->isEquallyLit(), vdirty2_min, vdirty2_max, loc_flip);
     }
 
     // update the saved parameters
@@ -275,6 +275,31 @@ public:
 	static gfx_rv update_one_flip(chr_instance_t& self, float dflip);
 	static void update_lighting_base(chr_instance_t& self, Object *pchr, bool force);
 
+	/**
+	 * @brief
+	 *  The first part of update_lighting_base(): decide if the per-vertex lighting is due and update the matrix.
+	 * @return
+	 *  @a true if update_lighting_vertices() has to be called
+	 * @remark
+	 *  Updating the matrix may touch the holder and the held items, so this has to run on the main thread.
+	 */
+	static bool begin_lighting_update(chr_instance_t& self, Object *pchr, bool force);
+
+	/**
+	 * @brief
+	 *  The second part of update_lighting_base(): light the vertices from the mesh lighting at the object position.
+	 * @remark
+	 *  Only writes to this instance, so it can run on a worker thread.
+	 */
+	static void update_lighting_vertices(chr_instance_t& self, const Object *pchr);
+
+	/**
+	 * @return
+	 *  @a true if the model, the vertex list and the frames of this instance are consistent,
+	 *  i.e. update_vertices() does not fail
+	 */
+	static bool is_consistent(const chr_instance_t& self);
+
 	static gfx_rv spawn(chr_instance_t& self, const PRO_REF profile, const int skin);
 
 	static gfx_rv increment_frame(chr_instance_t& self, const ObjectRef imount, const int mount_action);
@@ -298,7 +323,15 @@ private:
 	static gfx_rv needs_update(chr_instance_t& self, int vmin, int vmax, bool *verts_match, bool *frames_match);
 	static gfx_rv set_frame(chr_instance_t& self, int frame);
 	static void clear_cache(chr_instance_t& self);
-	static void interpolate_vertices_raw(GLvertex dst_ary[], const std::vector<MD2_Vertex> &lst_ary, const std::vector<MD2_Vertex> &nxt_ary, int vmin, int vmax, float flip);
+	/**
+	 * @brief
+	 *  Interpolate the vertices <tt>[vmin, vmax]</tt> between two frames into a vertex array.
+	 * @param equallyLit
+	 *  if @a true, the "equal light" normal is used for environment mapping
+	 * @remark
+	 *  Raw indicates no bounds checking.
+	 */
+	static void interpolate_vertices_raw(GLvertex dst_ary[], const MD2_Frame& lst_frame, const MD2_Frame& nxt_frame, bool equallyLit, int vmin, int vmax, float flip);
 };
 
 
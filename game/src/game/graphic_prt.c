@@ -84,7 +84,7 @@ Uint32 instance_update = std::numeric_limits<Uint32>::max();
 
 //--------------------------------------------------------------------------------------------
 static gfx_rv prt_instance_update(Camera& camera, const ParticleRef particle, Uint8 trans, bool do_lighting);
-static void calc_billboard_verts(Ego::VertexBuffer& vb, prt_instance_t& pinst, float size, bool do_reflect);
+static void calc_billboard_verts(const Ego::VertexArena::Allocation& vertices, prt_instance_t& pinst, float size, bool do_reflect);
 static void draw_one_attachment_point(chr_instance_t& inst, int vrt_offset);
 static void prt_draw_attached_point(prt_bundle_t& bdl_prt);
 static void render_prt_bbox(prt_bundle_t& bdl_prt);
@@ -114,8 +114,8 @@ gfx_rv render_one_prt_solid(const ParticleRef iprt)
     if (SPRITE_SOLID != pprt->type) return gfx_fail;
 
     // billboard for the particle
-    auto vb = std::make_shared<Ego::VertexBuffer>(4, Ego::VertexFormatDescriptor::get<Ego::VertexFormat::P3FT2F>());
-    calc_billboard_verts(*vb, pinst, pinst.size, false);
+    auto vertices = Ego::VertexArena::get().allocate(Ego::VertexFormatDescriptor::get<Ego::VertexFormat::P3FT2F>(), 4);
+    calc_billboard_verts(vertices, pinst, pinst.size, false);
 
     ATTRIB_PUSH(__FUNCTION__, GL_ENABLE_BIT | GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT | GL_CURRENT_BIT);
     {
@@ -143,7 +143,7 @@ gfx_rv render_one_prt_solid(const ParticleRef iprt)
 
         renderer.setColour(Ego::Math::Colour4f(pinst.fintens, pinst.fintens, pinst.fintens, 1.0f));
 
-        renderer.render(*vb, Ego::PrimitiveType::TriangleFan, 0, 4);
+        Ego::VertexArena::get().render(vertices, Ego::PrimitiveType::TriangleFan);
     }
     ATTRIB_POP(__FUNCTION__);
 
@@ -243,13 +243,13 @@ gfx_rv render_one_prt_trans(const ParticleRef iprt)
 
         if (drawParticle)
         {
-            auto vb = std::make_shared<Ego::VertexBuffer>(4, Ego::VertexFormatDescriptor::get<Ego::VertexFormat::P3FT2F>());
-            calc_billboard_verts(*vb, inst, inst.size, false);
+            auto vertices = Ego::VertexArena::get().allocate(Ego::VertexFormatDescriptor::get<Ego::VertexFormat::P3FT2F>(), 4);
+            calc_billboard_verts(vertices, inst, inst.size, false);
 
             renderer.setColour(particleColour);
 
             // Go on and draw it
-            renderer.render(*vb, Ego::PrimitiveType::TriangleFan, 0, 4);
+            Ego::VertexArena::get().render(vertices, Ego::PrimitiveType::TriangleFan);
         }
     }
     ATTRIB_POP(__FUNCTION__);
@@ -351,12 +351,12 @@ gfx_rv render_one_prt_ref(const ParticleRef iprt)
             {
                 // Calculate the position of the four corners of the billboard
                 // used to display the particle.
-                auto vb = std::make_shared<Ego::VertexBuffer>(4, Ego::VertexFormatDescriptor::get<Ego::VertexFormat::P3FT2F>());
-                calc_billboard_verts(*vb, inst, inst.size, true);
+                auto vertices = Ego::VertexArena::get().allocate(Ego::VertexFormatDescriptor::get<Ego::VertexFormat::P3FT2F>(), 4);
+                calc_billboard_verts(vertices, inst, inst.size, true);
 
                 renderer.setColour(particle_colour); // GL_CURRENT_BIT
 
-                renderer.render(*vb, Ego::PrimitiveType::TriangleFan, 0, 4);
+                Ego::VertexArena::get().render(vertices, Ego::PrimitiveType::TriangleFan);
             }
         }
         ATTRIB_POP(__FUNCTION__);
@@ -366,11 +366,11 @@ gfx_rv render_one_prt_ref(const ParticleRef iprt)
     return gfx_success;
 }
 
-void calc_billboard_verts(Ego::VertexBuffer& vb, prt_instance_t& inst, float size, bool do_reflect)
+void calc_billboard_verts(const Ego::VertexArena::Allocation& vertices, prt_instance_t& inst, float size, bool do_reflect)
 {
     // Calculate the position and texture coordinates of the four corners of the billboard used to display the particle.
 
-    if (vb.getNumberOfVertices() < 4)
+    if (vertices.count < 4)
     {
         throw std::runtime_error("vertex buffer too small");
     }
@@ -410,7 +410,7 @@ void calc_billboard_verts(Ego::VertexBuffer& vb, prt_instance_t& inst, float siz
         prt_right = inst.right;
     }
 
-    Vertex *v = static_cast<Vertex *>(vb.lock());
+    Vertex *v = vertices.get<Vertex>();
 
     for (i = 0; i < 4; i++)
     {
@@ -446,8 +446,6 @@ void calc_billboard_verts(Ego::VertexBuffer& vb, prt_instance_t& inst, float siz
 
     v[3].s = CALCULATE_PRT_U1(index, inst.image_ref);
     v[3].t = CALCULATE_PRT_V0(index, inst.image_ref);
-
-    vb.unlock();
 }
 
 void render_all_prt_attachment()
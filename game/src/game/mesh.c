@@ -29,6 +29,8 @@
 #include "egolib/FileFormats/Globals.hpp"
 #include "game/game.h"
 #include "game/Module/Module.hpp"
+#include "egolib/frustum.h"
+#include "game/Graphics/MeshChunks.hpp"
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
@@ -44,7 +46,7 @@ const std::shared_ptr<ego_tile_info_t> ego_tile_info_t::NULL_TILE = nullptr;
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
-MeshStats g_meshStats;
+thread_local MeshStats g_meshStats;
 
 static void warnNumberOfVertices(const char *file, int line, size_t numberOfVertices)
 {
@@ -276,6 +278,263 @@ void ego_mesh_t::make_bbox()
         // Add the bounds of the tile to the bounds of the mesh.
         _tmem._bbox.join(poct.toAABB());
     }
+
+    // Group the tile bounds into blocks for culling.
+    _blocks.build(_tmem);
+
+    // The distances to the tiles with FX for the wall tests.
+    _wallDistances.build(_tmem);
+}
+
+//--------------------------------------------------------------------------------------------
+MeshBlocks::MeshBlocks() :
+    _levels()
+{
+    //ctor
+}
+
+void MeshBlocks::build(const tile_mem_t& tmem)
+{
+    const Ego::MeshInfo& info = tmem.getInfo();
+
+    // The blocks.
+    Level blocks;
+    blocks._countX = std::max<uint32_t>(1, (info.getTileCountX() + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    blocks._countY = std::max<uint32_t>(1, (info.getTileCountY() + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    blocks._bounds.assign(blocks._countX * blocks._countY, AABB3f());
+    blocks._empty.assign(blocks._countX * blocks._countY, 1);
+
+    for (uint32_t ty = 0; ty < info.getTileCountY(); ++ty)
+    {
+        for (uint32_t tx = 0; tx < info.getTileCountX(); ++tx)
+        {
+            const oct_bb_t& oct = tmem.get(Index2D(tx, ty))._oct;
+            if (oct._empty) continue;
+
+            const uint32_t block = (tx / BLOCK_SIZE) + (ty / BLOCK_SIZE) * blocks._countX;
+            if (blocks._empty[block])
+            {
+                blocks._bounds[block] = oct.toAABB();
+                blocks._empty[block] = 0;
+            }
+            else
+            {
+                blocks._bounds[block].join(oct.toAABB());
+            }
+        }
+    }
+
+    _levels.clear();
+    _levels.push_back(std::move(blocks));
+
+    // Merge 2 x 2 boxes of the previous level until a single box is left.
+    while (_levels.back()._countX > 1 || _levels.back()._countY > 1)
+    {
+        const Level& below = _levels.back();
+        Level level;
+        level._countX = (below._countX + 1) / 2;
+        level._countY = (below._countY + 1) / 2;
+        level._bounds.assign(level._countX * level._countY, AABB3f());
+        level._empty.assign(level._countX * level._countY, 1);
+
+        for (uint32_t y = 0; y < below._countY; ++y)
+        {
+            for (uint32_t x = 0; x < below._countX; ++x)
+            {
+                const uint32_t child = x + y * below._countX;
+                if (below._empty[child]) continue;
+
+                const uint32_t parent = (x / 2) + (y / 2) * level._countX;
+                if (level._empty[parent])
+                {
+                    level._bounds[parent] = below._bounds[child];
+                    level._empty[parent] = 0;
+                }
+                else
+                {
+                    level._bounds[parent].join(below._bounds[child]);
+                }
+            }
+        }
+        _levels.push_back(std::move(level));
+    }
+}
+
+uint32_t MeshBlocks::getBlockCountX() const
+{
+    return _levels.empty() ? 0 : _levels.front()._countX;
+}
+
+uint32_t MeshBlocks::getBlockCountY() const
+{
+    return _levels.empty() ? 0 : _levels.front()._countY;
+}
+
+const AABB3f& MeshBlocks::getBounds(uint32_t block) const
+{
+    return _levels.front()._bounds[block];
+}
+
+void MeshBlocks::findVisible(const Ego::Graphics::Frustum& frustum, std::vector<uint32_t>& blocks) const
+{
+    if (_levels.empty()) return;
+    findVisible(frustum, _levels.size() - 1, 0, 0, false, blocks);
+}
+
+void MeshBlocks::findVisible(const Ego::Graphics::Frustum& frustum, size_t level, uint32_t x, uint32_t y, bool inside, std::vector<uint32_t>& blocks) const
+{
+    const Level& current = _levels[level];
+    const uint32_t index = x + y * current._countX;
+    if (current._empty[index]) return;
+
+    // Once a box is completely inside the frustum, so are all boxes below it.
+    if (!inside)
+    {
+        switch (frustum.intersects(current._bounds[index], true))
+        {
+            case Ego::Math::Relation::outside: return;
+            case Ego::Math::Relation::inside: inside = true; break;
+            default: break;
+        }
+    }
+
+    if (0 == level)
+    {
+        blocks.push_back(index);
+        return;
+    }
+
+    const Level& below = _levels[level - 1];
+    for (uint32_t cy = 2 * y; cy < std::min(2 * y + 2, below._countY); ++cy)
+    {
+        for (uint32_t cx = 2 * x; cx < std::min(2 * x + 2, below._countX); ++cx)
+        {
+            findVisible(frustum, level - 1, cx, cy, inside, blocks);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------
+MeshWallDistances::MeshWallDistances() :
+    _countX(0), _countY(0), _distances()
+{
+    //ctor
+}
+
+void MeshWallDistances::build(const tile_mem_t& tmem)
+{
+    const Ego::MeshInfo& info = tmem.getInfo();
+    _countX = info.getTileCountX();
+    _countY = info.getTileCountY();
+    _distances.clear();
+    if (0 == _countX || 0 == _countY)
+    {
+        _countX = _countY = 0;
+        return;
+    }
+    compute(tmem, 0, 0, _countX - 1, _countY - 1, _distances);
+}
+
+void MeshWallDistances::update(const tile_mem_t& tmem, const Index1D& tile)
+{
+    if (_distances.empty()) return;
+
+    const int x = tile.getI() % _countX,
+              y = tile.getI() / _countX;
+
+    // A tile at distance MAX_DISTANCE or less from the changed tile has its nearest tile with some bit
+    // at most 2 * MAX_DISTANCE tiles away from the changed tile, so this window sees all the tiles that matter.
+    const int x0 = std::max(0, x - 2 * MAX_DISTANCE), x1 = std::min<int>(_countX - 1, x + 2 * MAX_DISTANCE),
+              y0 = std::max(0, y - 2 * MAX_DISTANCE), y1 = std::min<int>(_countY - 1, y + 2 * MAX_DISTANCE);
+    std::vector<std::array<uint8_t, BIT_COUNT>> window;
+    compute(tmem, x0, y0, x1, y1, window);
+
+    // Only the distances around the changed tile can have changed.
+    const int width = x1 - x0 + 1;
+    for (int wy = std::max(y0, y - MAX_DISTANCE), wy1 = std::min(y1, y + MAX_DISTANCE); wy <= wy1; ++wy)
+    {
+        for (int wx = std::max(x0, x - MAX_DISTANCE), wx1 = std::min(x1, x + MAX_DISTANCE); wx <= wx1; ++wx)
+        {
+            _distances[wx + wy * _countX] = window[(wx - x0) + (wy - y0) * width];
+        }
+    }
+}
+
+void MeshWallDistances::compute(const tile_mem_t& tmem, int x0, int y0, int x1, int y1, std::vector<std::array<uint8_t, BIT_COUNT>>& distances) const
+{
+    const int width = x1 - x0 + 1, height = y1 - y0 + 1;
+    distances.resize(width * height);
+
+    // Tiles with a bit have distance 0 for that bit, all other tiles start out at the cap.
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            const GRID_FX_BITS fx = tmem.get(Index1D((x + x0) + (y + y0) * _countX)).getFX();
+            std::array<uint8_t, BIT_COUNT>& d = distances[x + y * width];
+            for (size_t b = 0; b < BIT_COUNT; ++b)
+            {
+                d[b] = HAS_SOME_BITS(fx, 1 << b) ? 0 : MAX_DISTANCE;
+            }
+        }
+    }
+
+    // Propagate the distances with a forward and a backward pass over the 8 neighbours.
+    auto relax = [&distances, width, height](int x, int y, int nx, int ny)
+    {
+        if (nx < 0 || nx >= width || ny < 0 || ny >= height) return;
+        std::array<uint8_t, BIT_COUNT>& d = distances[x + y * width];
+        const std::array<uint8_t, BIT_COUNT>& n = distances[nx + ny * width];
+        for (size_t b = 0; b < BIT_COUNT; ++b)
+        {
+            d[b] = std::min<uint8_t>(d[b], n[b] + 1);
+        }
+    };
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            relax(x, y, x - 1, y);
+            relax(x, y, x - 1, y - 1);
+            relax(x, y, x, y - 1);
+            relax(x, y, x + 1, y - 1);
+        }
+    }
+    for (int y = height - 1; y >= 0; --y)
+    {
+        for (int x = width - 1; x >= 0; --x)
+        {
+            relax(x, y, x + 1, y);
+            relax(x, y, x + 1, y + 1);
+            relax(x, y, x, y + 1);
+            relax(x, y, x - 1, y + 1);
+        }
+    }
+}
+
+bool MeshWallDistances::isClear(const IndexRect& rect, const BIT_FIELD bits) const
+{
+    const int xmin = rect._min.getX(), xmax = rect._max.getX(),
+              ymin = rect._min.getY(), ymax = rect._max.getY();
+    if (xmin < 0 || ymin < 0 || xmax >= int(_countX) || ymax >= int(_countY) || xmin > xmax || ymin > ymax)
+    {
+        return false;
+    }
+
+    // The rectangle is contained in the square of half-extent k around its center tile.
+    const int cx = (xmin + xmax) / 2, cy = (ymin + ymax) / 2;
+    const int k = std::max(std::max(xmax - cx, cx - xmin), std::max(ymax - cy, cy - ymin));
+    if (k >= MAX_DISTANCE) return false;
+
+    const std::array<uint8_t, BIT_COUNT>& d = _distances[cx + cy * _countX];
+    for (size_t b = 0; b < BIT_COUNT; ++b)
+    {
+        if (HAS_SOME_BITS(bits, 1 << b) && d[b] <= k)
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 //--------------------------------------------------------------------------------------------
@@ -504,6 +763,11 @@ BIT_FIELD ego_mesh_t::test_wall(const BIT_FIELD bits, const mesh_wall_data_t& da
 		return pass;
 	}
 
+	// Far from any tile with these bits, nothing to test.
+	if (_wallDistances.isClear(data._i, bits)) {
+		return EMPTY_BIT_FIELD;
+	}
+
 	for (int iy = data._i._min.getY(); iy <= data._i._max.getY(); ++iy) {
 		for (int ix = data._i._min.getX(); ix <= data._i._max.getX(); ++ix) {
 			Index1D tileIndex(ix + iy * data._mesh->_tmem.getInfo().getTileCountX());
@@ -559,6 +823,9 @@ float ego_mesh_t::get_pressure(const Vector3f& pos, float radius, const BIT_FIEL
     int iy_min = std::floor( fy_min / Info<float>::Grid::Size());
     int iy_max = std::floor( fy_max / Info<float>::Grid::Size());
 
+    // far from any tile with these bits, there is no pressure
+    if ( _wallDistances.isClear(IndexRect(Index2D(ix_min, iy_min), Index2D(ix_max, iy_max)), bits) ) return 0;
+
     for ( int iy = iy_min; iy <= iy_max; iy++ )
     {
         bool tile_valid = true;
@@ -1038,6 +1305,11 @@ bool ego_mesh_t::clear_fx( const Index1D& i, const BIT_FIELD flags )
 
     if (_tmem.get(i).removeFX(flags)) {
         _fxlists.dirty = true;
+        _fxVersion++;
+        _wallDistances.update(_tmem, i);
+        if (_chunks && HAS_SOME_BITS(flags, MAPFX_REFLECTIVE)) {
+            _chunks->invalidate(*this, i);
+        }
         return true;
     } else {
         return false;
@@ -1059,6 +1331,11 @@ bool ego_mesh_t::add_fx(const Index1D& i, const BIT_FIELD flags)
     if ( retval )
     {
         _fxlists.dirty = true;
+        _fxVersion++;
+        _wallDistances.update(_tmem, i);
+        if (_chunks && HAS_SOME_BITS(flags, MAPFX_REFLECTIVE)) {
+            _chunks->invalidate(*this, i);
+        }
     }
 
     return retval;
@@ -1274,6 +1551,10 @@ BIT_FIELD ego_mesh_t::hit_wall(const Vector3f& pos, float radius, const BIT_FIEL
 
 	nrm = Vector2f::zero();
 
+	// Far from any tile with these bits, there is no impact.
+	if (_wallDistances.isClear(data._i, bits)) {
+		return EMPTY_BIT_FIELD;
+	}
 
 	// ego_mesh_test_wall() clamps pdata->ix_* and pdata->iy_* to valid values
 
@@ -1387,7 +1668,7 @@ BIT_FIELD ego_mesh_t::hit_wall(const Vector3f& pos, const float radius, const BI
 }
 
 ego_mesh_t::ego_mesh_t(const Ego::MeshInfo& mesh_info)
-	: _info(mesh_info), _tmem(mesh_info), _fxlists(mesh_info) {
+	: _info(mesh_info), _tmem(mesh_info), _blocks(), _wallDistances(), _chunks(), _fxlists(mesh_info), _fxVersion(0) {
 }
 
 ego_mesh_t::~ego_mesh_t() {
@@ -1425,11 +1706,28 @@ bool ego_mesh_t::set_texture(const Index1D& index1D, Uint16 image)
 
 	// Set the actual image.
 	_tmem.get(index1D)._img = tile_upper | tile_lower;
+	if (_chunks) {
+		_chunks->invalidate(*this, index1D);
+	}
 
 	// Update the pre-computed texture info.
 	return update_texture(index1D);
 }
 
+bool ego_mesh_t::animate_texture(const Index1D& index1D, Uint16 image)
+{
+	if (!grid_is_valid(index1D)) {
+		return false;
+	}
+
+	// All animated tiles sharing an image step to the same image, so the baked chunks
+	// of animated tiles only have to bind the new texture.
+	uint16_t tile_value = _tmem.get(index1D)._img;
+	_tmem.get(index1D)._img = (tile_value & TILE_UPPER_MASK) | (image & TILE_LOWER_MASK);
+
+	return true;
+}
+
 bool ego_mesh_t::update_texture(const Index1D& i)
 {
 	if (!grid_is_valid(i)) {
@@ -1469,6 +1767,10 @@ void ego_mesh_t::finalize()
 
 	// create some lists to make searching the mesh tiles easier
 	_fxlists.synch(_tmem, true);
+
+	// bake the tiles for rendering
+	_chunks = std::make_unique<Ego::Graphics::MeshChunks>();
+	_chunks->build(*this);
 }
 
 float ego_mesh_t::getElevation(const Vector2f& p, bool waterwalk) const
@@ -354,6 +354,134 @@ struct mpdfx_lists_t
 
 //--------------------------------------------------------------------------------------------
 
+namespace Ego { namespace Graphics { struct Frustum; class MeshChunks; } }
+
+/**
+ * @brief
+ *  The tiles of a mesh grouped into square blocks of BLOCK_SIZE x BLOCK_SIZE tiles for culling.
+ *
+ *  Every block has the bounding box of its tiles. Blocks are merged 2 x 2 level by level into
+ *  a pyramid of bounding boxes with a single box on top, so a frustum test against one box can
+ *  reject or accept a whole region of the mesh.
+ */
+class MeshBlocks
+{
+public:
+    /// The edge length of a block, in tiles.
+    static const uint32_t BLOCK_SIZE = 8;
+
+    MeshBlocks();
+
+    /**
+     * @brief
+     *  Rebuild the blocks from the bounding boxes of the tiles.
+     * @param tmem
+     *  the tile memory. The octagonal bounding boxes of its tiles must be up to date.
+     */
+    void build(const tile_mem_t& tmem);
+
+    /// @brief Get the number of blocks along the x-axis.
+    uint32_t getBlockCountX() const;
+    /// @brief Get the number of blocks along the y-axis.
+    uint32_t getBlockCountY() const;
+
+    /**
+     * @brief
+     *  Get the bounding box of a block.
+     * @param block
+     *  the index of the block, <tt>x + y * getBlockCountX()</tt>
+     */
+    const AABB3f& getBounds(uint32_t block) const;
+
+    /**
+     * @brief
+     *  Find the blocks which are at least partially inside a frustum.
+     * @param frustum
+     *  the frustum
+     * @param [out] blocks
+     *  receives the indices of the visible blocks. Blocks without tiles are never visible.
+     */
+    void findVisible(const Ego::Graphics::Frustum& frustum, std::vector<uint32_t>& blocks) const;
+
+private:
+    /// A level of the pyramid. Level 0 are the blocks, each next level merges 2 x 2 boxes of the previous.
+    struct Level
+    {
+        uint32_t _countX;               ///< Number of boxes along the x-axis
+        uint32_t _countY;               ///< Number of boxes along the y-axis
+        std::vector<AABB3f> _bounds;    ///< The boxes, row by row
+        std::vector<char> _empty;       ///< Is the box empty i.e. covers no tiles?
+    };
+    std::vector<Level> _levels;
+
+    void findVisible(const Ego::Graphics::Frustum& frustum, size_t level, uint32_t x, uint32_t y, bool inside, std::vector<uint32_t>& blocks) const;
+};
+
+//--------------------------------------------------------------------------------------------
+
+/**
+ * @brief
+ *  For every tile and every FX bit the distance, in tiles, to the nearest tile having that bit.
+ *
+ *  Distances are measured in the maximum norm i.e. a tile touches the 8 tiles around it at
+ *  distance 1, and are capped at MAX_DISTANCE. A square of tiles around a tile is free of some
+ *  FX bits if the distances of its center tile exceed the half-extent of the square. This lets
+ *  the wall tests reject the common case of an object far from any wall without looking at the
+ *  tiles one by one. A change of the FX of a tile only affects the distances around it, so the
+ *  field is updated in a window of 2 * MAX_DISTANCE tiles rather than rebuilt.
+ */
+class MeshWallDistances
+{
+public:
+    /// The largest distance stored. Larger distances are clamped to it.
+    static const uint8_t MAX_DISTANCE = 15;
+    /// The number of FX bits.
+    static const size_t BIT_COUNT = 8;
+
+    MeshWallDistances();
+
+    /**
+     * @brief
+     *  Rebuild the distances from the FX of all tiles.
+     * @param tmem
+     *  the tile memory
+     */
+    void build(const tile_mem_t& tmem);
+
+    /**
+     * @brief
+     *  Update the distances after the FX of a tile changed.
+     * @param tmem
+     *  the tile memory
+     * @param tile
+     *  the index of the tile
+     */
+    void update(const tile_mem_t& tmem, const Index1D& tile);
+
+    /**
+     * @brief
+     *  Get if a rectangle of tiles is known to be free of some FX bits.
+     * @param rect
+     *  the rectangle of tiles, inclusive
+     * @param bits
+     *  the FX bits
+     * @return
+     *  @a true if no tile in the rectangle has any of the FX bits, @a false if that is not known.
+     *  Rectangles not entirely inside the mesh are never known to be clear.
+     */
+    bool isClear(const IndexRect& rect, const BIT_FIELD bits) const;
+
+private:
+    uint32_t _countX;                                       ///< Number of tiles along the x-axis
+    uint32_t _countY;                                       ///< Number of tiles along the y-axis
+    std::vector<std::array<uint8_t, BIT_COUNT>> _distances; ///< The distances per FX bit, row by row
+
+    /// Recompute the distances of the tiles in [x0,x1] x [y0,y1] from the FX of these tiles only.
+    void compute(const tile_mem_t& tmem, int x0, int y0, int x1, int y1, std::vector<std::array<uint8_t, BIT_COUNT>>& distances) const;
+};
+
+//--------------------------------------------------------------------------------------------
+
 class ego_mesh_t;
 
 struct Rect2f {
@@ -394,7 +522,15 @@ public:
 
     Ego::MeshInfo _info;
     tile_mem_t _tmem;
+    MeshBlocks _blocks;
+    /// @brief The distances of the tiles to the nearest tiles with FX, for the wall tests.
+    MeshWallDistances _wallDistances;
+    /// @brief The tiles baked into vertex buffers for rendering.
+    std::unique_ptr<Ego::Graphics::MeshChunks> _chunks;
     mpdfx_lists_t _fxlists;
+    /// @brief A counter which is incremented whenever the FX of a tile change.
+    /// Lets caches derived from the tile FX (e.g. of the pathfinding) detect that they are stale.
+    uint32_t _fxVersion;
 
     Vector3f get_diff(const Vector3f& pos, float radius, float center_pressure, const BIT_FIELD bits);
     float get_pressure(const Vector3f& pos, float radius, const BIT_FIELD bits) const;
@@ -471,6 +607,8 @@ public:
 
 	void make_texture();
 	bool set_texture(const Index1D& i, Uint16 image);
+	/// Set the image of an animated tile. Unlike set_texture, the baked geometry of the tile is kept.
+	bool animate_texture(const Index1D& i, Uint16 image);
 	bool update_texture(const Index1D& i);
 
 	uint8_t get_fan_twist(const Index1D& i) const;
@@ -524,7 +662,8 @@ struct MeshStats {
 };
 
 // Those are statistics. Move into per-mesh statistics.
-extern MeshStats g_meshStats;
+// Thread-local so mesh queries can be issued from update jobs.
+extern thread_local MeshStats g_meshStats;
 
 //--------------------------------------------------------------------------------------------
 
@@ -31,6 +31,7 @@
 #include "game/char.h"
 #include "game/Module/Module.hpp"
 #include "game/Entities/_Include.hpp"
+#include "game/Core/ReplaySystem.hpp"
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
@@ -145,6 +146,9 @@ void net_unbuffer_player_latches()
         ppla->net_latch = tmp_latch;
     }
 
+    // record the network latches or replace them by the recorded ones
+    ReplaySystem::get().updateLatches();
+
     // set the player latch
     for (PLA_REF ipla = 0; ipla < MAX_PLAYER; ++ipla)
     {
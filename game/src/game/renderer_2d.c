@@ -373,20 +373,19 @@ void draw_quad_2d(const Ego::Texture *tex, const ego_frect_t scr_rect, const ego
 			renderer.setAlphaTestEnabled(false);
         }
 
-		Ego::VertexBuffer vb(4, Ego::VertexFormatDescriptor::get<Ego::VertexFormat::P2FT2F>());
+		auto vb = Ego::VertexArena::get().allocate(Ego::VertexFormatDescriptor::get<Ego::VertexFormat::P2FT2F>(), 4);
 		{
 			struct Vertex {
 				float x, y;
 				float s, t;
 			};
-			Ego::VertexBufferScopedLock vblck(vb);
-			Vertex *vertices = vblck.get<Vertex>();
+			Vertex *vertices = vb.get<Vertex>();
 			vertices[0].x = scr_rect.xmin; vertices[0].y = scr_rect.ymax; vertices[0].s = tx_rect.xmin; vertices[0].t = tx_rect.ymax;
 			vertices[1].x = scr_rect.xmax; vertices[1].y = scr_rect.ymax; vertices[1].s = tx_rect.xmax; vertices[1].t = tx_rect.ymax;
 			vertices[2].x = scr_rect.xmax; vertices[2].y = scr_rect.ymin; vertices[2].s = tx_rect.xmax; vertices[2].t = tx_rect.ymin;
 			vertices[3].x = scr_rect.xmin; vertices[3].y = scr_rect.ymin; vertices[3].s = tx_rect.xmin; vertices[3].t = tx_rect.ymin;
 		}
-		renderer.render(vb, Ego::PrimitiveType::Quadriliterals, 0, 4);
+		Ego::VertexArena::get().render(vb, Ego::PrimitiveType::Quadriliterals);
     }
     ATTRIB_POP( __FUNCTION__ );
 }
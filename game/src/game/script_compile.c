@@ -892,6 +892,95 @@ void parser_state_t::parse_jumps( script_info_t& script )
     }
 }
 
+//--------------------------------------------------------------------------------------------
+void parser_state_t::compile_script( script_info_t& script )
+{
+    /// @details This function decodes the instruction list into a compiled script.
+    ///    Function pointers are looked up once and jumps are resolved to compiled instruction indices.
+
+    const auto& functions = Ego::Script::Runtime::get()._functionValueCodeToFunctionPointer;
+    const auto& localFunctions = Ego::Script::Runtime::get()._localFunctionValueCodes;
+
+    CompiledScript& compiled = script._compiled;
+    compiled.clear();
+
+    uint32_t index_end = script._instructions.getLength();
+
+    // Map each index of the instruction list to its compiled instruction.
+    // Indices which do not start an instruction map to the end of the compiled script.
+    std::vector<uint32_t> targets(index_end + 1, std::numeric_limits<uint32_t>::max());
+    std::vector<uint32_t> jumps;
+
+    uint32_t index = 0;
+    while ( index < index_end )
+    {
+        auto value = script._instructions[index];
+        targets[index] = compiled._instructions.size();
+
+        CompiledInstruction instruction;
+        instruction._indent = value.getDataBits();
+        instruction._value = value & Instruction::VALUEBITS;
+        instruction._function = nullptr;
+        instruction._local = true;
+        instruction._jump = 0;
+        instruction._firstOperand = compiled._operands.size();
+        instruction._operandCount = 0;
+
+        if ( value.isInv() )
+        {
+            // A function and its jump
+            instruction._kind = CompiledInstruction::Kind::Invoke;
+            if ( instruction._value < Ego::ScriptFunctions::SCRIPT_FUNCTIONS_COUNT )
+            {
+                auto result = functions.find( instruction._value );
+                if ( functions.cend() != result ) instruction._function = result->second;
+            }
+            instruction._local = nullptr != instruction._function && localFunctions.count( instruction._value ) > 0;
+            index++;
+            jumps.push_back( index < index_end ? script._instructions[index]._value : index_end );
+            index++;
+        }
+        else
+        {
+            // An operation and its operands
+            instruction._kind = CompiledInstruction::Kind::Assign;
+            index++;
+            uint32_t operand_count = index < index_end ? script._instructions[index]._value : 0;
+            index++;
+            for ( uint32_t i = 0; i < operand_count && index < index_end; ++i, ++index )
+            {
+                auto operand = script._instructions[index];
+
+                CompiledOperand compiledOperand;
+                compiledOperand._operator = operand.getDataBits();
+                compiledOperand._constant = operand.isLdc();
+                compiledOperand._value = operand & Instruction::VALUEBITS;
+                compiled._operands.push_back( compiledOperand );
+                instruction._operandCount++;
+
+                // Random numbers must be drawn in a deterministic order
+                if ( !compiledOperand._constant && VARRAND == compiledOperand._value ) instruction._local = false;
+            }
+            jumps.push_back( 0 );
+        }
+
+        compiled._instructions.push_back( instruction );
+    }
+
+    // Resolve the successors and the jumps.
+    const uint32_t compiled_end = compiled._instructions.size();
+    for ( uint32_t i = 0; i < compiled_end; ++i )
+    {
+        CompiledInstruction& instruction = compiled._instructions[i];
+        instruction._next = i + 1;
+        if ( CompiledInstruction::Kind::Invoke == instruction._kind )
+        {
+            uint32_t target = std::min( jumps[i], index_end );
+            instruction._jump = std::min( targets[target], compiled_end );
+        }
+    }
+}
+
 //--------------------------------------------------------------------------------------------
 bool load_ai_codes_vfs()
 {
@@ -1658,6 +1747,9 @@ egolib_rv load_ai_script_vfs0(parser_state_t& ps, const std::string& loadname, O
 	// determine the correct jumps
 	parser_state_t::parse_jumps(script);
 
+	// decode the instructions once, so that running them is cheap
+	parser_state_t::compile_script(script);
+
 	return rv_success;
 }
 egolib_rv load_ai_script_vfs(parser_state_t& ps, const std::string& loadname, ObjectProfile *ppro, script_info_t& script)
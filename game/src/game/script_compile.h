@@ -233,6 +233,14 @@ private:
 	static Uint32 jump_goto(int index, int index_end, script_info_t& script);
 public:
 	static void parse_jumps(script_info_t& script);
+	/**
+	 * @brief
+	 *  Compile the instruction list of a script into its compiled form.
+	 * @remark
+	 *  The jumps must have been determined before and the script runtime must have been
+	 *  started by scripting_system_begin().
+	 */
+	static void compile_script(script_info_t& script);
 
 private:
 	size_t parse_token(Token& tok, ObjectProfile *ppro, script_info_t& script, size_t read);
@@ -981,7 +981,7 @@ Uint8 scr_Else( script_state_t& state, ai_state_t& self )
 
     SCRIPT_FUNCTION_BEGIN();
 
-    returncode = ( ppro->getAIScript().indent >= ppro->getAIScript().indent_last );
+    returncode = ( state.indent >= state.indent_last );
 
     SCRIPT_FUNCTION_END();
 }
@@ -4809,9 +4809,12 @@ Uint8 scr_ShowMap( script_state_t& state, ai_state_t& self )
     /// Fails if map already visible
 
     SCRIPT_FUNCTION_BEGIN();
-    if(_gameEngine->getActivePlayingState()->getMiniMap()->isVisible()) returncode = false;
+    std::shared_ptr<PlayingState> playingState = _gameEngine->getActivePlayingState();
+    if (!playingState) return false;
 
-    _gameEngine->getActivePlayingState()->getMiniMap()->setVisible(true);
+    if(playingState->getMiniMap()->isVisible()) returncode = false;
+
+    playingState->getMiniMap()->setVisible(true);
 
     SCRIPT_FUNCTION_END();
 }
@@ -4825,8 +4828,10 @@ Uint8 scr_ShowYouAreHere( script_state_t& state, ai_state_t& self )
     /// camera location
 
     SCRIPT_FUNCTION_BEGIN();
+    std::shared_ptr<PlayingState> playingState = _gameEngine->getActivePlayingState();
+    if (!playingState) return false;
 
-    _gameEngine->getActivePlayingState()->getMiniMap()->setShowPlayerPosition(true);
+    playingState->getMiniMap()->setShowPlayerPosition(true);
 
     SCRIPT_FUNCTION_END();
 }
@@ -4841,10 +4846,11 @@ Uint8 scr_ShowBlipXY( script_state_t& state, ai_state_t& self )
     SCRIPT_FUNCTION_BEGIN();
 
     // Add a blip
-    if ( state.argument >= 0 )
+    std::shared_ptr<PlayingState> playingState = _gameEngine->getActivePlayingState();
+    if ( state.argument >= 0 && playingState )
     {
         //_gameEngine->getActivePlayingState()->getMiniMap()->addBlip(state.x, state.y, static_cast<HUDColors>(state.argument % COLOR_MAX));
-        _gameEngine->getActivePlayingState()->getMiniMap()->addBlip(state.x, state.y, _currentModule->getObjectHandler()[pchr->getObjRef()]);
+        playingState->getMiniMap()->addBlip(state.x, state.y, _currentModule->getObjectHandler()[pchr->getObjRef()]);
     }
 
     SCRIPT_FUNCTION_END();
@@ -6423,8 +6429,10 @@ Uint8 scr_AddStat( script_state_t& state, ai_state_t& self )
     /// @details This function turns on an NPC's status display
 
     SCRIPT_FUNCTION_BEGIN();
+    std::shared_ptr<PlayingState> playingState = _gameEngine->getActivePlayingState();
+    if (!playingState) return false;
 
-    _gameEngine->getActivePlayingState()->addStatusMonitor( _currentModule->getObjectHandler()[self.getSelf()] );
+    playingState->addStatusMonitor( _currentModule->getObjectHandler()[self.getSelf()] );
 
     SCRIPT_FUNCTION_END();
 }